@@ -4,6 +4,7 @@
 
 #define TAM_NOME  50
 #define TAM_PISTA 100
+#define ALTURA_MAX_AVL 64   // uma AVL com altura 64 teria mais de 10^13 nós
 
 // -------------------------------------------------------
 // Struct da Sala (nó da árvore binária de cômodos)
@@ -11,46 +12,58 @@
 typedef struct Sala {
     char nome[TAM_NOME];          // Nome da sala
     char pista[TAM_PISTA];        // Pista associada (pode ser vazia)
-    struct Sala *esq;             // Caminho à esquerda
-    struct Sala *dir;             // Caminho à direita
+    const struct Sala *esq;       // Caminho à esquerda
+    const struct Sala *dir;       // Caminho à direita
 } Sala;
 
 // -------------------------------------------------------
 // Struct da BST de Pistas
-// Cada nó guarda uma string de pista
+// Cada nó guarda uma string de pista. A árvore é uma AVL:
+// 'altura' mantém as subárvores balanceadas mesmo quando as
+// pistas chegam em ordem (ex.: registros com data e hora).
 // -------------------------------------------------------
 typedef struct PistaNode {
     char pista[TAM_PISTA];
+    int altura;                   // altura da subárvore (folha = 1)
     struct PistaNode *esq;
     struct PistaNode *dir;
 } PistaNode;
 
+// Função chamada para cada pista num percurso
+typedef void (*VisitaPista)(PistaNode *no, void *contexto);
+
 // -------------------------------------------------------
-// Função: criarSala
-// Cria dinamicamente uma sala com nome e pista (opcional)
+// Mapa da mansão, em forma declarativa (mesma estrutura do
+// nível novato). Cada linha é uma sala: identificador,
+// nome, pista ("" = sem pista) e os caminhos à esquerda e à
+// direita (PARA(sala) ou NULL). O compilador monta o vetor
+// constante: nada é alocado nem copiado no início do jogo.
 // -------------------------------------------------------
-Sala* criarSala(const char *nome, const char *pista) {
-    Sala *nova = (Sala *)malloc(sizeof(Sala));
-    if (nova == NULL) {
-        printf("Erro ao alocar memoria para a sala '%s'.\n", nome);
-        exit(1);
-    }
-
-    strncpy(nova->nome, nome, TAM_NOME);
-    nova->nome[TAM_NOME - 1] = '\0';
-
-    if (pista != NULL) {
-        strncpy(nova->pista, pista, TAM_PISTA);
-        nova->pista[TAM_PISTA - 1] = '\0';
-    } else {
-        nova->pista[0] = '\0';   // pista vazia
-    }
-
-    nova->esq = NULL;
-    nova->dir = NULL;
-
-    return nova;
-}
+#define SALAS_MANSAO(SALA)                                                     \
+    SALA(HALL_ENTRADA, "Hall de Entrada", "Carta rasgada perto da porta",      \
+         PARA(SALA_ESTAR), PARA(COZINHA))                                      \
+    SALA(SALA_ESTAR,   "Sala de Estar",   "Pegadas no tapete",                 \
+         PARA(BIBLIOTECA), PARA(SALA_MUSICA))                                  \
+    SALA(COZINHA,      "Cozinha",         "Faca suja na pia",                  \
+         PARA(DESPENSA),   PARA(JARDIM))                                       \
+    SALA(BIBLIOTECA,   "Biblioteca",      "Livro fora do lugar",               \
+         NULL,             NULL)                                               \
+    SALA(SALA_MUSICA,  "Sala de Musica",  "Partitura com anotacoes estranhas", \
+         NULL,             NULL)                                               \
+    SALA(DESPENSA,     "Despensa",        "Prateleira deslocada",              \
+         NULL,             NULL)                                               \
+    SALA(JARDIM,       "Jardim",          "Terra remexida perto da fonte",     \
+         NULL,             NULL)
+
+#define ID_SALA(id, nome, pista, esq, dir) id,
+enum { SALAS_MANSAO(ID_SALA) NUM_SALAS };
+#undef ID_SALA
+
+#define PARA(id) (&mansao[id])
+#define DADOS_SALA(id, nome, pista, esq, dir) { nome, pista, esq, dir },
+static const Sala mansao[NUM_SALAS] = { SALAS_MANSAO(DADOS_SALA) };
+#undef DADOS_SALA
+#undef PARA
 
 // -------------------------------------------------------
 // Função: criarNoPista
@@ -65,58 +78,175 @@ PistaNode* criarNoPista(const char *pista) {
 
     strncpy(novo->pista, pista, TAM_PISTA);
     novo->pista[TAM_PISTA - 1] = '\0';
+    novo->altura = 1;
     novo->esq = NULL;
     novo->dir = NULL;
 
     return novo;
 }
 
+// -------------------------------------------------------
+// Funções auxiliares da AVL: altura e rotações
+// -------------------------------------------------------
+int alturaPista(PistaNode *no) {
+    return (no != NULL) ? no->altura : 0;
+}
+
+void atualizarAlturaPista(PistaNode *no) {
+    int ae = alturaPista(no->esq);
+    int ad = alturaPista(no->dir);
+    no->altura = 1 + (ae > ad ? ae : ad);
+}
+
+PistaNode* rotacionarDireita(PistaNode *no) {
+    PistaNode *filho = no->esq;
+    no->esq = filho->dir;
+    filho->dir = no;
+    atualizarAlturaPista(no);
+    atualizarAlturaPista(filho);
+    return filho;
+}
+
+PistaNode* rotacionarEsquerda(PistaNode *no) {
+    PistaNode *filho = no->dir;
+    no->dir = filho->esq;
+    filho->esq = no;
+    atualizarAlturaPista(no);
+    atualizarAlturaPista(filho);
+    return filho;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: balancearPista
+// Recalcula a altura do nó e aplica a rotação (simples ou
+// dupla) necessária; devolve a nova raiz da subárvore
+// -------------------------------------------------------
+PistaNode* balancearPista(PistaNode *no) {
+    atualizarAlturaPista(no);
+    int fator = alturaPista(no->esq) - alturaPista(no->dir);
+
+    if (fator > 1) {
+        if (alturaPista(no->esq->esq) < alturaPista(no->esq->dir)) {
+            no->esq = rotacionarEsquerda(no->esq);
+        }
+        return rotacionarDireita(no);
+    }
+    if (fator < -1) {
+        if (alturaPista(no->dir->dir) < alturaPista(no->dir->esq)) {
+            no->dir = rotacionarDireita(no->dir);
+        }
+        return rotacionarEsquerda(no);
+    }
+    return no;
+}
+
 // -------------------------------------------------------
 // Função: inserirPista
 // Insere uma nova pista na BST de forma ordenada (alfabética)
+// Desce iterativamente guardando o caminho (endereços dos
+// ponteiros percorridos) e depois sobe rebalanceando, sem
+// recursão. Pistas repetidas são ignoradas.
 // -------------------------------------------------------
 PistaNode* inserirPista(PistaNode *raiz, const char *pista) {
+    PistaNode **caminho[ALTURA_MAX_AVL];
+    int tamCaminho = 0;
+    PistaNode **link = &raiz;
+
     if (pista == NULL || pista[0] == '\0') {
-        // Pista vazia, nada a inserir
-        return raiz;
+        return raiz; // pista vazia, nada a inserir
     }
 
-    if (raiz == NULL) {
-        return criarNoPista(pista);
+    while (*link != NULL) {
+        int cmp = strcmp(pista, (*link)->pista);
+        if (cmp == 0) {
+            return raiz; // pista já existente: ignora duplicata
+        }
+        caminho[tamCaminho++] = link;
+        link = (cmp < 0) ? &(*link)->esq : &(*link)->dir;
+    }
+    *link = criarNoPista(pista);
+
+    // Sobe pelo caminho; quando a altura de uma subárvore não
+    // muda, os ancestrais também não mudam e podemos parar
+    while (tamCaminho > 0) {
+        link = caminho[--tamCaminho];
+        int alturaAntes = (*link)->altura;
+        *link = balancearPista(*link);
+        if ((*link)->altura == alturaAntes) {
+            break;
+        }
     }
 
-    int cmp = strcmp(pista, raiz->pista);
+    return raiz;
+}
 
-    if (cmp < 0) {
-        raiz->esq = inserirPista(raiz->esq, pista);
-    } else if (cmp > 0) {
-        raiz->dir = inserirPista(raiz->dir, pista);
-    } else {
-        // cmp == 0: pista igual já existe, não inserir duplicata
-        // (poderia contar repetições, se quisesse)
+// -------------------------------------------------------
+// Função: buscarPista
+// Busca iterativa de uma pista na BST (NULL se não existir)
+// -------------------------------------------------------
+PistaNode* buscarPista(PistaNode *raiz, const char *pista) {
+    while (raiz != NULL) {
+        int cmp = strcmp(pista, raiz->pista);
+        if (cmp == 0) {
+            return raiz;
+        }
+        raiz = (cmp < 0) ? raiz->esq : raiz->dir;
     }
+    return NULL;
+}
 
-    return raiz;
+// -------------------------------------------------------
+// Função: percorrerPistasEmOrdem
+// Percurso em ordem sem recursão nem pilha (Morris): antes de
+// descer à esquerda, o nó mais à direita da subárvore
+// esquerda ganha um "fio" de volta para o nó atual; o fio é
+// desfeito quando o percurso passa por ele de novo. A árvore
+// termina igual ao início, mas 'visitar' não pode alterá-la.
+// -------------------------------------------------------
+void percorrerPistasEmOrdem(PistaNode *raiz, VisitaPista visitar, void *contexto) {
+    PistaNode *atual = raiz;
+
+    while (atual != NULL) {
+        if (atual->esq == NULL) {
+            visitar(atual, contexto);
+            atual = atual->dir;
+            continue;
+        }
+
+        PistaNode *anterior = atual->esq;
+        while (anterior->dir != NULL && anterior->dir != atual) {
+            anterior = anterior->dir;
+        }
+        if (anterior->dir == NULL) {
+            anterior->dir = atual;   // fio para voltar depois da subárvore esquerda
+            atual = atual->esq;
+        } else {
+            anterior->dir = NULL;    // subárvore esquerda concluída: desfaz o fio
+            visitar(atual, contexto);
+            atual = atual->dir;
+        }
+    }
+}
+
+void imprimirPista(PistaNode *no, void *contexto) {
+    (void)contexto;
+    printf("- %s\n", no->pista);
 }
 
 // -------------------------------------------------------
 // Função: exibirPistas
-// Percorre a BST em ordem (in-order) e exibe as pistas
+// Exibe as pistas em ordem alfabética
 // -------------------------------------------------------
 void exibirPistas(PistaNode *raiz) {
-    if (raiz == NULL) return;
-
-    exibirPistas(raiz->esq);
-    printf("- %s\n", raiz->pista);
-    exibirPistas(raiz->dir);
+    percorrerPistasEmOrdem(raiz, imprimirPista, NULL);
 }
 
 // -------------------------------------------------------
 // Função: explorarSalasComPistas
 // Permite navegação pela mansão e coleta automática de pistas
 // -------------------------------------------------------
-void explorarSalasComPistas(Sala *raiz, PistaNode **raizPistas) {
-    Sala *atual = raiz;
+void explorarSalasComPistas(const Sala *raiz, PistaNode **raizPistas) {
+    const Sala *atual = raiz;
     char opcao;
 
     if (atual == NULL) {
@@ -163,63 +293,37 @@ void explorarSalasComPistas(Sala *raiz, PistaNode **raizPistas) {
     }
 }
 
-// -------------------------------------------------------
-// Função auxiliar: liberarArvoreSalas
-// Libera memória da árvore de cômodos
-// -------------------------------------------------------
-void liberarArvoreSalas(Sala *raiz) {
-    if (raiz == NULL) return;
-    liberarArvoreSalas(raiz->esq);
-    liberarArvoreSalas(raiz->dir);
-    free(raiz);
-}
-
 // -------------------------------------------------------
 // Função auxiliar: liberarArvorePistas
-// Libera memória da BST de pistas
+// Libera memória da BST de pistas sem recursão nem pilha:
+// enquanto a raiz tem filho à esquerda, gira à direita; sem
+// ele, libera a raiz e segue pela direita. Cada nó é girado
+// no máximo uma vez.
 // -------------------------------------------------------
 void liberarArvorePistas(PistaNode *raiz) {
-    if (raiz == NULL) return;
-    liberarArvorePistas(raiz->esq);
-    liberarArvorePistas(raiz->dir);
-    free(raiz);
+    while (raiz != NULL) {
+        if (raiz->esq != NULL) {
+            PistaNode *filho = raiz->esq;
+            raiz->esq = filho->dir;
+            filho->dir = raiz;
+            raiz = filho;
+        } else {
+            PistaNode *dir = raiz->dir;
+            free(raiz);
+            raiz = dir;
+        }
+    }
 }
 
 // -------------------------------------------------------
-// Função main - monta a mansão e inicia exploração com pistas
+// Função main - explora a mansão constante coletando pistas
 // -------------------------------------------------------
 int main() {
-    // Montagem manual da mansão (mesma estrutura do nível novato)
-    Sala *hallEntrada = criarSala("Hall de Entrada",
-                                  "Carta rasgada perto da porta");
-    Sala *salaEstar   = criarSala("Sala de Estar",
-                                  "Pegadas no tapete");
-    Sala *cozinha     = criarSala("Cozinha",
-                                  "Faca suja na pia");
-    Sala *biblioteca  = criarSala("Biblioteca",
-                                  "Livro fora do lugar");
-    Sala *salaMusica  = criarSala("Sala de Musica",
-                                  "Partitura com anotacoes estranhas");
-    Sala *despensa    = criarSala("Despensa",
-                                  "Prateleira deslocada");
-    Sala *jardim      = criarSala("Jardim",
-                                  "Terra remexida perto da fonte");
-
-    // Ligações da árvore
-    hallEntrada->esq = salaEstar;
-    hallEntrada->dir = cozinha;
-
-    salaEstar->esq  = biblioteca;
-    salaEstar->dir  = salaMusica;
-
-    cozinha->esq    = despensa;
-    cozinha->dir    = jardim;
-
     // Raiz da BST de pistas (inicialmente vazia)
     PistaNode *raizPistas = NULL;
 
     // Exploração com coleta de pistas
-    explorarSalasComPistas(hallEntrada, &raizPistas);
+    explorarSalasComPistas(&mansao[HALL_ENTRADA], &raizPistas);
 
     // Exibe pistas coletadas em ordem alfabética
     printf("\n===== Pistas coletadas (em ordem alfabetica) =====\n");
@@ -229,8 +333,7 @@ int main() {
         exibirPistas(raizPistas);
     }
 
-    // Libera memória
-    liberarArvoreSalas(hallEntrada);
+    // Libera memória (a mansão é constante: só as pistas)
     liberarArvorePistas(raizPistas);
 
     return 0;
@@ -0,0 +1,145 @@
+// -------------------------------------------------------
+// Benchmark da busca aproximada: consultas que são pistas
+// do caso com 2 erros de digitação sorteados (troca, falta
+// ou sobra de um caractere), respondidas por:
+//   dp       distância de Levenshtein clássica contra todas
+//            as pistas, a força bruta de referência
+//   myers    distanciaMyers contra todas as pistas
+//   indice   buscarPistasParecidas (trigramas + Myers nas
+//            CANDIDATOS_FUZZY melhores)
+// A coluna "acerto" é a fração de consultas em que o índice
+// achou uma pista à menor distância que a força bruta achou.
+// A força bruta roda em menos consultas nos casos grandes
+// (a clássica em 1/10 das de Myers, só para conferir).
+// -------------------------------------------------------
+#include "../src/benchmark.h"
+#include "../src/aproximada.h"
+
+#define CONSULTAS_BENCH 1000
+#define ERROS_BENCH     2
+
+const char *objetosBench[] = { "Bilhete", "Pegada", "Luva", "Chave", "Carta", "Faca", "Copo", "Lenco",
+                               "Recibo", "Anel", "Botao", "Mapa", "Foto", "Vela", "Corda", "Livro" };
+const char *estadosBench[] = { "rasgado", "molhado", "queimado", "escondido", "quebrado", "sujo",
+                               "dobrado", "marcado" };
+const char *lugaresBench[] = { "biblioteca", "cozinha", "escada", "jardim", "adega", "sotao",
+                               "capela", "estufa", "garagem", "lareira", "varanda", "despensa" };
+
+#define NUM_ELEMENTOS(v) (sizeof(v) / sizeof((v)[0]))
+
+// Levenshtein em duas linhas, sem diferenciar maiúsculas
+int distanciaClassica(const char *a, const char *b) {
+    int linha[2][TAM_PISTA + 1];
+    int m = (int)strlen(a), n = (int)strlen(b);
+
+    for (int j = 0; j <= n; j++) linha[0][j] = j;
+    for (int i = 1; i <= m; i++) {
+        int *atual = linha[i & 1], *anterior = linha[(i - 1) & 1];
+        atual[0] = i;
+        for (int j = 1; j <= n; j++) {
+            int custo = dobrarCaixa((unsigned char)a[i - 1]) != dobrarCaixa((unsigned char)b[j - 1]);
+            int d = anterior[j - 1] + custo;
+            if (anterior[j] + 1 < d) d = anterior[j] + 1;
+            if (atual[j - 1] + 1 < d) d = atual[j - 1] + 1;
+            atual[j] = d;
+        }
+    }
+    return linha[m & 1][n];
+}
+
+void errarTexto(char *texto, unsigned long long *semente) {
+    for (int e = 0; e < ERROS_BENCH; e++) {
+        size_t tamanho = strlen(texto);
+        size_t pos = (size_t)(proximoAleatorio(semente) % (tamanho + 1));
+        char letra = (char)('a' + proximoAleatorio(semente) % 26);
+        int tipo = (int)(proximoAleatorio(semente) % 3);
+
+        if (tipo == 0 && pos < tamanho) {
+            texto[pos] = letra;
+        } else if (tipo == 1 && pos < tamanho) {
+            memmove(texto + pos, texto + pos + 1, tamanho - pos);
+        } else if (tamanho + 1 < TAM_PISTA) {
+            memmove(texto + pos + 1, texto + pos, tamanho - pos + 1);
+            texto[pos] = letra;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 1000000u;
+    char texto[TAM_PISTA];
+
+    printf("%10s %10s %12s %12s %12s %8s\n", "pistas", "consultas", "dp(us)", "myers(us)", "indice(us)",
+           "acerto");
+    for (unsigned int n = 10000; n <= maximo && n != 0; n *= 10) {
+        HandleTexto *pistas = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+        char (*consultas)[TAM_PISTA] = (char (*)[TAM_PISTA])realocarOuSair(
+            NULL, (size_t)CONSULTAS_BENCH * TAM_PISTA);
+        unsigned int comMyers = (n >= 1000000) ? 50 : (n >= 100000) ? 200 : CONSULTAS_BENCH;
+        unsigned int comDp = comMyers / 10;
+        unsigned long long semente = 17;
+        IndiceTrigramas indice;
+
+        inicializarTrigramas(&indice);
+        for (unsigned int i = 0; i < n; i++) {
+            snprintf(texto, sizeof(texto), "%s %s na %s %u",
+                     objetosBench[proximoAleatorio(&semente) % NUM_ELEMENTOS(objetosBench)],
+                     estadosBench[proximoAleatorio(&semente) % NUM_ELEMENTOS(estadosBench)],
+                     lugaresBench[proximoAleatorio(&semente) % NUM_ELEMENTOS(lugaresBench)], i);
+            pistas[i] = internarTexto(texto, TAM_PISTA);
+            indexarTrigramas(&indice, pistas[i]);
+        }
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            strcpy(consultas[c], textoDe(pistas[proximoAleatorio(&semente) % n]));
+            errarTexto(consultas[c], &semente);
+        }
+
+        // Força bruta: menor distância de cada consulta por Myers,
+        // conferida com a distância clássica nas primeiras
+        int menores[CONSULTAS_BENCH];
+        double t0 = segundosAgora();
+        for (unsigned int c = 0; c < comMyers; c++) {
+            PadraoMyers padrao;
+            menores[c] = TAM_PISTA;
+            prepararPadraoMyers(&padrao, consultas[c], strlen(consultas[c]));
+            for (unsigned int i = 0; i < n; i++) {
+                const char *p = textoDe(pistas[i]);
+                int d = distanciaMyers(&padrao, p, strlen(p));
+                if (d < menores[c]) menores[c] = d;
+            }
+        }
+        double t1 = segundosAgora();
+        for (unsigned int c = 0; c < comDp; c++) {
+            int menor = TAM_PISTA;
+            for (unsigned int i = 0; i < n; i++) {
+                int d = distanciaClassica(consultas[c], textoDe(pistas[i]));
+                if (d < menor) menor = d;
+            }
+            if (menor != menores[c]) {
+                printf("Myers e a distancia classica discordam em \"%s\".\n", consultas[c]);
+                return 1;
+            }
+        }
+        double t2 = segundosAgora();
+        ResultadoAproximado achadas[CONSULTAS_BENCH];
+        unsigned int respondidas[CONSULTAS_BENCH];
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            respondidas[c] = buscarPistasParecidas(&indice, consultas[c], &achadas[c], 1);
+        }
+        double t3 = segundosAgora();
+
+        unsigned int acertos = 0;
+        for (unsigned int c = 0; c < comMyers; c++) {
+            if (respondidas[c] == 1 && achadas[c].distancia == menores[c]) acertos++;
+        }
+        printf("%10u %10u %12.1f %12.1f %12.2f %7.1f%%\n", n, comMyers, (t2 - t1) * 1e6 / comDp,
+               (t1 - t0) * 1e6 / comMyers, (t3 - t2) * 1e6 / CONSULTAS_BENCH, 100.0 * acertos / comMyers);
+        fflush(stdout);
+
+        liberarTrigramas(&indice);
+        free(pistas);
+        free(consultas);
+        liberarPoolTextos();
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#!/bin/sh
+# -------------------------------------------------------
+# Árvore de pistas do Aventureiro: a AVL iterativa atual
+# contra a BST sem balanceamento da versão original (a
+# revisão baseline no git). O mesmo programa de medida é
+# compilado com cada aventureiro.c e insere n pistas em
+# ordem crescente, decrescente e aleatória; depois busca
+# todas e mede a altura da árvore. A BST só roda até
+# MAX_BST pistas (em ordem ela vira uma lista).
+# Uso: bench/aventureiro.sh
+# -------------------------------------------------------
+cd "$(dirname "$0")/.." || exit 1
+MAX_BST=${MAX_BST:-20000}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+ORIGINAL=$(git log --format=%h --grep='^baseline$' | tail -n 1)
+if [ -z "$ORIGINAL" ] || ! git show "$ORIGINAL:aventureiro.c" > "$DIR/original.c" 2>/dev/null; then
+    echo "Revisao original do aventureiro.c nao encontrada no git."
+    exit 1
+fi
+cp aventureiro.c "$DIR/atual.c"
+
+cat > "$DIR/medida.c" <<'FIM'
+#include <time.h>
+#define main jogoAventureiro
+#include ARVORE
+#undef main
+
+// Medida: <n> <ordem: 0 crescente, 1 decrescente, 2 aleatoria>
+// Imprime "insercao(ms) busca(ns) altura"
+static double agora(void) {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int n = (argc > 2) ? (unsigned int)strtoul(argv[1], NULL, 10) : 0;
+    int ordem = (argc > 2) ? atoi(argv[2]) : 0;
+    char (*textos)[32] = malloc((size_t)n * 32 + 1);
+    PistaNode **pilha = malloc(((size_t)n + 1) * sizeof(PistaNode *));
+    int *alturas = malloc(((size_t)n + 1) * sizeof(int));
+    PistaNode *raiz = NULL;
+    unsigned int achadas = 0;
+    int altura = 0, topo = 0;
+
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int v = (ordem == 0) ? i : (ordem == 1) ? n - 1 - i
+                       : (unsigned int)(((unsigned long long)i * 2654435761u) % n);
+        snprintf(textos[i], 32, "Registro %08u", v);
+    }
+    double t0 = agora();
+    for (unsigned int i = 0; i < n; i++) raiz = inserirPista(raiz, textos[i]);
+    double t1 = agora();
+    for (unsigned int i = 0; i < n; i++) {
+        PistaNode *no = raiz;
+        while (no != NULL) {
+            int cmp = strcmp(textos[i], no->pista);
+            if (cmp == 0) { achadas++; break; }
+            no = (cmp < 0) ? no->esq : no->dir;
+        }
+    }
+    double t2 = agora();
+    if (raiz != NULL) { pilha[topo] = raiz; alturas[topo++] = 1; }
+    while (topo > 0) {
+        PistaNode *no = pilha[--topo];
+        int h = alturas[topo];
+        if (h > altura) altura = h;
+        if (no->esq) { pilha[topo] = no->esq; alturas[topo++] = h + 1; }
+        if (no->dir) { pilha[topo] = no->dir; alturas[topo++] = h + 1; }
+    }
+    if (achadas != n) return 1;
+    printf("%.1f %.1f %d\n", (t1 - t0) * 1e3, (t2 - t1) * 1e9 / n, altura);
+    return 0;
+}
+FIM
+for versao in original atual; do
+    ${CC:-cc} -std=c11 -O2 -DARVORE="\"$DIR/$versao.c\"" -o "$DIR/$versao" "$DIR/medida.c" || exit 1
+done
+
+echo "Aventureiro: BST original ($ORIGINAL) contra a AVL atual"
+printf "%-12s %9s %12s %12s %12s %12s %8s %8s\n" ordem pistas "BST:ins(ms)" "AVL:ins(ms)" \
+    "BST:busca" "AVL:busca" "BST:alt" "AVL:alt"
+for n in 10000 20000 100000 1000000; do
+    ordem=0
+    for nome in crescente decrescente aleatoria; do
+        if [ "$n" -le "$MAX_BST" ]; then
+            r=$("$DIR/original" $n $ordem) || exit 1
+            set -- $r
+        else
+            set -- - - -
+        fi
+        bst_ins=$1; bst_busca=$2; bst_alt=$3
+        r=$("$DIR/atual" $n $ordem) || exit 1
+        set -- $r
+        printf "%-12s %9s %12s %12s %12s %12s %8s %8s\n" $nome $n "$bst_ins" "$1" \
+            "$bst_busca" "$2" "$bst_alt" "$3"
+        ordem=$((ordem + 1))
+    done
+done
@@ -0,0 +1,70 @@
+// -------------------------------------------------------
+// Benchmark dos percursos em mansões degeneradas: cadeias
+// de n salas (forma "cadeia" do --benchmark, uma sala por
+// nível) até 10^7 níveis. Compara percorrerMansao, com a
+// pilha explícita, contra a mesma pré-ordem recursiva. A
+// recursiva só roda até MAX_RECURSAO salas: com a pilha
+// padrão de 8 MB, uma cadeia de 10^6 salas já a estoura.
+// Tempo por sala, melhor de 3.
+// -------------------------------------------------------
+#include "../src/benchmark.h"
+
+#define MAX_RECURSAO 100000
+
+void percorrerRecursivo(const Mansao *mansao, int sala, VisitaSala visitar, void *contexto) {
+    if (sala == SEM_SALA) return;
+    visitar(mansao, sala, contexto);
+    percorrerRecursivo(mansao, salaEsq(mansao, sala), visitar, contexto);
+    percorrerRecursivo(mansao, salaDir(mansao, sala), visitar, contexto);
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 10000000u;
+
+    printf("%10s %16s %16s\n", "salas", "iterativo(ns)", "recursivo(ns)");
+    for (unsigned int n = 10000; n <= maximo && n != 0; n *= 10) {
+        Arena arena;
+        Mansao mansao;
+        double iterativo = 0, recursivo = 0;
+        char textoRecursivo[16] = "-";
+
+        inicializarArena(&arena);
+        compactarMansao(gerarMansaoBenchmark(&arena, 1, 0, n, 20), &mansao);
+        int *pilha = (int *)realocarOuSair(NULL, (size_t)mansao.quantidade * sizeof(int));
+
+        for (int rodada = 0; rodada < 3; rodada++) {
+            unsigned long long somaIterativa = 0, somaRecursiva = 0;
+
+            double t0 = segundosAgora();
+            unsigned int visitadas = percorrerMansao(&mansao, pilha, somarNomeSala, &somaIterativa);
+            double t1 = segundosAgora();
+            if (visitadas != n) {
+                printf("O percurso visitou %u de %u salas.\n", visitadas, n);
+                return 1;
+            }
+            if (rodada == 0 || t1 - t0 < iterativo) iterativo = t1 - t0;
+
+            if (n <= MAX_RECURSAO) {
+                t0 = segundosAgora();
+                percorrerRecursivo(&mansao, 0, somarNomeSala, &somaRecursiva);
+                t1 = segundosAgora();
+                if (somaRecursiva != somaIterativa) {
+                    printf("Os percursos discordam com %u salas.\n", n);
+                    return 1;
+                }
+                if (rodada == 0 || t1 - t0 < recursivo) recursivo = t1 - t0;
+            }
+        }
+        if (n <= MAX_RECURSAO) {
+            snprintf(textoRecursivo, sizeof(textoRecursivo), "%.1f", recursivo * 1e9 / n);
+        }
+        printf("%10u %16.1f %16s\n", n, iterativo * 1e9 / n, textoRecursivo);
+        fflush(stdout);
+
+        free(pilha);
+        liberarMansao(&mansao);
+        liberarArena(&arena);
+        liberarPoolTextos();
+    }
+    return 0;
+}
@@ -0,0 +1,218 @@
+// -------------------------------------------------------
+// Benchmark do índice de caminhos em mansões de n salas
+// (10^6 por padrão) nas três formas do --benchmark. Mede a
+// construção do índice e compara cada consulta com o jeito
+// sem índice:
+//   sala      pista -> sala: salaComPista contra uma busca
+//             em largura a partir do Hall
+//   caminho   caminhoAteSala contra subir pelos pais (vetor
+//             de pais e profundidades já montado)
+//   comum     ancestralComum contra subir as duas salas
+//   subarvore naSubarvore contra subir até a profundidade
+//             da raiz (metade das raízes é ancestral da sala)
+// Tempo médio por consulta, em salas sorteadas; as respostas
+// das duas formas são comparadas.
+// -------------------------------------------------------
+#include "../src/benchmark.h"
+#include "../src/caminhos.h"
+
+#define CONSULTAS_BENCH 1000
+#define BUSCAS_BENCH    20
+
+// Estrutura do jeito sem índice: pai, lado e profundidade
+typedef struct Pais {
+    int *pai;
+    char *lado;
+    unsigned int *profundidade;
+    int *fila;
+} Pais;
+
+void montarPais(const Mansao *mansao, Pais *pais) {
+    unsigned int n = mansao->quantidade, fim = 0;
+
+    pais->pai = (int *)realocarOuSair(NULL, (size_t)n * sizeof(int));
+    pais->lado = (char *)realocarOuSair(NULL, n);
+    pais->profundidade = (unsigned int *)realocarOuSair(NULL, (size_t)n * sizeof(unsigned int));
+    pais->fila = (int *)realocarOuSair(NULL, (size_t)n * sizeof(int));
+    pais->pai[0] = SEM_SALA;
+    pais->profundidade[0] = 0;
+    pais->fila[fim++] = 0;
+    for (unsigned int k = 0; k < fim; k++) {
+        int sala = pais->fila[k];
+        int filhos[2] = { salaEsq(mansao, sala), salaDir(mansao, sala) };
+        for (int f = 0; f < 2; f++) {
+            if (filhos[f] == SEM_SALA) continue;
+            pais->pai[filhos[f]] = sala;
+            pais->lado[filhos[f]] = f ? 'd' : 'e';
+            pais->profundidade[filhos[f]] = pais->profundidade[sala] + 1;
+            pais->fila[fim++] = filhos[f];
+        }
+    }
+}
+
+void liberarPais(Pais *pais) {
+    free(pais->pai);
+    free(pais->lado);
+    free(pais->profundidade);
+    free(pais->fila);
+}
+
+// Primeira sala em largura com a pista
+int buscarSalaEmLargura(const Mansao *mansao, int *fila, HandleTexto pista) {
+    unsigned int fim = 0;
+
+    fila[fim++] = 0;
+    for (unsigned int k = 0; k < fim; k++) {
+        int sala = fila[k];
+        if (pistaSala(mansao, sala) == pista) return sala;
+        int esq = salaEsq(mansao, sala);
+        int dir = salaDir(mansao, sala);
+        if (esq != SEM_SALA) fila[fim++] = esq;
+        if (dir != SEM_SALA) fila[fim++] = dir;
+    }
+    return SEM_SALA;
+}
+
+int subirCaminho(const Pais *pais, int sala, char *saida) {
+    unsigned int profundidade = pais->profundidade[sala];
+
+    saida[profundidade] = '\0';
+    for (unsigned int p = profundidade; p > 0; p--) {
+        saida[p - 1] = pais->lado[sala];
+        sala = pais->pai[sala];
+    }
+    return (int)profundidade;
+}
+
+int subirAteComum(const Pais *pais, int a, int b) {
+    while (pais->profundidade[a] > pais->profundidade[b]) a = pais->pai[a];
+    while (pais->profundidade[b] > pais->profundidade[a]) b = pais->pai[b];
+    while (a != b) {
+        a = pais->pai[a];
+        b = pais->pai[b];
+    }
+    return a;
+}
+
+int subirAteRaiz(const Pais *pais, int raiz, int sala) {
+    while (pais->profundidade[sala] > pais->profundidade[raiz]) sala = pais->pai[sala];
+    return sala == raiz;
+}
+
+int main(int argc, char *argv[]) {
+    static const char *nomesFormas[] = { "equilibrada", "cadeia", "aleatoria" };
+    unsigned int n = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 1000000u;
+    int salas[CONSULTAS_BENCH], outras[CONSULTAS_BENCH], raizes[CONSULTAS_BENCH];
+
+    printf("%u salas\n", n);
+    printf("%-12s %-12s %16s %16s\n", "forma", "consulta", "sem indice(ns)", "indice(ns)");
+    for (int forma = 0; forma < 3; forma++) {
+        unsigned long long semente = 21 + (unsigned long long)forma;
+        Arena arena;
+        Mansao mansao;
+        IndiceCaminhos indice;
+        Pais pais;
+        double sem[4], com[4];
+        long long somaSem = 0, somaCom = 0;
+
+        inicializarArena(&arena);
+        compactarMansao(gerarMansaoBenchmark(&arena, forma, 0, n, semente), &mansao);
+        char *caminho = (char *)realocarOuSair(NULL, (size_t)n + 1);
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            salas[c] = (int)(proximoAleatorio(&semente) % n);
+            outras[c] = (int)(proximoAleatorio(&semente) % n);
+        }
+
+        double t0 = segundosAgora();
+        construirIndiceCaminhos(&indice, &mansao);
+        double construcao = segundosAgora() - t0;
+        montarPais(&mansao, &pais);
+
+        // Subárvore: metade das raízes é ancestral da sala (até
+        // 1000 níveis acima), a outra metade é sorteada
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            raizes[c] = outras[c];
+            if (c % 2 == 0) {
+                unsigned int subir = (unsigned int)(proximoAleatorio(&semente) % 1000);
+                for (raizes[c] = salas[c]; subir > 0 && raizes[c] != 0; subir--) {
+                    raizes[c] = pais.pai[raizes[c]];
+                }
+            }
+        }
+
+        // Pista -> sala (só salas com pista)
+        int buscas = 0;
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH && buscas < BUSCAS_BENCH; c++) {
+            HandleTexto pista = pistaSala(&mansao, salas[c]);
+            if (pista == TEXTO_VAZIO) continue;
+            somaSem += buscarSalaEmLargura(&mansao, pais.fila, pista);
+            buscas++;
+        }
+        sem[0] = (segundosAgora() - t0) / buscas;
+        // Com o índice, todas as consultas; só as primeiras contam
+        // na conferência
+        buscas = 0;
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            HandleTexto pista = pistaSala(&mansao, salas[c]);
+            if (pista == TEXTO_VAZIO) continue;
+            int sala = salaComPista(&indice, pista);
+            if (buscas++ < BUSCAS_BENCH) somaCom += sala;
+        }
+        com[0] = (segundosAgora() - t0) / buscas;
+
+        // Caminho do Hall até a sala
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            somaSem += subirCaminho(&pais, salas[c], caminho) + caminho[0];
+        }
+        sem[1] = (segundosAgora() - t0) / CONSULTAS_BENCH;
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            somaCom += caminhoAteSala(&indice, salas[c], caminho, (size_t)n + 1) + caminho[0];
+        }
+        com[1] = (segundosAgora() - t0) / CONSULTAS_BENCH;
+        char *outro = (char *)realocarOuSair(NULL, (size_t)n + 1);
+        for (int c = 0; c < BUSCAS_BENCH; c++) {
+            subirCaminho(&pais, salas[c], caminho);
+            caminhoAteSala(&indice, salas[c], outro, (size_t)n + 1);
+            if (strcmp(caminho, outro) != 0) somaCom++;
+        }
+        free(outro);
+
+        // Ancestral comum e subárvore
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) somaSem += subirAteComum(&pais, salas[c], outras[c]);
+        sem[2] = (segundosAgora() - t0) / CONSULTAS_BENCH;
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) somaCom += ancestralComum(&indice, salas[c], outras[c]);
+        com[2] = (segundosAgora() - t0) / CONSULTAS_BENCH;
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) somaSem += subirAteRaiz(&pais, raizes[c], salas[c]);
+        sem[3] = (segundosAgora() - t0) / CONSULTAS_BENCH;
+        t0 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) somaCom += naSubarvore(&indice, raizes[c], salas[c]);
+        com[3] = (segundosAgora() - t0) / CONSULTAS_BENCH;
+
+        if (somaSem != somaCom) {
+            printf("O indice e as consultas sem indice discordam na forma %s.\n", nomesFormas[forma]);
+            return 1;
+        }
+        static const char *nomesConsultas[] = { "sala", "caminho", "comum", "subarvore" };
+        printf("%-12s %-12s %16s %16.1f\n", nomesFormas[forma], "construir(ms)", "-", construcao * 1e3);
+        for (int q = 0; q < 4; q++) {
+            printf("%-12s %-12s %16.1f %16.1f\n", nomesFormas[forma], nomesConsultas[q], sem[q] * 1e9,
+                   com[q] * 1e9);
+        }
+        fflush(stdout);
+
+        free(caminho);
+        liberarPais(&pais);
+        liberarIndiceCaminhos(&indice);
+        liberarMansao(&mansao);
+        liberarArena(&arena);
+        liberarPoolTextos();
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#!/bin/sh
+# -------------------------------------------------------
+# Custo das estatísticas: o mestre é compilado a partir dos
+# mesmos fontes sem e com -DESTATISTICAS, e mais uma vez os
+# dois com funções e laços alinhados em 64 bytes ("al"):
+# qualquer mudança de código desloca o resto do binário, e
+# só esse deslocamento já muda alguns laços em até 10%.
+# "controle" é uma cópia do binário sem estatísticas. As
+# versões rodam em rodízio (as com estatísticas gravam o
+# JSON com --estatisticas) em:
+#   lote       SESSOES sessões com uma thread numa mansão
+#              equilibrada de 65535 salas
+#   benchmark  --benchmark até 10^4 salas
+# A tabela mostra o menor tempo de parede de cada versão
+# em RODADAS rodadas e, para as diferenças, a mediana das
+# diferenças dentro de cada rodada. A diferença do
+# controle para o "sem" é o ruído da medida nesta máquina;
+# a meta é um custo abaixo de 2%.
+# Uso: bench/estatisticas.sh   (SESSOES=1000000, RODADAS=12)
+# -------------------------------------------------------
+cd "$(dirname "$0")/.." || exit 1
+SESSOES=${SESSOES:-1000000}
+RODADAS=${RODADAS:-12}
+VERSOES="sem controle com sem_al com_al"
+ALINHAR="-falign-functions=64 -falign-loops=64"
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+for versao in sem com sem_al com_al; do
+    flags=""
+    case $versao in com*) flags="-DESTATISTICAS" ;; esac
+    case $versao in *_al) flags="$flags $ALINHAR" ;; esac
+    ${CC:-cc} -std=c11 -O2 $flags -o "$DIR/mestre_$versao" mestre.c src/*.c -pthread || exit 1
+done
+cp "$DIR/mestre_sem" "$DIR/mestre_controle"
+
+# Mesma mansão e roteiro de bench/threads.sh
+awk 'BEGIN {
+    n = 65535;
+    srand(11);
+    for (i = 0; i < n; i++) {
+        esq = (2 * i + 1 < n) ? 2 * i + 1 : "-";
+        dir = (2 * i + 2 < n) ? 2 * i + 2 : "-";
+        if (i % 10 == 0) print i "|Sala " i "|||" esq "|" dir;
+        else print i "|Sala " i "|Pista " i "|Suspeito " int(rand() * 64) "|" esq "|" dir;
+    }
+}' > "$DIR/mansao.txt"
+awk -v n="$SESSOES" 'BEGIN {
+    srand(12);
+    for (i = 0; i < n; i++) {
+        passos = 4 + int(rand() * 12);
+        linha = "";
+        for (p = 0; p < passos; p++) linha = linha substr("ed", int(rand() * 2) + 1, 1);
+        if (rand() < 0.9) linha = linha " s Suspeito " int(rand() * 64);
+        print linha;
+    }
+}' > "$DIR/roteiro.txt"
+"$DIR/mestre_sem" --converter "$DIR/mansao.txt" "$DIR/mansao.bin" > /dev/null || exit 1
+
+# Tempo de parede em ms de: <versao> <argumentos...>
+cronometrar() {
+    versao=$1
+    shift
+    extra=""
+    case $versao in com*) extra="--estatisticas $DIR/estatisticas.json" ;; esac
+    inicio=$(date +%s%N)
+    "$DIR/mestre_$versao" "$@" $extra > "$DIR/saida_$versao.txt" 2> /dev/null || return 1
+    fim=$(date +%s%N)
+    echo $(((fim - inicio) / 1000000))
+}
+
+# Uma linha "rodada versao ms" por execução. A ordem gira a
+# cada rodada, porque só a posição na sequência já muda o
+# tempo em mais de 2% nesta máquina
+medir() {
+    : > "$DIR/tempos.txt"
+    ordem=$VERSOES
+    rodada=0
+    while [ "$rodada" -lt "$RODADAS" ]; do
+        for versao in $ordem; do
+            t=$(cronometrar "$versao" "$@") || return 1
+            echo "$rodada $versao $t" >> "$DIR/tempos.txt"
+        done
+        primeira=${ordem%% *}
+        ordem="${ordem#* } $primeira"
+        rodada=$((rodada + 1))
+    done
+}
+
+# Menor tempo da versão
+menor() {
+    awk -v v="$1" '$2 == v && (m == "" || $3 < m) { m = $3 } END { print m }' "$DIR/tempos.txt"
+}
+
+# Mediana, entre as rodadas, da diferença de $2 para $1 na
+# mesma rodada: uma fase lenta da máquina pega as duas
+diferenca() {
+    awk -v a="$1" -v b="$2" '
+        $2 == a { ta[$1] = $3 }
+        $2 == b { tb[$1] = $3 }
+        END {
+            n = 0;
+            for (r in ta) d[n++] = (tb[r] - ta[r]) * 100 / ta[r];
+            for (i = 1; i < n; i++) {
+                x = d[i];
+                for (j = i - 1; j >= 0 && d[j] > x; j--) d[j + 1] = d[j];
+                d[j + 1] = x;
+            }
+            m = (n % 2) ? d[(n - 1) / 2] : (d[n / 2 - 1] + d[n / 2]) / 2;
+            printf "%+.1f%%", m;
+        }' "$DIR/tempos.txt"
+}
+
+echo "Estatisticas: $RODADAS rodadas (tempos: o menor; diferencas: a mediana por rodada), meta < 2%"
+printf "%-10s %8s %9s %8s %8s %8s %8s %8s %8s\n" carga "sem(ms)" "controle" "com" "sem_al" "com_al" \
+    ruido custo "custo_al"
+for carga in lote benchmark; do
+    if [ "$carga" = lote ]; then
+        medir --mansao "$DIR/mansao.bin" --lote "$DIR/roteiro.txt" --threads 1 || exit 1
+        if ! cmp -s "$DIR/saida_sem.txt" "$DIR/saida_com.txt"; then
+            echo "A saida do lote muda com as estatisticas."
+            exit 1
+        fi
+    else
+        medir --benchmark "$DIR/benchmark.json" 10000 || exit 1
+    fi
+    if [ ! -s "$DIR/estatisticas.json" ]; then
+        echo "A versao com estatisticas nao gravou o JSON."
+        exit 1
+    fi
+    rm -f "$DIR/estatisticas.json"
+    printf "%-10s %8s %9s %8s %8s %8s %8s %8s %8s\n" $carga "$(menor sem)" "$(menor controle)" \
+        "$(menor com)" "$(menor sem_al)" "$(menor com_al)" "$(diferenca sem controle)" \
+        "$(diferenca sem com)" "$(diferenca sem_al com_al)"
+done
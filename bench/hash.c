@@ -0,0 +1,80 @@
+// -------------------------------------------------------
+// Benchmark da hash pista -> suspeito: de 10^2 até 10^7
+// pistas (ou o máximo passado na linha de comando), mede a
+// inserção, a maior pausa de uma inserção isolada (o
+// crescimento é incremental, então não deve haver pausa
+// proporcional ao tamanho) e buscas presentes e ausentes.
+// A inserção vale o melhor de 3 rodadas.
+// Os textos são internados antes, fora das medidas; o
+// tempo de inserção inclui as duas leituras do relógio.
+// -------------------------------------------------------
+#include "../src/hash.h"
+
+#define SUSPEITOS_BENCH 97
+
+int main(int argc, char *argv[]) {
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 10000000u;
+    HandleTexto suspeitos[SUSPEITOS_BENCH];
+    char texto[TAM_PISTA];
+
+    for (int s = 0; s < SUSPEITOS_BENCH; s++) {
+        snprintf(texto, sizeof(texto), "Suspeito %d", s);
+        suspeitos[s] = internarTexto(texto, TAM_SUSPEITO);
+    }
+
+    printf("%10s %10s %14s %14s %14s %14s\n", "pistas", "capacidade", "insercao(ns)",
+           "maiorPausa(us)", "presente(ns)", "ausente(ns)");
+    for (unsigned int n = 100; n <= maximo && n != 0; n *= 10) {
+        HandleTexto *pistas = (HandleTexto *)realocarOuSair(NULL, 2 * (size_t)n * sizeof(HandleTexto));
+        TabelaHash tabela;
+        unsigned long long certos = 0;
+
+        // n pistas inseridas e n que nunca entram na tabela
+        for (unsigned int i = 0; i < 2 * n; i++) {
+            snprintf(texto, sizeof(texto), "%s numero %u de %u", (i < n) ? "Pista" : "Ausente", i, n);
+            pistas[i] = internarTexto(texto, TAM_PISTA);
+        }
+
+        // Inserção: melhor de 3 tabelas novas (a maior pausa de
+        // uma rodada pode ser só o sistema operacional)
+        double insercao = 0, maiorPausa = 0;
+        for (int rodada = 0; rodada < 3; rodada++) {
+            double pausaRodada = 0;
+            if (rodada > 0) liberarHash(&tabela);
+            inicializarHash(&tabela);
+            double t0 = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                double inicio = segundosAgora();
+                inserirNaHashPorHandle(&tabela, pistas[i], suspeitos[i % SUSPEITOS_BENCH]);
+                double pausa = segundosAgora() - inicio;
+                if (pausa > pausaRodada) pausaRodada = pausa;
+            }
+            double t = segundosAgora() - t0;
+            if (rodada == 0 || t < insercao) insercao = t;
+            if (rodada == 0 || pausaRodada < maiorPausa) maiorPausa = pausaRodada;
+        }
+
+        double t1 = segundosAgora();
+        for (unsigned int i = 0; i < n; i++) {
+            certos += encontrarSuspeitoPorHandle(&tabela, pistas[i]) == suspeitos[i % SUSPEITOS_BENCH];
+        }
+        double t2 = segundosAgora();
+        for (unsigned int i = n; i < 2 * n; i++) {
+            certos += encontrarSuspeitoPorHandle(&tabela, pistas[i]) != TEXTO_INEXISTENTE;
+        }
+        double t3 = segundosAgora();
+
+        if (certos != n) {
+            printf("Respostas erradas com %u pistas.\n", n);
+            return 1;
+        }
+        printf("%10u %10u %14.1f %14.1f %14.1f %14.1f\n", n, tabela.atual.capacidade,
+               insercao * 1e9 / n, maiorPausa * 1e6, (t2 - t1) * 1e9 / n, (t3 - t2) * 1e9 / n);
+        fflush(stdout);
+        liberarHash(&tabela);
+        free(pistas);
+    }
+
+    liberarPoolTextos();
+    return 0;
+}
@@ -0,0 +1,165 @@
+// -------------------------------------------------------
+// Benchmark do layout da hash: a tabela do jogo (bytes de
+// controle e pares hash/entrada "quentes", entradas
+// "frias") contra o HashEntry original, com as strings
+// dentro do slot, um campo 'ocupado' e strcmp em cada slot
+// ocupado da sondagem.
+// Para comparar só o layout, a original é refeita aqui com a
+// mesma função de hash, capacidade potência de dois e carga
+// máxima de 7/8. As duas recebem o texto da pista, como em
+// encontrarSuspeito (que sonda a tabela direto pelo texto);
+// a coluna "handle" mede a tabela atual com a pista já
+// internada (encontrarSuspeitoPorHandle), sem ler o texto.
+// -------------------------------------------------------
+#include "../src/hash.h"
+
+#define SUSPEITOS_BENCH 97
+#define TAM_TEXTO_BENCH 32
+
+// HashEntry da versão original
+typedef struct EntradaOriginal {
+    char pista[TAM_PISTA];
+    char suspeito[TAM_SUSPEITO];
+    int ocupado;
+} EntradaOriginal;
+
+typedef struct TabelaOriginal {
+    EntradaOriginal *slots;
+    unsigned int capacidade;
+} TabelaOriginal;
+
+void montarTabelaOriginal(TabelaOriginal *tabela, char (*pistas)[TAM_TEXTO_BENCH],
+                          char (*suspeitos)[TAM_TEXTO_BENCH], unsigned int n) {
+    tabela->capacidade = TAM_TABELA_HASH;
+    while ((unsigned long long)n * CARGA_MAX_DEN > (unsigned long long)tabela->capacidade * CARGA_MAX_NUM) {
+        tabela->capacidade *= 2;
+    }
+    tabela->slots = (EntradaOriginal *)calloc(tabela->capacidade, sizeof(EntradaOriginal));
+    if (tabela->slots == NULL) {
+        printf("Erro ao alocar memoria para o benchmark.\n");
+        exit(1);
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int pos = hashFunc(pistas[i]) & (tabela->capacidade - 1);
+        while (tabela->slots[pos].ocupado) {
+            pos = (pos + 1) & (tabela->capacidade - 1);
+        }
+        strcpy(tabela->slots[pos].pista, pistas[i]);
+        strcpy(tabela->slots[pos].suspeito, suspeitos[i % SUSPEITOS_BENCH]);
+        tabela->slots[pos].ocupado = 1;
+    }
+}
+
+const char* encontrarNaOriginal(const TabelaOriginal *tabela, const char *pista) {
+    unsigned int pos = hashFunc(pista) & (tabela->capacidade - 1);
+    while (tabela->slots[pos].ocupado) {
+        if (strcmp(tabela->slots[pos].pista, pista) == 0) {
+            return tabela->slots[pos].suspeito;
+        }
+        pos = (pos + 1) & (tabela->capacidade - 1);
+    }
+    return NULL;
+}
+
+// Melhor de 3 varreduras de buscas; devolve ns por busca
+double medirOriginal(const TabelaOriginal *tabela, char (*textos)[TAM_TEXTO_BENCH],
+                     unsigned int n, unsigned long long *achadas) {
+    double melhor = 0;
+    for (int rodada = 0; rodada < 3; rodada++) {
+        double t0 = segundosAgora();
+        for (unsigned int i = 0; i < n; i++) {
+            *achadas += encontrarNaOriginal(tabela, textos[i]) != NULL;
+        }
+        double t = segundosAgora() - t0;
+        if (rodada == 0 || t < melhor) melhor = t;
+    }
+    return melhor * 1e9 / n;
+}
+
+double medirAtual(TabelaHash *tabela, char (*textos)[TAM_TEXTO_BENCH],
+                  unsigned int n, unsigned long long *achadas) {
+    double melhor = 0;
+    for (int rodada = 0; rodada < 3; rodada++) {
+        double t0 = segundosAgora();
+        for (unsigned int i = 0; i < n; i++) {
+            *achadas += encontrarSuspeito(tabela, textos[i]) != NULL;
+        }
+        double t = segundosAgora() - t0;
+        if (rodada == 0 || t < melhor) melhor = t;
+    }
+    return melhor * 1e9 / n;
+}
+
+double medirPorHandle(TabelaHash *tabela, const HandleTexto *handles,
+                      unsigned int n, unsigned long long *achadas) {
+    double melhor = 0;
+    for (int rodada = 0; rodada < 3; rodada++) {
+        double t0 = segundosAgora();
+        for (unsigned int i = 0; i < n; i++) {
+            *achadas += encontrarSuspeitoPorHandle(tabela, handles[i]) != TEXTO_INEXISTENTE;
+        }
+        double t = segundosAgora() - t0;
+        if (rodada == 0 || t < melhor) melhor = t;
+    }
+    return melhor * 1e9 / n;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 1000000u;
+    char (*suspeitos)[TAM_TEXTO_BENCH] = (char (*)[TAM_TEXTO_BENCH])realocarOuSair(
+        NULL, SUSPEITOS_BENCH * TAM_TEXTO_BENCH);
+
+    for (int s = 0; s < SUSPEITOS_BENCH; s++) {
+        snprintf(suspeitos[s], TAM_TEXTO_BENCH, "Suspeito %d", s);
+    }
+
+    printf("%10s %15s %15s %15s %15s %15s %15s\n", "pistas", "original:pres", "atual:pres",
+           "handle:pres", "original:aus", "atual:aus", "handle:aus");
+    for (unsigned int n = 1000; n <= maximo && n != 0; n *= 10) {
+        // n pistas inseridas e n que nunca entram na tabela
+        char (*textos)[TAM_TEXTO_BENCH] = (char (*)[TAM_TEXTO_BENCH])realocarOuSair(
+            NULL, 2 * (size_t)n * TAM_TEXTO_BENCH);
+        for (unsigned int i = 0; i < 2 * n; i++) {
+            snprintf(textos[i], TAM_TEXTO_BENCH, "%s numero %u", (i < n) ? "Pista" : "Ausente", i);
+        }
+
+        TabelaOriginal original;
+        TabelaHash atual;
+        montarTabelaOriginal(&original, textos, suspeitos, n);
+        inicializarHash(&atual);
+        for (unsigned int i = 0; i < n; i++) {
+            inserirNaHash(&atual, textos[i], suspeitos[i % SUSPEITOS_BENCH]);
+        }
+
+        unsigned long long achadasOriginal = 0, achadasAtual = 0, achadasHandle = 0;
+        double presOriginal = medirOriginal(&original, textos, n, &achadasOriginal);
+        double presAtual = medirAtual(&atual, textos, n, &achadasAtual);
+        double ausOriginal = medirOriginal(&original, textos + n, n, &achadasOriginal);
+        double ausAtual = medirAtual(&atual, textos + n, n, &achadasAtual);
+
+        // Só agora as ausentes são internadas, para terem handle
+        // (na coluna "atual" elas nem estão no pool)
+        HandleTexto *handles = (HandleTexto *)realocarOuSair(NULL, 2 * (size_t)n * sizeof(HandleTexto));
+        for (unsigned int i = 0; i < 2 * n; i++) {
+            handles[i] = (i < n) ? buscarTexto(textos[i]) : internarTexto(textos[i], TAM_PISTA);
+        }
+        double presHandle = medirPorHandle(&atual, handles, n, &achadasHandle);
+        double ausHandle = medirPorHandle(&atual, handles + n, n, &achadasHandle);
+        if (achadasOriginal != 3ull * n || achadasAtual != 3ull * n || achadasHandle != 3ull * n) {
+            printf("Respostas erradas com %u pistas.\n", n);
+            return 1;
+        }
+        printf("%10u %12.1f ns %12.1f ns %12.1f ns %12.1f ns %12.1f ns %12.1f ns\n", n, presOriginal,
+               presAtual, presHandle, ausOriginal, ausAtual, ausHandle);
+        fflush(stdout);
+
+        free(original.slots);
+        liberarHash(&atual);
+        liberarPoolTextos();
+        free(handles);
+        free(textos);
+    }
+
+    free(suspeitos);
+    return 0;
+}
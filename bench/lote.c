@@ -0,0 +1,101 @@
+// -------------------------------------------------------
+// Benchmark da carga em lote: n pistas em ordem aleatória
+// entrando na árvore de pistas e na hash pista -> suspeito,
+// uma a uma (inserirPista / inserirNaHashPorHandle, como a
+// coleta fazia) contra inserirPistasEmLote e
+// inserirNaHashEmLote. Os textos são internados fora da
+// medida. Cada tempo é o melhor de 3; depois a árvore e a
+// hash das duas cargas são comparadas.
+// -------------------------------------------------------
+#include "../src/benchmark.h"
+
+#define SUSPEITOS_BENCH 1000
+
+// Mesmas pistas, na mesma ordem, nas folhas das duas árvores
+int mesmasPistas(const ArvorePistas *a, const ArvorePistas *b) {
+    const NoBMais *fa = a->primeiraFolha, *fb = b->primeiraFolha;
+    int ia = 0, ib = 0;
+
+    if (a->quantidade != b->quantidade) return 0;
+    for (;;) {
+        while (fa != NULL && ia == fa->quantidade) { fa = fa->proximo; ia = 0; }
+        while (fb != NULL && ib == fb->quantidade) { fb = fb->proximo; ib = 0; }
+        if (fa == NULL || fb == NULL) return fa == fb;
+        if (fa->pistas[ia++] != fb->pistas[ib++]) return 0;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 1000000u;
+    HandleTexto suspeitos[SUSPEITOS_BENCH];
+    char texto[TAM_PISTA];
+
+    printf("%10s %16s %16s %8s %16s %16s %8s\n", "pistas", "arvore:um(ms)", "arvore:lote(ms)", "razao",
+           "hash:um(ms)", "hash:lote(ms)", "razao");
+    for (unsigned int n = 10000; n <= maximo && n != 0; n *= 10) {
+        HandleTexto *pistas = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+        HandleTexto *donos = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+        unsigned long long semente = 14;
+        double tempos[4] = { 0, 0, 0, 0 };
+
+        for (int s = 0; s < SUSPEITOS_BENCH; s++) {
+            snprintf(texto, sizeof(texto), "Suspeito %d", s);
+            suspeitos[s] = internarTexto(texto, TAM_SUSPEITO);
+        }
+        for (unsigned int i = 0; i < n; i++) {
+            snprintf(texto, sizeof(texto), "Pista %016llx", proximoAleatorio(&semente));
+            pistas[i] = internarTexto(texto, TAM_PISTA);
+            donos[i] = suspeitos[i % SUSPEITOS_BENCH];
+        }
+
+        for (int rodada = 0; rodada < 3; rodada++) {
+            Arena arenaUm, arenaLote;
+            ArvorePistas arvoreUm, arvoreLote;
+            TabelaHash hashUm, hashLote;
+
+            inicializarArena(&arenaUm);
+            inicializarArena(&arenaLote);
+            inicializarPistas(&arvoreUm, &arenaUm);
+            inicializarPistas(&arvoreLote, &arenaLote);
+            inicializarHash(&hashUm);
+            inicializarHash(&hashLote);
+
+            double t0 = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) inserirPista(&arvoreUm, pistas[i]);
+            double t1 = segundosAgora();
+            inserirPistasEmLote(&arvoreLote, pistas, n);
+            double t2 = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) inserirNaHashPorHandle(&hashUm, pistas[i], donos[i]);
+            double t3 = segundosAgora();
+            inserirNaHashEmLote(&hashLote, pistas, donos, n);
+            double t4 = segundosAgora();
+
+            int certo = mesmasPistas(&arvoreUm, &arvoreLote);
+            for (unsigned int i = 0; certo && i < n; i++) {
+                certo = encontrarSuspeitoPorHandle(&hashLote, pistas[i]) == donos[i]
+                     && encontrarSuspeitoPorHandle(&hashUm, pistas[i]) == donos[i];
+            }
+            if (!certo) {
+                printf("A carga em lote e a carga uma a uma discordam com %u pistas.\n", n);
+                return 1;
+            }
+
+            double medidas[4] = { t1 - t0, t2 - t1, t3 - t2, t4 - t3 };
+            for (int m = 0; m < 4; m++) {
+                if (rodada == 0 || medidas[m] < tempos[m]) tempos[m] = medidas[m];
+            }
+            liberarHash(&hashUm);
+            liberarHash(&hashLote);
+            liberarArena(&arenaUm);
+            liberarArena(&arenaLote);
+        }
+        printf("%10u %16.2f %16.2f %7.2fx %16.2f %16.2f %7.2fx\n", n, tempos[0] * 1e3, tempos[1] * 1e3,
+               tempos[0] / tempos[1], tempos[2] * 1e3, tempos[3] * 1e3, tempos[2] / tempos[3]);
+        fflush(stdout);
+
+        free(pistas);
+        free(donos);
+        liberarPoolTextos();
+    }
+    return 0;
+}
@@ -0,0 +1,231 @@
+// -------------------------------------------------------
+// Benchmark das formas da mansão em mansões equilibradas de
+// 2^k - 1 salas geradas como no modo --benchmark:
+//   arena      árvore de ponteiros de criarSala (a arena
+//              entrega as salas em ordem de largura)
+//   espalhada  a mesma árvore com as salas em posições
+//              sorteadas, como ficariam com um malloc por sala
+//   explicita  forma compacta, filhos por índice
+//   implicita  Eytzinger, filhos em 2i+1 e 2i+2
+// Mede um percurso completo em pré-ordem (melhor de 5) e
+// 10^6 descidas aleatórias da raiz até uma folha. Os laços
+// leem os campos direto, para comparar só o layout; a
+// última coluna é o percurso do jogo (percorrerMansao, com
+// uma chamada de visita por sala).
+// -------------------------------------------------------
+#include "../src/benchmark.h"
+
+#define DESCIDAS_BENCH 1000000
+#define NUM_FORMAS     4
+
+const char *nomesFormasMansao[NUM_FORMAS] = { "arena", "espalhada", "explicita", "implicita" };
+
+// Cópia da árvore com as salas numa permutação aleatória
+Sala* espalharSalas(const Sala *raiz, unsigned int n, Sala *destino, unsigned long long semente) {
+    unsigned int *posicao = (unsigned int *)realocarOuSair(NULL, (size_t)n * sizeof(unsigned int));
+    const Sala **fila = (const Sala **)realocarOuSair(NULL, (size_t)n * sizeof(Sala *));
+    unsigned int inicio = 0, fim = 0;
+
+    for (unsigned int i = 0; i < n; i++) posicao[i] = i;
+    for (unsigned int i = n - 1; i > 0; i--) {
+        unsigned int j = (unsigned int)(proximoAleatorio(&semente) % (i + 1));
+        unsigned int t = posicao[i];
+        posicao[i] = posicao[j];
+        posicao[j] = t;
+    }
+
+    // A sala k da ordem de largura vai para destino[posicao[k]];
+    // os filhos da sala k são as próximas a entrar na fila
+    fila[fim++] = raiz;
+    while (inicio < fim) {
+        const Sala *original = fila[inicio];
+        Sala *copia = &destino[posicao[inicio]];
+        inicio++;
+        *copia = *original;
+        if (original->esq != NULL) {
+            copia->esq = &destino[posicao[fim]];
+            fila[fim++] = original->esq;
+        }
+        if (original->dir != NULL) {
+            copia->dir = &destino[posicao[fim]];
+            fila[fim++] = original->dir;
+        }
+    }
+
+    Sala *nova = &destino[posicao[0]];
+    free(posicao);
+    free(fila);
+    return nova;
+}
+
+unsigned long long percorrerPonteiros(const Sala *raiz, const Sala **pilha) {
+    unsigned long long soma = 0;
+    int topo = 0;
+
+    pilha[topo++] = raiz;
+    while (topo > 0) {
+        const Sala *sala = pilha[--topo];
+        soma += sala->nome;
+        if (sala->dir != NULL) pilha[topo++] = sala->dir;
+        if (sala->esq != NULL) pilha[topo++] = sala->esq;
+    }
+    return soma;
+}
+
+unsigned long long percorrerExplicita(const Mansao *mansao, int *pilha) {
+    const SalaCompacta *salas = mansao->salas;
+    unsigned long long soma = 0;
+    int topo = 0;
+
+    pilha[topo++] = 0;
+    while (topo > 0) {
+        const SalaCompacta *sala = &salas[pilha[--topo]];
+        soma += sala->nome;
+        if (sala->dir != SEM_SALA) pilha[topo++] = sala->dir;
+        if (sala->esq != SEM_SALA) pilha[topo++] = sala->esq;
+    }
+    return soma;
+}
+
+unsigned long long percorrerImplicita(const Mansao *mansao, int *pilha) {
+    const SalaImplicita *slots = mansao->implicitas;
+    unsigned int numSlots = mansao->numSlots;
+    unsigned long long soma = 0;
+    int topo = 0;
+
+    pilha[topo++] = 0;
+    while (topo > 0) {
+        unsigned int slot = (unsigned int)pilha[--topo];
+        unsigned int esq = 2 * slot + 1;
+        soma += slots[slot].nome;
+        if (esq + 1 < numSlots && slots[esq + 1].nome != TEXTO_VAZIO) pilha[topo++] = (int)esq + 1;
+        if (esq < numSlots && slots[esq].nome != TEXTO_VAZIO) pilha[topo++] = (int)esq;
+    }
+    return soma;
+}
+
+// Descidas: um bit aleatório por nível escolhe o lado
+unsigned long long descerPonteiros(const Sala *raiz, unsigned long long semente) {
+    unsigned long long soma = 0;
+
+    for (int d = 0; d < DESCIDAS_BENCH; d++) {
+        unsigned long long r = proximoAleatorio(&semente);
+        for (const Sala *sala = raiz; sala != NULL; r >>= 1) {
+            soma += sala->pista;
+            sala = (r & 1) ? sala->dir : sala->esq;
+        }
+    }
+    return soma;
+}
+
+unsigned long long descerExplicita(const Mansao *mansao, unsigned long long semente) {
+    unsigned long long soma = 0;
+
+    for (int d = 0; d < DESCIDAS_BENCH; d++) {
+        unsigned long long r = proximoAleatorio(&semente);
+        for (int sala = 0; sala != SEM_SALA; r >>= 1) {
+            soma += mansao->salas[sala].pista;
+            sala = (r & 1) ? mansao->salas[sala].dir : mansao->salas[sala].esq;
+        }
+    }
+    return soma;
+}
+
+unsigned long long descerImplicita(const Mansao *mansao, unsigned long long semente) {
+    unsigned long long soma = 0;
+
+    for (int d = 0; d < DESCIDAS_BENCH; d++) {
+        unsigned long long r = proximoAleatorio(&semente);
+        unsigned int slot = 0;
+        while (slot < mansao->numSlots && mansao->implicitas[slot].nome != TEXTO_VAZIO) {
+            soma += mansao->implicitas[slot].pista;
+            slot = 2 * slot + 1 + (unsigned int)(r & 1);
+            r >>= 1;
+        }
+    }
+    return soma;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int maxNiveis = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 22;
+
+    printf("%10s %-10s %10s %14s %14s %14s\n", "salas", "forma", "bytes/sala", "percurso(ms)",
+           "descidas(ms)", "jogo(ms)");
+    for (unsigned int niveis = 16; niveis <= maxNiveis && niveis < 31; niveis += 3) {
+        unsigned int n = (1u << niveis) - 1;
+        unsigned long long somas[NUM_FORMAS];
+        Arena arena;
+        Mansao mansao;
+
+        inicializarArena(&arena);
+        Sala *raiz = gerarMansaoBenchmark(&arena, 0, 0, n, 9);
+        Sala *espalhadas = (Sala *)realocarOuSair(NULL, (size_t)n * sizeof(Sala));
+        Sala *raizEspalhada = espalharSalas(raiz, n, espalhadas, 9);
+        const Sala **pilhaSalas = (const Sala **)realocarOuSair(NULL, (size_t)n * sizeof(Sala *));
+        int *pilha = (int *)realocarOuSair(NULL, (size_t)n * sizeof(int));
+
+        for (int forma = 0; forma < NUM_FORMAS; forma++) {
+            double percurso = 0, jogo = 0, bytes = sizeof(Sala);
+            char textoJogo[16] = "-";
+            unsigned long long soma = 0;
+
+            if (forma == 2) {
+                compactarMansao(raiz, &mansao);
+                bytes = sizeof(SalaCompacta);
+            } else if (forma == 3) {
+                if (!tornarMansaoImplicita(&mansao)) {
+                    printf("A mansao de %u salas nao coube na forma implicita.\n", n);
+                    return 1;
+                }
+                bytes = (double)mansao.numSlots * sizeof(SalaImplicita) / n;
+            }
+
+            for (int rodada = 0; rodada < 5; rodada++) {
+                double t0 = segundosAgora();
+                soma = (forma == 0) ? percorrerPonteiros(raiz, pilhaSalas)
+                     : (forma == 1) ? percorrerPonteiros(raizEspalhada, pilhaSalas)
+                     : (forma == 2) ? percorrerExplicita(&mansao, pilha)
+                                    : percorrerImplicita(&mansao, pilha);
+                double t = segundosAgora() - t0;
+                if (rodada == 0 || t < percurso) percurso = t;
+            }
+            if (forma >= 2) {
+                for (int rodada = 0; rodada < 5; rodada++) {
+                    unsigned long long somaJogo = 0;
+                    double t0 = segundosAgora();
+                    percorrerMansao(&mansao, pilha, somarNomeSala, &somaJogo);
+                    double t = segundosAgora() - t0;
+                    if (rodada == 0 || t < jogo) jogo = t;
+                    if (somaJogo != soma) soma = 0;
+                }
+                snprintf(textoJogo, sizeof(textoJogo), "%.2f", jogo * 1e3);
+            }
+
+            double t0 = segundosAgora();
+            soma += (forma == 0) ? descerPonteiros(raiz, 20)
+                  : (forma == 1) ? descerPonteiros(raizEspalhada, 20)
+                  : (forma == 2) ? descerExplicita(&mansao, 20)
+                                 : descerImplicita(&mansao, 20);
+            double descidas = segundosAgora() - t0;
+            somas[forma] = soma;
+
+            printf("%10u %-10s %10.1f %14.2f %14.2f %14s\n", n, nomesFormasMansao[forma], bytes,
+                   percurso * 1e3, descidas * 1e3, textoJogo);
+            fflush(stdout);
+        }
+        for (int forma = 1; forma < NUM_FORMAS; forma++) {
+            if (somas[forma] != somas[0]) {
+                printf("As formas da mansao de %u salas deram resultados diferentes.\n", n);
+                return 1;
+            }
+        }
+
+        liberarMansao(&mansao);
+        liberarArena(&arena);
+        liberarPoolTextos();
+        free(espalhadas);
+        free(pilhaSalas);
+        free(pilha);
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+// -------------------------------------------------------
+// Benchmark do hash perfeito das pistas do caso contra a
+// tabela dinâmica: de 10^3 até 10^7 pistas (ou o máximo
+// passado na linha de comando), mede a montagem das duas
+// estruturas e as consultas presentes pelo texto e pelo
+// handle e ausentes pelo texto, em ordem embaralhada.
+// Cada consulta vale o melhor de 3 rodadas; as respostas
+// das duas estruturas são conferidas.
+// -------------------------------------------------------
+#include "../src/perfeito.h"
+
+#define SUSPEITOS_BENCH 97
+
+int main(int argc, char *argv[]) {
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 10000000u;
+    HandleTexto suspeitos[SUSPEITOS_BENCH];
+    char texto[TAM_PISTA];
+
+    for (int s = 0; s < SUSPEITOS_BENCH; s++) {
+        snprintf(texto, sizeof(texto), "Suspeito %d", s);
+        suspeitos[s] = internarTexto(texto, TAM_SUSPEITO);
+    }
+
+    printf("%10s %12s %12s %9s %18s %18s %18s\n", "pistas", "montar:hash", "montar:perf", "bits",
+           "texto(ns):hash/perf", "handle(ns):hash/perf", "ausente(ns):hash/perf");
+    for (unsigned int n = 1000; n <= maximo && n != 0; n *= 10) {
+        HandleTexto *pistas = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+        HandleTexto *donos = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+        char (*ausentes)[TAM_PISTA] = (char (*)[TAM_PISTA])realocarOuSair(NULL, (size_t)n * TAM_PISTA);
+        unsigned int *ordem = (unsigned int *)realocarOuSair(NULL, (size_t)n * sizeof(unsigned int));
+        TabelaHash tabela;
+        MapaPerfeito mapa;
+
+        for (unsigned int i = 0; i < n; i++) {
+            snprintf(texto, sizeof(texto), "Pista numero %u de %u", i, n);
+            pistas[i] = internarTexto(texto, TAM_PISTA);
+            donos[i] = suspeitos[i % SUSPEITOS_BENCH];
+            snprintf(ausentes[i], TAM_PISTA, "Ausente numero %u de %u", i, n);
+            ordem[i] = (unsigned int)(((unsigned long long)i * 2654435761u) % n);
+        }
+
+        double t0 = segundosAgora();
+        inicializarHash(&tabela);
+        for (unsigned int i = 0; i < n; i++) inserirNaHashPorHandle(&tabela, pistas[i], donos[i]);
+        double t1 = segundosAgora();
+        if (!construirMapaPerfeito(&mapa, pistas, donos, n)) {
+            printf("O hash perfeito de %u pistas nao foi montado.\n", n);
+            return 1;
+        }
+        double t2 = segundosAgora();
+        double montarHash = t1 - t0, montarPerfeito = t2 - t1;
+
+        // Consultas: 0/1 texto, 2/3 handle, 4/5 ausente (hash/perf)
+        double tempos[6];
+        for (int rodada = 0; rodada < 3; rodada++) {
+            unsigned int certos[6] = { 0, 0, 0, 0, 0, 0 };
+            double t[7];
+
+            t[0] = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                unsigned int k = ordem[i];
+                const char *s = encontrarSuspeito(&tabela, textoDe(pistas[k]));
+                certos[0] += s == textoDe(donos[k]);
+            }
+            t[1] = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                unsigned int k = ordem[i];
+                certos[1] += consultarMapaPerfeito(&mapa, textoDe(pistas[k])) == donos[k];
+            }
+            t[2] = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                unsigned int k = ordem[i];
+                certos[2] += encontrarSuspeitoPorHandle(&tabela, pistas[k]) == donos[k];
+            }
+            t[3] = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                unsigned int k = ordem[i];
+                certos[3] += consultarMapaPerfeitoPorHandle(&mapa, pistas[k]) == donos[k];
+            }
+            t[4] = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                certos[4] += encontrarSuspeito(&tabela, ausentes[ordem[i]]) == NULL;
+            }
+            t[5] = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                certos[5] += consultarMapaPerfeito(&mapa, ausentes[ordem[i]]) == TEXTO_INEXISTENTE;
+            }
+            t[6] = segundosAgora();
+
+            for (int c = 0; c < 6; c++) {
+                if (certos[c] != n) {
+                    printf("Respostas erradas com %u pistas.\n", n);
+                    return 1;
+                }
+                if (rodada == 0 || t[c + 1] - t[c] < tempos[c]) tempos[c] = t[c + 1] - t[c];
+            }
+        }
+
+        printf("%10u %10.1fms %10.1fms %9.2f %8.1f / %7.1f %8.1f / %7.1f %8.1f / %7.1f\n", n,
+               montarHash * 1e3, montarPerfeito * 1e3, bitsPorPistaMapaPerfeito(&mapa),
+               tempos[0] * 1e9 / n, tempos[1] * 1e9 / n, tempos[2] * 1e9 / n, tempos[3] * 1e9 / n,
+               tempos[4] * 1e9 / n, tempos[5] * 1e9 / n);
+        fflush(stdout);
+
+        liberarMapaPerfeito(&mapa);
+        liberarHash(&tabela);
+        free(pistas);
+        free(donos);
+        free(ausentes);
+        free(ordem);
+        liberarPoolTextos();
+        for (int s = 0; s < SUSPEITOS_BENCH; s++) {
+            snprintf(texto, sizeof(texto), "Suspeito %d", s);
+            suspeitos[s] = internarTexto(texto, TAM_SUSPEITO);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+// -------------------------------------------------------
+// Benchmark da árvore de pistas do Mestre: inserção de n
+// pistas em ordem crescente, decrescente e aleatória, e
+// busca de todas depois, na árvore B+ contra a BST sem
+// balanceamento da versão original (refeita aqui, recursiva
+// como era). A BST só roda até MAX_BST pistas: em ordem ela
+// vira uma lista, com inserção O(n) e recursão de n níveis.
+// -------------------------------------------------------
+#include "../src/pistas.h"
+
+#define MAX_BST         20000
+#define TAM_TEXTO_BENCH 32
+
+// PistaNode da versão original
+typedef struct NoOriginal {
+    char pista[TAM_PISTA];
+    struct NoOriginal *esq;
+    struct NoOriginal *dir;
+} NoOriginal;
+
+NoOriginal* inserirNaOriginal(NoOriginal *raiz, const char *pista) {
+    if (raiz == NULL) {
+        NoOriginal *novo = (NoOriginal *)realocarOuSair(NULL, sizeof(NoOriginal));
+        strcpy(novo->pista, pista);
+        novo->esq = novo->dir = NULL;
+        return novo;
+    }
+    int cmp = strcmp(pista, raiz->pista);
+    if (cmp < 0) {
+        raiz->esq = inserirNaOriginal(raiz->esq, pista);
+    } else if (cmp > 0) {
+        raiz->dir = inserirNaOriginal(raiz->dir, pista);
+    }
+    return raiz;
+}
+
+const NoOriginal* buscarNaOriginal(const NoOriginal *raiz, const char *pista) {
+    while (raiz != NULL) {
+        int cmp = strcmp(pista, raiz->pista);
+        if (cmp == 0) return raiz;
+        raiz = (cmp < 0) ? raiz->esq : raiz->dir;
+    }
+    return NULL;
+}
+
+void liberarOriginal(NoOriginal *raiz) {
+    while (raiz != NULL) {
+        // Gira a subárvore esquerda para a direita: sem recursão
+        if (raiz->esq != NULL) {
+            NoOriginal *esq = raiz->esq;
+            raiz->esq = esq->dir;
+            esq->dir = raiz;
+            raiz = esq;
+        } else {
+            NoOriginal *dir = raiz->dir;
+            free(raiz);
+            raiz = dir;
+        }
+    }
+}
+
+// Textos na ordem pedida: 0 crescente, 1 decrescente, 2
+// aleatória (2654435761 é primo com 2 e 5, então i -> v é
+// uma permutação quando n só tem esses fatores)
+void gerarTextos(char (*textos)[TAM_TEXTO_BENCH], unsigned int n, int ordem) {
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int v = (ordem == 0) ? i : (ordem == 1) ? n - 1 - i
+                                                         : (unsigned int)(((unsigned long long)i * 2654435761u) % n);
+        snprintf(textos[i], TAM_TEXTO_BENCH, "Registro %08u", v);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    static const char *nomesOrdens[] = { "crescente", "decrescente", "aleatoria" };
+    static const unsigned int tamanhos[] = { 10000, 20000, 100000, 1000000 };
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 1000000u;
+
+    printf("%-12s %9s %14s %14s %14s %14s\n", "ordem", "pistas", "BST:ins(ms)", "B+:ins(ms)",
+           "BST:busca(ns)", "B+:busca(ns)");
+    for (unsigned int t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]) && tamanhos[t] <= maximo; t++) {
+        unsigned int n = tamanhos[t];
+        char (*textos)[TAM_TEXTO_BENCH] = (char (*)[TAM_TEXTO_BENCH])realocarOuSair(
+            NULL, (size_t)n * TAM_TEXTO_BENCH);
+        HandleTexto *handles = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+
+        for (int ordem = 0; ordem < 3; ordem++) {
+            char bstIns[16] = "-", bstBusca[16] = "-";
+            unsigned int achadas = 0;
+
+            gerarTextos(textos, n, ordem);
+            if (n <= MAX_BST) {
+                NoOriginal *raiz = NULL;
+                double t0 = segundosAgora();
+                for (unsigned int i = 0; i < n; i++) {
+                    raiz = inserirNaOriginal(raiz, textos[i]);
+                }
+                double t1 = segundosAgora();
+                for (unsigned int i = 0; i < n; i++) {
+                    achadas += buscarNaOriginal(raiz, textos[i]) != NULL;
+                }
+                double t2 = segundosAgora();
+                snprintf(bstIns, sizeof(bstIns), "%.1f", (t1 - t0) * 1e3);
+                snprintf(bstBusca, sizeof(bstBusca), "%.1f", (t2 - t1) * 1e9 / n);
+                liberarOriginal(raiz);
+            }
+
+            // Os textos são internados fora da medida, como na coleta
+            Arena arena;
+            ArvorePistas arvore;
+            inicializarArena(&arena);
+            inicializarPistas(&arvore, &arena);
+            for (unsigned int i = 0; i < n; i++) {
+                handles[i] = internarTexto(textos[i], TAM_PISTA);
+            }
+            double t0 = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                inserirPista(&arvore, handles[i]);
+            }
+            double t1 = segundosAgora();
+            for (unsigned int i = 0; i < n; i++) {
+                achadas += buscarPista(&arvore, textos[i]) != TEXTO_INEXISTENTE;
+            }
+            double t2 = segundosAgora();
+
+            if (achadas != ((n <= MAX_BST) ? 2 * n : n) || arvore.quantidade != (int)n) {
+                printf("Respostas erradas com %u pistas.\n", n);
+                return 1;
+            }
+            printf("%-12s %9u %14s %14.1f %14s %14.1f\n", nomesOrdens[ordem], n, bstIns,
+                   (t1 - t0) * 1e3, bstBusca, (t2 - t1) * 1e9 / n);
+            fflush(stdout);
+            liberarArena(&arena);
+            liberarPoolTextos();
+        }
+        free(textos);
+        free(handles);
+    }
+    return 0;
+}
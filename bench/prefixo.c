@@ -0,0 +1,132 @@
+// -------------------------------------------------------
+// Benchmark das consultas por prefixo em n pistas (10^6 por
+// padrão) com textos "Pista xxxxxxxx" aleatórios. Para cada
+// tamanho de prefixo, o tempo médio por consulta de:
+//   varredura  todas as folhas com strncmp, que era o único
+//              jeito antes do cursor
+//   cursor     posicionarPrefixo + proximaPista, que para
+//              no primeiro texto fora do prefixo
+//   contar     listarPrefixoRadix sem copiar pistas
+//   listar     listarPrefixoRadix copiando todas
+// Todas as formas têm de achar as mesmas pistas.
+// -------------------------------------------------------
+#include "../src/benchmark.h"
+
+#define CONSULTAS_BENCH  1000
+#define VARREDURAS_BENCH 3
+
+unsigned long long varrerPrefixo(const ArvorePistas *arvore, const char *prefixo, unsigned int *quantas) {
+    size_t tamanho = strlen(prefixo);
+    unsigned long long soma = 0;
+
+    *quantas = 0;
+    for (const NoBMais *folha = arvore->primeiraFolha; folha != NULL; folha = folha->proximo) {
+        for (int i = 0; i < folha->quantidade; i++) {
+            if (strncmp(textoDe(folha->pistas[i]), prefixo, tamanho) == 0) {
+                soma += folha->pistas[i];
+                (*quantas)++;
+            }
+        }
+    }
+    return soma;
+}
+
+unsigned long long cursorPrefixo(const ArvorePistas *arvore, const char *prefixo, unsigned int *quantas) {
+    unsigned long long soma = 0;
+    CursorPistas cursor;
+    HandleTexto pista;
+
+    *quantas = 0;
+    posicionarPrefixo(arvore, prefixo, &cursor);
+    while ((pista = proximaPista(&cursor)) != TEXTO_INEXISTENTE) {
+        soma += pista;
+        (*quantas)++;
+    }
+    return soma;
+}
+
+unsigned long long listarRadix(const IndiceRadix *indice, const char *prefixo, HandleTexto *saida,
+                               unsigned int max, unsigned int *quantas) {
+    unsigned long long soma = 0;
+
+    *quantas = listarPrefixoRadix(indice, prefixo, saida, max);
+    for (unsigned int i = 0; i < *quantas && i < max; i++) {
+        soma += saida[i];
+    }
+    return soma;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int n = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 1000000u;
+    char texto[TAM_PISTA];
+    char prefixos[CONSULTAS_BENCH][TAM_PISTA];
+    unsigned long long semente = 16;
+    Arena arena;
+    ArvorePistas arvore;
+    IndiceRadix indice;
+
+    inicializarArena(&arena);
+    inicializarPistas(&arvore, &arena);
+    inicializarRadix(&indice, &arena);
+    for (unsigned int i = 0; i < n; i++) {
+        snprintf(texto, sizeof(texto), "Pista %08x", (unsigned int)proximoAleatorio(&semente));
+        HandleTexto pista = internarTexto(texto, TAM_PISTA);
+        inserirPista(&arvore, pista);
+        inserirNoRadix(&indice, pista);
+    }
+    HandleTexto *saida = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+
+    printf("%d pistas\n", arvore.quantidade);
+    printf("%-16s %10s %14s %12s %12s %12s\n", "prefixo", "achadas", "varredura(us)", "cursor(us)",
+           "contar(us)", "listar(us)");
+    for (int digitos = 1; digitos <= 6; digitos++) {
+        unsigned int totais[4] = { 0, 0, 0, 0 };
+        unsigned long long somas[4] = { 0, 0, 0, 0 };
+        unsigned int quantas = 0;
+
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            snprintf(prefixos[c], TAM_PISTA, "Pista %08x", (unsigned int)proximoAleatorio(&semente));
+            prefixos[c][6 + digitos] = '\0';
+        }
+
+        double t0 = segundosAgora();
+        for (int c = 0; c < VARREDURAS_BENCH; c++) {
+            somas[0] += varrerPrefixo(&arvore, prefixos[c], &quantas);
+            totais[0] += quantas;
+        }
+        double t1 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            somas[1] += cursorPrefixo(&arvore, prefixos[c], &quantas);
+            totais[1] += quantas;
+            if (c == VARREDURAS_BENCH - 1 && (somas[1] != somas[0] || totais[1] != totais[0])) {
+                printf("A varredura e o cursor discordam no prefixo de %d digitos.\n", digitos);
+                return 1;
+            }
+        }
+        double t2 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            totais[2] += listarPrefixoRadix(&indice, prefixos[c], saida, 0);
+        }
+        double t3 = segundosAgora();
+        for (int c = 0; c < CONSULTAS_BENCH; c++) {
+            somas[3] += listarRadix(&indice, prefixos[c], saida, n, &quantas);
+            totais[3] += quantas;
+        }
+        double t4 = segundosAgora();
+
+        if (totais[2] != totais[1] || totais[3] != totais[1] || somas[3] != somas[1]) {
+            printf("O radix e o cursor discordam no prefixo de %d digitos.\n", digitos);
+            return 1;
+        }
+        snprintf(texto, sizeof(texto), "Pista %.*s", digitos, "xxxxxx");
+        printf("%-16s %10.1f %14.1f %12.2f %12.2f %12.2f\n", texto, (double)totais[1] / CONSULTAS_BENCH,
+               (t1 - t0) * 1e6 / VARREDURAS_BENCH, (t2 - t1) * 1e6 / CONSULTAS_BENCH,
+               (t3 - t2) * 1e6 / CONSULTAS_BENCH, (t4 - t3) * 1e6 / CONSULTAS_BENCH);
+        fflush(stdout);
+    }
+
+    free(saida);
+    liberarArena(&arena);
+    liberarPoolTextos();
+    return 0;
+}
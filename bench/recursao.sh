@@ -0,0 +1,85 @@
+#!/bin/sh
+# -------------------------------------------------------
+# Percursos do Aventureiro numa árvore de pistas degenerada
+# (uma cadeia de n pistas pela esquerda): exibirPistas e
+# liberarArvorePistas recursivas da versão original (revisão
+# baseline no git) contra o percurso de Morris e a liberação
+# por rotações atuais. Cada medida roda num processo próprio; "estouro"
+# quer dizer que a recursão estourou a pilha do processo.
+# Uso: bench/recursao.sh
+# -------------------------------------------------------
+cd "$(dirname "$0")/.." || exit 1
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+ORIGINAL=$(git log --format=%h --grep='^baseline$' | tail -n 1)
+if [ -z "$ORIGINAL" ] || ! git show "$ORIGINAL:aventureiro.c" > "$DIR/original.c" 2>/dev/null; then
+    echo "Revisao original do aventureiro.c nao encontrada no git."
+    exit 1
+fi
+cp aventureiro.c "$DIR/atual.c"
+
+cat > "$DIR/medida.c" <<'FIM'
+#include <time.h>
+#define main jogoAventureiro
+#include ARVORE
+#undef main
+
+// Medida: <n> <0 exibir, 1 liberar>; imprime ns por pista
+static double agora(void) {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int n = (argc > 2) ? (unsigned int)strtoul(argv[1], NULL, 10) : 0;
+    int modo = (argc > 2) ? atoi(argv[2]) : 0;
+    PistaNode *raiz = NULL;
+    char texto[32];
+
+    // Cadeia pela esquerda, como a BST original fica com as
+    // pistas em ordem decrescente: a chamada recursiva à direita
+    // vira laço no -O2, a da esquerda não
+    for (unsigned int i = 0; i < n; i++) {
+        snprintf(texto, sizeof(texto), "Registro %08u", i);
+        PistaNode *no = criarNoPista(texto);
+        no->esq = raiz;
+        raiz = no;
+    }
+    double t0 = agora();
+    if (modo == 0) {
+        exibirPistas(raiz);
+    } else {
+        liberarArvorePistas(raiz);
+    }
+    double t1 = agora();
+    fflush(stdout);
+    fprintf(stderr, "%.1f\n", (t1 - t0) * 1e9 / n);
+    return 0;
+}
+FIM
+for versao in original atual; do
+    ${CC:-cc} -std=c11 -O2 -DARVORE="\"$DIR/$versao.c\"" -o "$DIR/$versao" "$DIR/medida.c" || exit 1
+done
+
+# ns por pista, ou "estouro" se o processo morreu
+medir() {
+    if "$DIR/$1" "$2" "$3" > "$DIR/saida.txt" 2> "$DIR/tempo.txt"; then
+        if [ "$3" = 0 ] && [ "$(wc -l < "$DIR/saida.txt")" -ne "$2" ]; then
+            echo "errado"
+        else
+            cat "$DIR/tempo.txt"
+        fi
+    else
+        echo "estouro"
+    fi
+}
+
+echo "Aventureiro: recursao original ($ORIGINAL) contra a versao atual, pilha de $(ulimit -s) KB"
+printf "%10s %18s %18s %18s %18s\n" pistas "exibir:rec(ns)" "exibir:atual(ns)" "liberar:rec(ns)" \
+    "liberar:atual(ns)"
+for n in 10000 100000 1000000 10000000; do
+    printf "%10s %18s %18s %18s %18s\n" $n "$(medir original $n 0)" "$(medir atual $n 0)" \
+        "$(medir original $n 1)" "$(medir atual $n 1)"
+done
@@ -0,0 +1,164 @@
+// -------------------------------------------------------
+// Benchmark do índice suspeito -> pistas: listar as pistas
+// contra um suspeito pelo índice invertido (pistasDoSuspeito)
+// contra o jeito antigo, que percorre todas as pistas em
+// ordem e consulta a hash para cada uma. São duas versões do
+// jeito antigo: contarPistasPorSuspeitoRec como era (BST de
+// strings, recursão, encontrarSuspeito e strcmp) e a mesma
+// varredura nas folhas da árvore B+ com busca por handle,
+// em que a diferença para o índice é só do algoritmo.
+// Pistas distribuídas entre SUSPEITOS_BENCH suspeitos.
+// -------------------------------------------------------
+#include "../src/pistas.h"
+#include "../src/hash.h"
+
+#define SUSPEITOS_BENCH 1000
+
+// PistaNode da versão original
+typedef struct NoOriginal {
+    char pista[TAM_PISTA];
+    struct NoOriginal *esq;
+    struct NoOriginal *dir;
+} NoOriginal;
+
+NoOriginal* inserirNaOriginal(NoOriginal *raiz, const char *pista) {
+    if (raiz == NULL) {
+        NoOriginal *novo = (NoOriginal *)realocarOuSair(NULL, sizeof(NoOriginal));
+        strcpy(novo->pista, pista);
+        novo->esq = novo->dir = NULL;
+        return novo;
+    }
+    int cmp = strcmp(pista, raiz->pista);
+    if (cmp < 0) {
+        raiz->esq = inserirNaOriginal(raiz->esq, pista);
+    } else if (cmp > 0) {
+        raiz->dir = inserirNaOriginal(raiz->dir, pista);
+    }
+    return raiz;
+}
+
+void liberarOriginal(NoOriginal *raiz) {
+    if (raiz == NULL) return;
+    liberarOriginal(raiz->esq);
+    liberarOriginal(raiz->dir);
+    free(raiz);
+}
+
+// contarPistasPorSuspeitoRec da versão original
+void contarPistasPorSuspeitoRec(NoOriginal *raiz, TabelaHash *tabela, const char *alvo, int *contador) {
+    if (raiz == NULL) return;
+    contarPistasPorSuspeitoRec(raiz->esq, tabela, alvo, contador);
+    const char *suspeito = encontrarSuspeito(tabela, raiz->pista);
+    if (suspeito != NULL && strcmp(suspeito, alvo) == 0) {
+        (*contador)++;
+    }
+    contarPistasPorSuspeitoRec(raiz->dir, tabela, alvo, contador);
+}
+
+// Varredura: todas as pistas em ordem, uma busca na hash cada
+unsigned long long varrerPistas(const ArvorePistas *arvore, TabelaHash *tabela,
+                                HandleTexto alvo, unsigned int *quantas) {
+    unsigned long long soma = 0;
+
+    *quantas = 0;
+    for (const NoBMais *folha = arvore->primeiraFolha; folha != NULL; folha = folha->proximo) {
+        for (int i = 0; i < folha->quantidade; i++) {
+            if (encontrarSuspeitoPorHandle(tabela, folha->pistas[i]) == alvo) {
+                soma += folha->pistas[i];
+                (*quantas)++;
+            }
+        }
+    }
+    return soma;
+}
+
+unsigned long long listarPeloIndice(const TabelaHash *tabela, HandleTexto alvo, unsigned int *quantas) {
+    unsigned long long soma = 0;
+    const HandleTexto *pistas = pistasDoSuspeito(tabela, alvo, quantas);
+
+    for (unsigned int i = 0; i < *quantas; i++) {
+        soma += pistas[i];
+    }
+    return soma;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int maximo = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 1000000u;
+    HandleTexto suspeitos[SUSPEITOS_BENCH];
+    char texto[TAM_PISTA];
+
+    printf("%10s %12s %16s %16s %14s %10s\n", "pistas", "do suspeito", "recursiva(us)", "varredura(us)",
+           "indice(us)", "razao");
+    for (unsigned int n = 10000; n <= maximo && n != 0; n *= 10) {
+        Arena arena;
+        ArvorePistas arvore;
+        TabelaHash tabela;
+
+        inicializarArena(&arena);
+        inicializarPistas(&arvore, &arena);
+        inicializarHash(&tabela);
+        NoOriginal *original = NULL;
+        for (int s = 0; s < SUSPEITOS_BENCH; s++) {
+            snprintf(texto, sizeof(texto), "Suspeito %d", s);
+            suspeitos[s] = internarTexto(texto, TAM_SUSPEITO);
+        }
+        for (unsigned int i = 0; i < n; i++) {
+            snprintf(texto, sizeof(texto), "Pista numero %u", i);
+            HandleTexto pista = internarTexto(texto, TAM_PISTA);
+            inserirPista(&arvore, pista);
+            inserirNaHashPorHandle(&tabela, pista, suspeitos[i % SUSPEITOS_BENCH]);
+        }
+        // Na BST original as pistas entram numa ordem embaralhada,
+        // senão ela vira uma lista (ver bench/pistas.c)
+        for (unsigned int i = 0; i < n; i++) {
+            snprintf(texto, sizeof(texto), "Pista numero %u",
+                     (unsigned int)(((unsigned long long)i * 2654435761u) % n));
+            original = inserirNaOriginal(original, texto);
+        }
+
+        // Tempo por consulta, em suspeitos diferentes (melhor de 3 rodadas)
+        double recursiva = 0, varredura = 0, indice = 0;
+        unsigned int quantas = 0;
+        for (int rodada = 0; rodada < 3; rodada++) {
+            unsigned long long somaVarredura = 0, somaIndice = 0;
+            unsigned int qVarredura = 0, qIndice = 0;
+            int consultas = (n >= 1000000) ? 10 : 100;
+
+            int contador = 0;
+
+            double tr = segundosAgora();
+            for (int c = 0; c < consultas; c++) {
+                contador = 0;
+                contarPistasPorSuspeitoRec(original, &tabela, textoDe(suspeitos[c * 7 % SUSPEITOS_BENCH]),
+                                           &contador);
+            }
+            double t0 = segundosAgora();
+            for (int c = 0; c < consultas; c++) {
+                somaVarredura += varrerPistas(&arvore, &tabela, suspeitos[c * 7 % SUSPEITOS_BENCH], &qVarredura);
+            }
+            double t1 = segundosAgora();
+            for (int c = 0; c < consultas; c++) {
+                somaIndice += listarPeloIndice(&tabela, suspeitos[c * 7 % SUSPEITOS_BENCH], &qIndice);
+            }
+            double t2 = segundosAgora();
+
+            if (somaVarredura != somaIndice || qVarredura != qIndice || (unsigned int)contador != qIndice) {
+                printf("O indice e a varredura discordam com %u pistas.\n", n);
+                return 1;
+            }
+            quantas = qIndice;
+            if (rodada == 0 || (t0 - tr) / consultas < recursiva) recursiva = (t0 - tr) / consultas;
+            if (rodada == 0 || (t1 - t0) / consultas < varredura) varredura = (t1 - t0) / consultas;
+            if (rodada == 0 || (t2 - t1) / consultas < indice) indice = (t2 - t1) / consultas;
+        }
+        printf("%10u %12u %16.1f %16.1f %14.3f %9.0fx\n", n, quantas, recursiva * 1e6, varredura * 1e6,
+               indice * 1e6, recursiva / indice);
+        fflush(stdout);
+
+        liberarOriginal(original);
+        liberarHash(&tabela);
+        liberarArena(&arena);
+        liberarPoolTextos();
+    }
+    return 0;
+}
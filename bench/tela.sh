@@ -0,0 +1,55 @@
+#!/bin/sh
+# -------------------------------------------------------
+# Vazão das telas do jogo (writev) contra a versão que
+# imprimia com printf, a revisão anterior à Tela no git.
+# Uma partida de PASSOS movimentos (esquerda, direita e
+# opções inválidas) é jogada com a saída em /dev/null, num
+# pipe e num arquivo; cada medida é a melhor de 3.
+# Uso: bench/tela.sh [binario]   (PASSOS=2000000 por padrão)
+# -------------------------------------------------------
+cd "$(dirname "$0")/.." || exit 1
+MESTRE=${1:-./mestre}
+PASSOS=${PASSOS:-2000000}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+ANTES=$(git log --format=%h --grep='^\[user-022\] Render' | tail -n 1)
+if [ -z "$ANTES" ] || ! git show "$ANTES^:mestre.c" > "$DIR/antigo.c" 2>/dev/null; then
+    echo "Revisao anterior a Tela nao encontrada no git."
+    exit 1
+fi
+${CC:-cc} -std=c11 -O2 -o "$DIR/antigo" "$DIR/antigo.c" -pthread || exit 1
+
+awk -v n="$PASSOS" 'BEGIN {
+    srand(22);
+    for (i = 0; i < n; i++) print substr("eedx", int(rand() * 4) + 1, 1);
+    print "s"; print "Ninguem";
+}' > "$DIR/entrada.txt"
+
+# Melhor de 3, em segundos: medir <binario> <destino>
+medir() {
+    melhor=""
+    for _ in 1 2 3; do
+        inicio=$(date +%s%N)
+        case "$2" in
+            pipe) "$1" < "$DIR/entrada.txt" | cat > /dev/null ;;
+            arquivo) "$1" < "$DIR/entrada.txt" > "$DIR/saida.txt" ;;
+            *) "$1" < "$DIR/entrada.txt" > /dev/null ;;
+        esac
+        fim=$(date +%s%N)
+        t=$((fim - inicio))
+        if [ -z "$melhor" ] || [ "$t" -lt "$melhor" ]; then melhor=$t; fi
+    done
+    echo "$melhor" | awk '{ printf "%.3f", $1 / 1e9 }'
+}
+
+"$MESTRE" < "$DIR/entrada.txt" > "$DIR/saida.txt"
+bytes=$(wc -c < "$DIR/saida.txt")
+echo "Telas: $PASSOS passos, $bytes bytes de saida, antes = $ANTES^"
+printf "%-10s %10s %10s %10s\n" destino "printf(s)" "writev(s)" "MB/s novo"
+for destino in devnull pipe arquivo; do
+    a=$(medir "$DIR/antigo" $destino)
+    b=$(medir "$MESTRE" $destino)
+    printf "%-10s %10s %10s %10s\n" $destino "$a" "$b" \
+        "$(echo "$bytes $b" | awk '{ printf "%.0f", $1 / 1e6 / $2 }')"
+done
@@ -0,0 +1,73 @@
+#!/bin/sh
+# -------------------------------------------------------
+# Escala do modo em lote: o mesmo roteiro de SESSOES
+# sessões numa mansão equilibrada de 2^16 - 1 salas, com
+# --threads 1, 2, 4 e 8 (e um por núcleo). Cada medida é a
+# melhor de 3, em sessões por segundo, tirada do resumo que
+# o lote escreve em stderr. A saída de todas as execuções
+# tem de ser igual à de uma thread.
+# Uso: bench/threads.sh [binario]   (SESSOES=1000000 por padrão)
+# -------------------------------------------------------
+cd "$(dirname "$0")/.." || exit 1
+MESTRE=${1:-./mestre}
+SESSOES=${SESSOES:-1000000}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+NUCLEOS=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)
+
+# Mansão: sala i tem filhos 2i+1 e 2i+2; 9 em cada 10 têm pista
+awk 'BEGIN {
+    n = 65535;
+    srand(11);
+    for (i = 0; i < n; i++) {
+        esq = (2 * i + 1 < n) ? 2 * i + 1 : "-";
+        dir = (2 * i + 2 < n) ? 2 * i + 2 : "-";
+        if (i % 10 == 0) print i "|Sala " i "|||" esq "|" dir;
+        else print i "|Sala " i "|Pista " i "|Suspeito " int(rand() * 64) "|" esq "|" dir;
+    }
+}' > "$DIR/mansao.txt"
+
+# Sessões de 4 a 15 movimentos, a maioria com acusação
+awk -v n="$SESSOES" 'BEGIN {
+    srand(12);
+    for (i = 0; i < n; i++) {
+        passos = 4 + int(rand() * 12);
+        linha = "";
+        for (p = 0; p < passos; p++) linha = linha substr("ed", int(rand() * 2) + 1, 1);
+        if (rand() < 0.9) linha = linha " s Suspeito " int(rand() * 64);
+        print linha;
+    }
+}' > "$DIR/roteiro.txt"
+
+"$MESTRE" --converter "$DIR/mansao.txt" "$DIR/mansao.bin" > /dev/null || exit 1
+
+# Melhor de 3: sessões por segundo com <threads>
+medir() {
+    melhor=0
+    for _ in 1 2 3; do
+        "$MESTRE" --mansao "$DIR/mansao.bin" --lote "$DIR/roteiro.txt" --threads "$1" \
+            > "$DIR/saida_$1.txt" 2> "$DIR/resumo.txt" || return 1
+        taxa=$(sed -n 's/.*(\([0-9]*\) sessoes\/s.*/\1/p' "$DIR/resumo.txt")
+        if [ -n "$taxa" ] && [ "$taxa" -gt "$melhor" ]; then melhor=$taxa; fi
+    done
+    echo "$melhor"
+}
+
+echo "Lote: $SESSOES sessoes, mansao de 65535 salas, $NUCLEOS nucleo(s) nesta maquina"
+printf "%8s %14s %10s\n" threads "sessoes/s" "vs 1"
+base=""
+for t in 1 2 4 8 "$NUCLEOS"; do
+    case " $feitas " in *" $t "*) continue ;; esac
+    feitas="$feitas $t"
+    taxa=$(medir "$t") || exit 1
+    if ! cmp -s "$DIR/saida_1.txt" "$DIR/saida_$t.txt"; then
+        echo "A saida com $t thread(s) difere da saida com 1."
+        exit 1
+    fi
+    [ -z "$base" ] && base=$taxa
+    printf "%8s %14s %10s\n" "$t" "$taxa" "$(echo "$taxa $base" | awk '{ printf "%.2fx", $1 / $2 }')"
+done
+if [ "$NUCLEOS" -lt 2 ]; then
+    echo "Com 1 nucleo, mais threads nao podem escalar: a tabela mede so o custo de dividir o trabalho."
+fi
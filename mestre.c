@@ -1,457 +1,485 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-#define TAM_NOME_SALA   50
-#define TAM_PISTA       120
-#define TAM_SUSPEITO    40
-#define TAM_TABELA_HASH 23   // tamanho primo simples para hash
-
-// -------------------------------------------------------
-// Struct da Sala (árvore binária da mansão)
-// -------------------------------------------------------
-typedef struct Sala {
-    char nome[TAM_NOME_SALA];   // nome da sala
-    char pista[TAM_PISTA];      // texto da pista
-    char suspeito[TAM_SUSPEITO]; // nome do suspeito ligado à pista
-    struct Sala *esq;
-    struct Sala *dir;
-} Sala;
-
-// -------------------------------------------------------
-// Struct da BST de Pistas (guarda só a pista como string)
-// -------------------------------------------------------
-typedef struct PistaNode {
-    char pista[TAM_PISTA];
-    struct PistaNode *esq;
-    struct PistaNode *dir;
-} PistaNode;
-
-// -------------------------------------------------------
-// Entrada da tabela hash: pista -> suspeito
-// -------------------------------------------------------
-typedef struct HashEntry {
-    char pista[TAM_PISTA];
-    char suspeito[TAM_SUSPEITO];
-    int ocupado;  // 0 = vazio, 1 = ocupado
-} HashEntry;
+#include "src/estatisticas.h"
+#include "src/arena.h"
+#include "src/textos.h"
+#include "src/mansao.h"
+#include "src/caminhos.h"
+#include "src/tela.h"
+#include "src/pistas.h"
+#include "src/hash.h"
+#include "src/perfeito.h"
+#include "src/aproximada.h"
+#include "src/sessao.h"
+#include "src/lote.h"
+#include "src/padrao.h"
+#include "src/benchmark.h"
 
 // -------------------------------------------------------
 // Protótipos das funções principais
 // -------------------------------------------------------
-Sala* criarSala(const char *nome, const char *pista, const char *suspeito);
-
-PistaNode* inserirPista(PistaNode *raiz, const char *pista);
-void exibirPistas(PistaNode *raiz);
-
-void inicializarHash(HashEntry tabela[]);
-unsigned int hashFunc(const char *chave);
-void inserirNaHash(HashEntry tabela[], const char *pista, const char *suspeito);
-const char* encontrarSuspeito(HashEntry tabela[], const char *pista);
-
-void explorarSalas(Sala *raiz, PistaNode **raizPistas, HashEntry tabelaHash[]);
-void verificarSuspeitoFinal(PistaNode *raizPistas, HashEntry tabelaHash[]);
-
-void liberarArvoreSalas(Sala *raiz);
-void liberarArvorePistas(PistaNode *raiz);
-
-// -------------------------------------------------------
-// Função: criarSala
-// Cria dinamicamente um cômodo com pista e suspeito associados
-// -------------------------------------------------------
-Sala* criarSala(const char *nome, const char *pista, const char *suspeito) {
-    Sala *nova = (Sala *)malloc(sizeof(Sala));
-    if (nova == NULL) {
-        printf("Erro ao alocar memoria para a sala '%s'.\n", nome);
-        exit(1);
-    }
-
-    strncpy(nova->nome, nome, TAM_NOME_SALA);
-    nova->nome[TAM_NOME_SALA - 1] = '\0';
-
-    if (pista != NULL) {
-        strncpy(nova->pista, pista, TAM_PISTA);
-        nova->pista[TAM_PISTA - 1] = '\0';
-    } else {
-        nova->pista[0] = '\0';
-    }
-
-    if (suspeito != NULL) {
-        strncpy(nova->suspeito, suspeito, TAM_SUSPEITO);
-        nova->suspeito[TAM_SUSPEITO - 1] = '\0';
-    } else {
-        nova->suspeito[0] = '\0';
-    }
-
-    nova->esq = NULL;
-    nova->dir = NULL;
-
-    return nova;
-}
-
-// -------------------------------------------------------
-// Função: criarNoPista (auxiliar interna)
-// Cria nó da BST de pistas
-// -------------------------------------------------------
-PistaNode* criarNoPista(const char *pista) {
-    PistaNode *novo = (PistaNode *)malloc(sizeof(PistaNode));
-    if (novo == NULL) {
-        printf("Erro ao alocar memoria para no de pista.\n");
-        exit(1);
-    }
-
-    strncpy(novo->pista, pista, TAM_PISTA);
-    novo->pista[TAM_PISTA - 1] = '\0';
-    novo->esq = NULL;
-    novo->dir = NULL;
-
-    return novo;
-}
-
-// -------------------------------------------------------
-// Função: inserirPista
-// Insere pista na BST em ordem alfabética
-// -------------------------------------------------------
-PistaNode* inserirPista(PistaNode *raiz, const char *pista) {
-    if (pista == NULL || pista[0] == '\0') {
-        return raiz; // pista vazia, nada a inserir
-    }
-
-    if (raiz == NULL) {
-        return criarNoPista(pista);
-    }
 
-    int cmp = strcmp(pista, raiz->pista);
-
-    if (cmp < 0) {
-        raiz->esq = inserirPista(raiz->esq, pista);
-    } else if (cmp > 0) {
-        raiz->dir = inserirPista(raiz->dir, pista);
-    } else {
-        // cmp == 0: pista já existente; podemos ignorar duplicata
-    }
-
-    return raiz;
-}
-
-// -------------------------------------------------------
-// Função: exibirPistas
-// Percorre a BST em ordem e mostra todas as pistas
-// -------------------------------------------------------
-void exibirPistas(PistaNode *raiz) {
-    if (raiz == NULL) return;
-
-    exibirPistas(raiz->esq);
-    printf("- %s\n", raiz->pista);
-    exibirPistas(raiz->dir);
-}
-
-// -------------------------------------------------------
-// Funções da Tabela Hash (pista -> suspeito)
-// -------------------------------------------------------
-void inicializarHash(HashEntry tabela[]) {
-    for (int i = 0; i < TAM_TABELA_HASH; i++) {
-        tabela[i].ocupado = 0;
-        tabela[i].pista[0] = '\0';
-        tabela[i].suspeito[0] = '\0';
-    }
-}
-
-// Hash simples (soma de caracteres % TAM_TABELA_HASH)
-unsigned int hashFunc(const char *chave) {
-    unsigned int h = 0;
-    while (*chave) {
-        h = (h * 31) + (unsigned char)(*chave);
-        chave++;
-    }
-    return h % TAM_TABELA_HASH;
-}
-
-// -------------------------------------------------------
-// Função: inserirNaHash
-// Insere associação pista -> suspeito na tabela hash
-// (usa endereçamento aberto linear simples)
-// -------------------------------------------------------
-void inserirNaHash(HashEntry tabela[], const char *pista, const char *suspeito) {
-    if (pista == NULL || pista[0] == '\0') return;
-
-    unsigned int idx = hashFunc(pista);
-    unsigned int start = idx;
-
-    while (tabela[idx].ocupado) {
-        // Se já existir a mesma pista, apenas atualiza suspeito (opcional)
-        if (strcmp(tabela[idx].pista, pista) == 0) {
-            strncpy(tabela[idx].suspeito, suspeito, TAM_SUSPEITO);
-            tabela[idx].suspeito[TAM_SUSPEITO - 1] = '\0';
-            return;
-        }
-        idx = (idx + 1) % TAM_TABELA_HASH;
-        if (idx == start) {
-            // tabela cheia (não deve acontecer neste exercício)
-            printf("Tabela hash cheia! Nao foi possivel inserir nova pista.\n");
-            return;
-        }
-    }
-
-    tabela[idx].ocupado = 1;
-    strncpy(tabela[idx].pista, pista, TAM_PISTA);
-    tabela[idx].pista[TAM_PISTA - 1] = '\0';
-    strncpy(tabela[idx].suspeito, suspeito, TAM_SUSPEITO);
-    tabela[idx].suspeito[TAM_SUSPEITO - 1] = '\0';
-}
-
-// -------------------------------------------------------
-// Função: encontrarSuspeito
-// Retorna o suspeito associado a uma pista (ou NULL se não achar)
-// -------------------------------------------------------
-const char* encontrarSuspeito(HashEntry tabela[], const char *pista) {
-    if (pista == NULL || pista[0] == '\0') return NULL;
-
-    unsigned int idx = hashFunc(pista);
-    unsigned int start = idx;
-
-    while (tabela[idx].ocupado) {
-        if (strcmp(tabela[idx].pista, pista) == 0) {
-            return tabela[idx].suspeito;
-        }
-        idx = (idx + 1) % TAM_TABELA_HASH;
-        if (idx == start) {
-            break; // percorreu tudo
-        }
-    }
-    return NULL; // não encontrou
-}
+void explorarSalas(const Mansao *mansao, ArvorePistas *pistas, TabelaHash *tabelaHash,
+                   SessaoPersistente *sessao);
+void verificarSuspeitoFinal(ArvorePistas *pistas, TabelaHash *tabelaHash, int detalhes);
+int consultarPistas(const Mansao *mansao, Arena *arena, const char *inicio, const char *fim,
+                    const char *prefixo);
 
 // -------------------------------------------------------
 // Função: explorarSalas
 // Navega pela árvore da mansão, mostra pistas e
-// armazena-as na BST e na hash (pista -> suspeito)
+// armazena-as na BST e na hash (pista -> suspeito). Com
+// sessão, cada pista nova também vai para o diário. Cada
+// passo é montado numa Tela e sai num só writev.
 // -------------------------------------------------------
-void explorarSalas(Sala *raiz, PistaNode **raizPistas, HashEntry tabelaHash[]) {
-    Sala *atual = raiz;
+void explorarSalas(const Mansao *mansao, ArvorePistas *pistas, TabelaHash *tabelaHash,
+                   SessaoPersistente *sessao) {
+    int atual = (mansao->quantidade > 0) ? 0 : SEM_SALA;
     char opcao;
+    Tela tela;
 
-    if (atual == NULL) {
+    if (atual == SEM_SALA) {
         printf("Nao ha salas na mansao.\n");
         return;
     }
 
-    printf("===== Detective Quest - Nivel Mestre =====\n");
-    printf("Voce ira explorar a mansao, coletar pistas e relaciona-las a suspeitos.\n");
-    printf("Use 'e' para ir a esquerda, 'd' para a direita e 's' para encerrar.\n");
+    iniciarTela(&tela);
+    TELA_FIXO(&tela, "===== Detective Quest - Nivel Mestre =====\n"
+                     "Voce ira explorar a mansao, coletar pistas e relaciona-las a suspeitos.\n"
+                     "Use 'e' para ir a esquerda, 'd' para a direita e 's' para encerrar.\n");
 
     while (1) {
-        printf("\nVoce esta em: %s\n", atual->nome);
+        ESTAT_INICIO(passo);
+        HandleTexto pista = pistaSala(mansao, atual);
+        HandleTexto suspeito = suspeitoSala(mansao, atual);
+        int esq = salaEsq(mansao, atual);
+        int dir = salaDir(mansao, atual);
+
+        TELA_FIXO(&tela, "\nVoce esta em: ");
+        telaTexto(&tela, nomeSala(mansao, atual));
 
         // Mostrar pista e associar ao suspeito via hash
-        if (atual->pista[0] != '\0') {
-            printf("Pista neste comodo: \"%s\"\n", atual->pista);
-            if (atual->suspeito[0] != '\0') {
-                printf("Esta pista parece apontar para: %s\n", atual->suspeito);
+        if (pista != TEXTO_VAZIO) {
+            TELA_FIXO(&tela, "\nPista neste comodo: \"");
+            telaTexto(&tela, pista);
+            if (suspeito != TEXTO_VAZIO) {
+                TELA_FIXO(&tela, "\"\nEsta pista parece apontar para: ");
+                telaTexto(&tela, suspeito);
+                TELA_FIXO(&tela, "\n");
             } else {
-                printf("Esta pista nao aponta claramente para um suspeito.\n");
+                TELA_FIXO(&tela, "\"\nEsta pista nao aponta claramente para um suspeito.\n");
             }
 
-            // Inserir na BST de pistas
-            *raizPistas = inserirPista(*raizPistas, atual->pista);
+            // Inserir na árvore de pistas
+            int nova = inserirPista(pistas, pista);
 
             // Inserir na hash: pista -> suspeito (se existir suspeito)
-            if (atual->suspeito[0] != '\0') {
-                inserirNaHash(tabelaHash, atual->pista, atual->suspeito);
+            if (suspeito != TEXTO_VAZIO) {
+                inserirNaHashPorHandle(tabelaHash, pista, suspeito);
+            }
+
+            // Pista nova vai para o diário da sessão; um erro de
+            // gravação é impresso depois do que já foi montado
+            if (nova && sessao != NULL) {
+                descarregarTela(&tela);
+                registrarPistaSessao(sessao, pista, suspeito, pistas, tabelaHash);
             }
         } else {
-            printf("Nao ha pistas visiveis neste comodo.\n");
+            TELA_FIXO(&tela, "\nNao ha pistas visiveis neste comodo.\n");
         }
 
         // Opções de navegação
-        printf("Caminhos disponiveis:\n");
-        if (atual->esq != NULL)
-            printf("  [e] Esquerda -> %s\n", atual->esq->nome);
-        if (atual->dir != NULL)
-            printf("  [d] Direita  -> %s\n", atual->dir->nome);
-        printf("  [s] Sair da exploracao\n");
-
-        printf("Escolha (e/d/s): ");
+        TELA_FIXO(&tela, "Caminhos disponiveis:\n");
+        if (esq != SEM_SALA) {
+            TELA_FIXO(&tela, "  [e] Esquerda -> ");
+            telaTexto(&tela, nomeSala(mansao, esq));
+            TELA_FIXO(&tela, "\n");
+        }
+        if (dir != SEM_SALA) {
+            TELA_FIXO(&tela, "  [d] Direita  -> ");
+            telaTexto(&tela, nomeSala(mansao, dir));
+            TELA_FIXO(&tela, "\n");
+        }
+        TELA_FIXO(&tela, "  [s] Sair da exploracao\nEscolha (e/d/s): ");
+
+        mostrarTela(&tela);
+        ESTAT_FIM(PASSO_EXPLORACAO, passo);
+        ESTAT_VERIFICAR();
         scanf(" %c", &opcao);
 
         if (opcao == 's' || opcao == 'S') {
-            printf("\nVoce decidiu encerrar a exploracao.\n");
+            TELA_FIXO(&tela, "\nVoce decidiu encerrar a exploracao.\n");
             break;
-        } else if ((opcao == 'e' || opcao == 'E') && atual->esq != NULL) {
-            atual = atual->esq;
-        } else if ((opcao == 'd' || opcao == 'D') && atual->dir != NULL) {
-            atual = atual->dir;
+        } else if ((opcao == 'e' || opcao == 'E') && esq != SEM_SALA) {
+            atual = esq;
+        } else if ((opcao == 'd' || opcao == 'D') && dir != SEM_SALA) {
+            atual = dir;
         } else {
-            printf("Opcao invalida ou caminho inexistente. Tente novamente.\n");
+            TELA_FIXO(&tela, "Opcao invalida ou caminho inexistente. Tente novamente.\n");
         }
     }
+    descarregarTela(&tela);
 }
 
 // -------------------------------------------------------
-// Função auxiliar recursiva: conta pistas por suspeito
-// Percorre a BST de pistas e usa a hash para ver a quem
-// cada pista aponta, somando contagens
+// Função: renderizarPistasDoSuspeito
+// Lista as pistas que apontam para o suspeito, direto do
+// índice invertido (sem percorrer as demais pistas)
 // -------------------------------------------------------
-void contarPistasPorSuspeitoRec(PistaNode *raiz, HashEntry tabelaHash[],
-                                const char *suspeitoAlvo, int *contador) {
-    if (raiz == NULL) return;
-
-    contarPistasPorSuspeitoRec(raiz->esq, tabelaHash, suspeitoAlvo, contador);
+void renderizarPistasDoSuspeito(Tela *tela, const TabelaHash *tabelaHash, const char *suspeito) {
+    unsigned int quantidade;
+    const HandleTexto *lista = pistasDoSuspeito(tabelaHash, buscarTexto(suspeito), &quantidade);
 
-    const char *sus = encontrarSuspeito(tabelaHash, raiz->pista);
-    if (sus != NULL && strcmp(sus, suspeitoAlvo) == 0) {
-        (*contador)++;
+    for (unsigned int i = 0; i < quantidade; i++) {
+        TELA_FIXO(tela, "- ");
+        telaTexto(tela, lista[i]);
+        TELA_FIXO(tela, "\n");
     }
-
-    contarPistasPorSuspeitoRec(raiz->dir, tabelaHash, suspeitoAlvo, contador);
 }
 
 // -------------------------------------------------------
 // Função: verificarSuspeitoFinal
-// Pede ao jogador o nome do suspeito acusado e verifica
-// quantas pistas na BST apontam para ele via hash
+// Pede ao jogador o nome do suspeito acusado, verifica
+// quantas pistas coletadas apontam para ele. Com 'detalhes'
+// (--detalhes), lista também as pistas contra o acusado e
+// mostra o suspeito mais citado.
 // -------------------------------------------------------
-void verificarSuspeitoFinal(PistaNode *raizPistas, HashEntry tabelaHash[]) {
+void verificarSuspeitoFinal(ArvorePistas *pistas, TabelaHash *tabelaHash, int detalhes) {
     char acusacao[TAM_SUSPEITO];
     int contador = 0;
+    Tela tela;
 
-    printf("\n===== Fase Final: Julgamento =====\n");
+    ESTAT_INICIO(julgamento);
+    iniciarTela(&tela);
+    TELA_FIXO(&tela, "\n===== Fase Final: Julgamento =====\n");
 
-    if (raizPistas == NULL) {
-        printf("Nenhuma pista foi coletada. Nao ha base para acusar ninguem.\n");
+    if (pistas->quantidade == 0) {
+        TELA_FIXO(&tela, "Nenhuma pista foi coletada. Nao ha base para acusar ninguem.\n");
+        descarregarTela(&tela);
         return;
     }
 
-    printf("Pistas coletadas (em ordem alfabetica):\n");
-    exibirPistas(raizPistas);
+    TELA_FIXO(&tela, "Pistas coletadas (em ordem alfabetica):\n");
+    renderizarPistas(&tela, pistas);
 
-    printf("\nDigite o nome do suspeito que voce deseja acusar: ");
+    TELA_FIXO(&tela, "\nDigite o nome do suspeito que voce deseja acusar: ");
+    mostrarTela(&tela);
+    ESTAT_PAUSAR(julgamento);
     // ler até a quebra de linha; primeiro consome '\n' pendente
     getchar();
     fgets(acusacao, TAM_SUSPEITO, stdin);
+    ESTAT_RETOMAR(julgamento);
     // remover '\n'
     size_t len = strlen(acusacao);
     if (len > 0 && acusacao[len - 1] == '\n') {
-        acusacao[len - 1] = '\0';
+        acusacao[--len] = '\0';
     }
 
     if (acusacao[0] == '\0') {
-        printf("Nome de suspeito vazio. Encerrando julgamento.\n");
+        TELA_FIXO(&tela, "Nome de suspeito vazio. Encerrando julgamento.\n");
+        descarregarTela(&tela);
         return;
     }
 
-    // Conta quantas pistas da BST apontam para esse suspeito
-    contarPistasPorSuspeitoRec(raizPistas, tabelaHash, acusacao, &contador);
-
-    printf("\nTotal de pistas que apontam para '%s': %d\n", acusacao, contador);
+    // Conta quantas pistas coletadas apontam para esse suspeito
+    contador = contarPistasPorSuspeito(tabelaHash, acusacao);
+
+    // 'acusacao' vive até o fim da função: entra por referência
+    TELA_FIXO(&tela, "\nTotal de pistas que apontam para '");
+    telaParte(&tela, acusacao, len);
+    TELA_FIXO(&tela, "': ");
+    telaInteiro(&tela, contador);
+    TELA_FIXO(&tela, "\n");
+    if (detalhes) {
+        renderizarPistasDoSuspeito(&tela, tabelaHash, acusacao);
+    }
 
     if (contador >= 2) {
-        printf("Veredito: ACUSACAO SUSTENTADA! Ha evidencias suficientes contra %s.\n",
-               acusacao);
+        TELA_FIXO(&tela, "Veredito: ACUSACAO SUSTENTADA! Ha evidencias suficientes contra ");
+        telaParte(&tela, acusacao, len);
+        TELA_FIXO(&tela, ".\n");
     } else if (contador == 1) {
-        printf("Veredito: DUVIDOSO. Apenas 1 pista aponta para %s. Investigacao inconclusiva.\n",
-               acusacao);
+        TELA_FIXO(&tela, "Veredito: DUVIDOSO. Apenas 1 pista aponta para ");
+        telaParte(&tela, acusacao, len);
+        TELA_FIXO(&tela, ". Investigacao inconclusiva.\n");
     } else {
-        printf("Veredito: INOCENTE (por falta de provas). Nenhuma pista aponta claramente para %s.\n",
-               acusacao);
+        TELA_FIXO(&tela, "Veredito: INOCENTE (por falta de provas). Nenhuma pista aponta claramente para ");
+        telaParte(&tela, acusacao, len);
+        TELA_FIXO(&tela, ".\n");
+    }
+
+    // Suspeito mais citado, direto do topo do heap do placar
+    int maisCitado;
+    HandleTexto provavel = suspeitoMaisProvavel(&tabelaHash->placar, &maisCitado);
+    if (detalhes && provavel != TEXTO_INEXISTENTE) {
+        TELA_FIXO(&tela, "Suspeito mais provavel segundo as pistas: ");
+        telaTexto(&tela, provavel);
+        TELA_FIXO(&tela, " (");
+        telaInteiro(&tela, maisCitado);
+        if (maisCitado == 1) {
+            TELA_FIXO(&tela, " pista)\n");
+        } else {
+            TELA_FIXO(&tela, " pistas)\n");
+        }
     }
+    descarregarTela(&tela);
+    ESTAT_FIM(JULGAMENTO, julgamento);
 }
 
 // -------------------------------------------------------
-// Liberação de memória
-// -------------------------------------------------------
-void liberarArvoreSalas(Sala *raiz) {
-    if (raiz == NULL) return;
-    liberarArvoreSalas(raiz->esq);
-    liberarArvoreSalas(raiz->dir);
-    free(raiz);
+// Função: consultarPistas
+// Modos --intervalo e --prefixo: as pistas de todas as
+// salas entram na árvore B+ num lote, e a consulta desce
+// até a primeira pista do resultado e segue pelas folhas.
+// Com 'prefixo' NULL, lista [inicio, fim) (fim NULL = até a
+// última pista).
+// -------------------------------------------------------
+int consultarPistas(const Mansao *mansao, Arena *arena, const char *inicio, const char *fim,
+                    const char *prefixo) {
+    HandleTexto *todas = (HandleTexto *)realocarOuSair(NULL, (mansao->quantidade + 1) * sizeof(HandleTexto));
+    size_t numPistas = 0;
+    ArvorePistas pistas;
+    CursorPistas cursor;
+    Tela tela;
+
+    for (unsigned int i = 0; i < mansao->quantidade; i++) {
+        HandleTexto pista = pistaSala(mansao, (int)i);
+        if (pista != TEXTO_VAZIO) {
+            todas[numPistas++] = pista;
+        }
+    }
+    inicializarPistas(&pistas, arena);
+    inserirPistasEmLote(&pistas, todas, numPistas);
+    free(todas);
+
+    iniciarTela(&tela);
+    if (prefixo != NULL) {
+        posicionarPrefixo(&pistas, prefixo, &cursor);
+        TELA_FIXO(&tela, "Pistas que comecam com \"");
+        telaParte(&tela, prefixo, strlen(prefixo));
+        TELA_FIXO(&tela, "\":\n");
+    } else {
+        posicionarIntervalo(&pistas, inicio, fim, &cursor);
+        TELA_FIXO(&tela, "Pistas a partir de \"");
+        telaParte(&tela, inicio, strlen(inicio));
+        if (fim != NULL) {
+            TELA_FIXO(&tela, "\" e antes de \"");
+            telaParte(&tela, fim, strlen(fim));
+        }
+        TELA_FIXO(&tela, "\":\n");
+    }
+    int quantidade = renderizarCursor(&tela, &cursor);
+    telaInteiro(&tela, quantidade);
+    TELA_FIXO(&tela, " de ");
+    telaInteiro(&tela, pistas.quantidade);
+    TELA_FIXO(&tela, " pista(s).\n");
+    descarregarTela(&tela);
+    return 1;
 }
 
-void liberarArvorePistas(PistaNode *raiz) {
-    if (raiz == NULL) return;
-    liberarArvorePistas(raiz->esq);
-    liberarArvorePistas(raiz->dir);
-    free(raiz);
+void mostrarUso(const char *programa) {
+    printf("Uso: %s                              (mansao padrao)\n", programa);
+    printf("     %s --mansao <arquivo>           (mansao em texto ou binaria)\n", programa);
+    printf("     %s --converter <entrada> <saida> (texto <-> binario)\n", programa);
+    printf("     %s --exportar <saida>           (mansao padrao em texto)\n", programa);
+    printf("     %s --gerar-tabelas <saida.h>    (imagem da mansao padrao para compilar junto)\n", programa);
+    printf("     %s [--mansao <arquivo>] --lote <roteiro> [--threads <n>]\n", programa);
+    printf("        (sessoes sem interacao; n = 0 usa um trabalhador por nucleo)\n");
+    printf("     %s --histograma <corpus>        (sondagem das funcoes de hash)\n", programa);
+    printf("     %s --benchmark <saida.json> [max]  (mansoes geradas de 10^3 a max salas)\n", programa);
+    printf("     %s [--mansao <arquivo>] --buscar <pista> (pistas parecidas)\n", programa);
+    printf("     %s [--mansao <arquivo>] --caminho <pista|suspeito> (movimentos desde o Hall)\n", programa);
+    printf("     %s [--mansao <arquivo>] --prefixo <texto> (pistas com o prefixo, em ordem)\n", programa);
+    printf("     %s [--mansao <arquivo>] --intervalo <inicio> <fim> (pistas em [inicio, fim); fim \"\" = sem fim)\n",
+           programa);
+    printf("     %s [--mansao <arquivo>] --sessao <base> (retoma e grava base.diario/base.retrato)\n", programa);
+    printf("     %s [--mansao <arquivo>] [--sessao <base>] --detalhes (julgamento com pistas e mais citado)\n", programa);
+    printf("     ... --estatisticas <saida.json>  (qualquer modo; exige -DESTATISTICAS; SIGUSR1 grava na hora)\n");
 }
 
 // -------------------------------------------------------
-// main - monta a mansão, executa a exploração e o julgamento
-// -------------------------------------------------------
-int main() {
-    // Suspeitos: você pode mudar os nomes se quiser
-    const char *MORDOMO    = "Mordomo";
-    const char *COZINHEIRA = "Cozinheira";
-    const char *JARDINEIRO = "Jardineiro";
-
-    // Montagem manual da mansão
-    Sala *hallEntrada = criarSala(
-        "Hall de Entrada",
-        "Luvas manchadas deixadas perto do cabideiro",
-        MORDOMO
-    );
-
-    Sala *salaEstar = criarSala(
-        "Sala de Estar",
-        "Pegadas de sapato engraxado no tapete caro",
-        MORDOMO
-    );
-
-    Sala *cozinha = criarSala(
-        "Cozinha",
-        "Faca suja escondida atras da pia",
-        COZINHEIRA
-    );
-
-    Sala *biblioteca = criarSala(
-        "Biblioteca",
-        "Livro de receitas com paginas rasgadas",
-        COZINHEIRA
-    );
-
-    Sala *salaMusica = criarSala(
-        "Sala de Musica",
-        "Partitura com anotacoes sobre o horario do crime",
-        MORDOMO
-    );
-
-    Sala *despensa = criarSala(
-        "Despensa",
-        "Caixa de ferramentas aberta e poeira remexida",
-        JARDINEIRO
-    );
-
-    Sala *jardim = criarSala(
-        "Jardim",
-        "Pegadas na terra molhada perto da estufa",
-        JARDINEIRO
-    );
-
-    // Ligações da árvore da mansão
-    hallEntrada->esq = salaEstar;
-    hallEntrada->dir = cozinha;
-
-    salaEstar->esq  = biblioteca;
-    salaEstar->dir  = salaMusica;
-
-    cozinha->esq    = despensa;
-    cozinha->dir    = jardim;
-
-    // Raiz da BST de pistas
-    PistaNode *raizPistas = NULL;
+// main - monta (ou carrega) a mansão, executa a exploração
+// e o julgamento
+// -------------------------------------------------------
+int main(int argc, char *argv[]) {
+    Mansao mansao;
+
+    // --estatisticas vale para qualquer modo: sai da lista de
+    // argumentos antes dos demais testes
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--estatisticas") == 0) {
+#ifdef ESTATISTICAS
+            ativarEstatisticas(argv[i + 1]);
+#else
+            printf("Estatisticas indisponiveis: compile com -DESTATISTICAS.\n");
+            return 1;
+#endif
+            memmove(&argv[i], &argv[i + 2], (size_t)(argc - i - 1) * sizeof(char *));
+            argc -= 2;
+            break;
+        }
+    }
+
+    if (argc == 4 && strcmp(argv[1], "--converter") == 0) {
+        return converterMansao(argv[2], argv[3]) ? 0 : 1;
+    }
+    if (argc == 3 && strcmp(argv[1], "--gerar-tabelas") == 0) {
+        return gerarTabelasMansao(argv[2]) ? 0 : 1;
+    }
+    if (argc == 3 && strcmp(argv[1], "--histograma") == 0) {
+        int ok = histogramaSondagem(argv[2]);
+        liberarPoolTextos();
+        return ok ? 0 : 1;
+    }
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--benchmark") == 0) {
+        long maxSalas = (argc == 4) ? atol(argv[3]) : 1000000;
+        if (maxSalas < 1000 || maxSalas > 100000000) {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+        return executarBenchmark(argv[2], (unsigned int)maxSalas) ? 0 : 1;
+    }
+
+    // Arena da investigação: salas e nós de pistas
+    Arena arena;
+    inicializarArena(&arena);
+
+    if (argc == 3 && strcmp(argv[1], "--exportar") == 0) {
+        montarMansaoPadrao(&arena, &mansao);
+        int ok = salvarMansaoTexto(&mansao, argv[2]);
+        liberarArena(&arena);
+        liberarPoolTextos();
+        liberarMansao(&mansao);
+        return ok ? 0 : 1;
+    }
+
+    // Opções do jogo: --mansao, --lote e --threads (só com --lote)
+    // e --detalhes (só no jogo interativo)
+    const char *arquivoMansao = NULL;
+    const char *roteiro = NULL;
+    const char *consulta = NULL;
+    const char *procurado = NULL;
+    const char *prefixo = NULL;
+    const char *inicio = NULL;
+    const char *fim = NULL;
+    const char *baseSessao = NULL;
+    int threads = 0;
+    int detalhes = 0;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--mansao") == 0) {
+            arquivoMansao = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--lote") == 0) {
+            roteiro = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--sessao") == 0) {
+            baseSessao = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--caminho") == 0) {
+            procurado = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--buscar") == 0) {
+            consulta = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--prefixo") == 0) {
+            prefixo = argv[++i];
+        } else if (i + 2 < argc && strcmp(argv[i], "--intervalo") == 0) {
+            inicio = argv[++i];
+            fim = (argv[i + 1][0] != '\0') ? argv[i + 1] : NULL;
+            i++;
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--detalhes") == 0) {
+            detalhes = 1;
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    int consultaPistas = (prefixo != NULL) + (inicio != NULL);
+    if (threads < 0 || (threads > 0 && roteiro == NULL) || (consulta != NULL && roteiro != NULL) ||
+        (baseSessao != NULL && (roteiro != NULL || consulta != NULL)) ||
+        (procurado != NULL && (roteiro != NULL || consulta != NULL || baseSessao != NULL)) ||
+        (detalhes && (roteiro != NULL || consulta != NULL || procurado != NULL)) ||
+        consultaPistas > 1 || (consultaPistas && (roteiro != NULL || consulta != NULL ||
+                                                  procurado != NULL || baseSessao != NULL || detalhes))) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+
+    if (arquivoMansao != NULL) {
+        if (!carregarMansao(arquivoMansao, &mansao)) {
+            return 1;
+        }
+    } else {
+        montarMansaoPadrao(&arena, &mansao);
+    }
+
+    if (consulta != NULL) {
+        int ok = buscarPistaAproximada(&mansao, consulta);
+        liberarArena(&arena);
+        liberarPoolTextos();
+        liberarMansao(&mansao);
+        return ok ? 0 : 1;
+    }
+
+    if (procurado != NULL) {
+        int ok = mostrarCaminho(&mansao, procurado);
+        liberarArena(&arena);
+        liberarPoolTextos();
+        liberarMansao(&mansao);
+        return ok ? 0 : 1;
+    }
+
+    if (consultaPistas) {
+        int ok = consultarPistas(&mansao, &arena, inicio, fim, prefixo);
+        liberarArena(&arena);
+        liberarPoolTextos();
+        liberarMansao(&mansao);
+        return ok ? 0 : 1;
+    }
+
+    // Mansões que já estão no heap passam para a forma implícita
+    // quando ela compensa; as mapeadas são usadas como estão
+    if (mansao.mapa == NULL) {
+        tornarMansaoImplicita(&mansao);
+    }
+
+    if (roteiro != NULL) {
+        int ok = executarLote(&mansao, roteiro, threads);
+        liberarArena(&arena);
+        liberarPoolTextos();
+        liberarMansao(&mansao);
+        return ok ? 0 : 1;
+    }
+
+    // Árvore B+ de pistas coletadas
+    ArvorePistas pistas;
+    inicializarPistas(&pistas, &arena);
 
     // Tabela hash para associar pista -> suspeito
-    HashEntry tabelaHash[TAM_TABELA_HASH];
-    inicializarHash(tabelaHash);
+    TabelaHash tabelaHash;
+    inicializarHash(&tabelaHash);
+
+    // Sessão persistente: retoma as pistas já coletadas
+    SessaoPersistente sessao;
+    if (baseSessao != NULL && !abrirSessao(&sessao, baseSessao, &pistas, &tabelaHash)) {
+        fecharSessao(&sessao, &pistas, &tabelaHash);
+        liberarHash(&tabelaHash);
+        liberarArena(&arena);
+        liberarPoolTextos();
+        liberarMansao(&mansao);
+        return 1;
+    }
 
     // Exploração da mansão com coleta de pistas e hash
-    explorarSalas(hallEntrada, &raizPistas, tabelaHash);
+    explorarSalas(&mansao, &pistas, &tabelaHash, (baseSessao != NULL) ? &sessao : NULL);
 
     // Julgamento final
-    verificarSuspeitoFinal(raizPistas, tabelaHash);
+    verificarSuspeitoFinal(&pistas, &tabelaHash, detalhes);
+
+    if (baseSessao != NULL) {
+        fecharSessao(&sessao, &pistas, &tabelaHash);
+    }
 
-    // Liberação de memória
-    liberarArvoreSalas(hallEntrada);
-    liberarArvorePistas(raizPistas);
+    // Liberação de memória: a arena devolve salas e pistas de uma vez
+    liberarHash(&tabelaHash);
+    liberarArena(&arena);
+    liberarPoolTextos();
+    liberarMansao(&mansao);
 
     return 0;
 }
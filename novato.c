@@ -1,6 +1,4 @@
 #include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
 
 #define TAM_NOME 50
 
@@ -8,29 +6,36 @@
 // Struct Sala - nó da árvore binária
 // -------------------------------------------------------
 typedef struct Sala {
-    char nome[TAM_NOME];     // Nome do cômodo
-    struct Sala *esq;        // Ponteiro para a sala à esquerda
-    struct Sala *dir;        // Ponteiro para a sala à direita
+    char nome[TAM_NOME];            // Nome do cômodo
+    const struct Sala *esq;         // Ponteiro para a sala à esquerda
+    const struct Sala *dir;         // Ponteiro para a sala à direita
 } Sala;
 
 // -------------------------------------------------------
-// Função: criarSala
-// Cria dinamicamente uma sala com o nome informado
+// Mapa da mansão, em forma declarativa. Cada linha é uma
+// sala: identificador, nome e os caminhos à esquerda e à
+// direita (PARA(sala) ou NULL). A lista vira um vetor
+// constante montado pelo compilador: nada é alocado nem
+// copiado quando o jogo começa.
 // -------------------------------------------------------
-Sala* criarSala(const char *nome) {
-    Sala *nova = (Sala *)malloc(sizeof(Sala));
-    if (nova == NULL) {
-        printf("Erro ao alocar memoria para a sala '%s'.\n", nome);
-        exit(1);
-    }
-
-    strncpy(nova->nome, nome, TAM_NOME);
-    nova->nome[TAM_NOME - 1] = '\0';  // garantir fim de string
-    nova->esq = NULL;
-    nova->dir = NULL;
-
-    return nova;
-}
+#define SALAS_MANSAO(SALA)                                                    \
+    SALA(HALL_ENTRADA, "Hall de Entrada", PARA(SALA_ESTAR), PARA(COZINHA))    \
+    SALA(SALA_ESTAR,   "Sala de Estar",   PARA(BIBLIOTECA), PARA(SALA_MUSICA)) \
+    SALA(COZINHA,      "Cozinha",         PARA(DESPENSA),   PARA(JARDIM))      \
+    SALA(BIBLIOTECA,   "Biblioteca",      NULL,             NULL)              \
+    SALA(SALA_MUSICA,  "Sala de Musica",  NULL,             NULL)              \
+    SALA(DESPENSA,     "Despensa",        NULL,             NULL)              \
+    SALA(JARDIM,       "Jardim",          NULL,             NULL)
+
+#define ID_SALA(id, nome, esq, dir) id,
+enum { SALAS_MANSAO(ID_SALA) NUM_SALAS };
+#undef ID_SALA
+
+#define PARA(id) (&mansao[id])
+#define DADOS_SALA(id, nome, esq, dir) { nome, esq, dir },
+static const Sala mansao[NUM_SALAS] = { SALAS_MANSAO(DADOS_SALA) };
+#undef DADOS_SALA
+#undef PARA
 
 // -------------------------------------------------------
 // Função: explorarSalas
@@ -39,8 +44,8 @@ Sala* criarSala(const char *nome) {
 // direita (d) ou sair (s).
 // A exploração termina se o jogador chegar a um nó-folha.
 // -------------------------------------------------------
-void explorarSalas(Sala *raiz) {
-    Sala *atual = raiz;
+void explorarSalas(const Sala *raiz) {
+    const Sala *atual = raiz;
     char opcao;
 
     if (atual == NULL) {
@@ -85,52 +90,12 @@ void explorarSalas(Sala *raiz) {
     }
 }
 
-// -------------------------------------------------------
-// Função auxiliar: liberarArvore
-// Libera toda a memória da árvore binária (pós-ordem).
-// -------------------------------------------------------
-void liberarArvore(Sala *raiz) {
-    if (raiz == NULL) return;
-    liberarArvore(raiz->esq);
-    liberarArvore(raiz->dir);
-    free(raiz);
-}
-
 // -------------------------------------------------------
 // Função: main
-// Monta a árvore da mansão manualmente e inicia a exploração
+// Inicia a exploração a partir do Hall de Entrada
 // -------------------------------------------------------
 int main() {
-    // Criação manual da estrutura da mansão (árvore binária)
-    // Raiz
-    Sala *hallEntrada   = criarSala("Hall de Entrada");
-
-    // Nível 1
-    Sala *salaEstar     = criarSala("Sala de Estar");
-    Sala *cozinha       = criarSala("Cozinha");
-
-    hallEntrada->esq = salaEstar;
-    hallEntrada->dir = cozinha;
-
-    // Nível 2 (filhos da Sala de Estar)
-    Sala *biblioteca    = criarSala("Biblioteca");
-    Sala *salaMusica    = criarSala("Sala de Musica");
-
-    salaEstar->esq = biblioteca;
-    salaEstar->dir = salaMusica;
-
-    // Nível 2 (filhos da Cozinha)
-    Sala *despensa      = criarSala("Despensa");
-    Sala *jardim        = criarSala("Jardim");
-
-    cozinha->esq = despensa;
-    cozinha->dir = jardim;
-
-    // Inicia a exploração a partir do Hall de Entrada
-    explorarSalas(hallEntrada);
-
-    // Libera memória ao final
-    liberarArvore(hallEntrada);
+    explorarSalas(&mansao[HALL_ENTRADA]);
 
     return 0;
 }
@@ -0,0 +1,401 @@
+#include "aproximada.h"
+
+// -------------------------------------------------------
+// Busca aproximada de pistas
+// Um índice invertido de trigramas (três caracteres
+// seguidos, sem diferença de maiúsculas) escolhe poucas
+// candidatas; a distância de edição exata só é calculada
+// para elas, com o algoritmo de vetores de bits de Myers.
+// -------------------------------------------------------
+
+// Código do caractere no alfabeto dos trigramas: 0 = espaço
+// e pontuação, 1-26 letras, 27-36 dígitos, 37 = byte não ASCII
+int codigoTrigrama(unsigned char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 1;
+    if (c >= 'a' && c <= 'z') return c - 'a' + 1;
+    if (c >= '0' && c <= '9') return c - '0' + 27;
+    return (c >= 128) ? 37 : 0;
+}
+
+// Trigramas distintos do texto (com um espaço antes e um
+// depois), em ordem crescente; devolve quantos são
+int trigramasDoTexto(const char *texto, size_t tamanho, unsigned int *codigos) {
+    int n = 0;
+    int a = 0, b = 0;
+
+    if (tamanho > TAM_PISTA - 1) {
+        tamanho = TAM_PISTA - 1;
+    }
+    for (size_t i = 0; i <= tamanho; i++) {
+        int c = (i < tamanho) ? codigoTrigrama((unsigned char)texto[i]) : 0;
+        if (i >= 1) {
+            unsigned int codigo = ((unsigned int)a * ALFABETO_TRIGRAMA + b) * ALFABETO_TRIGRAMA + c;
+            // Inserção ordenada sem repetidos (no máximo TAM_PISTA códigos)
+            int j = n;
+            while (j > 0 && codigos[j - 1] > codigo) j--;
+            if (j == 0 || codigos[j - 1] != codigo) {
+                memmove(&codigos[j + 1], &codigos[j], (n - j) * sizeof(unsigned int));
+                codigos[j] = codigo;
+                n++;
+            }
+        }
+        a = b;
+        b = c;
+    }
+    return n;
+}
+
+void inicializarTrigramas(IndiceTrigramas *indice) {
+    indice->listas = (ListaTrigrama *)calloc(NUM_TRIGRAMAS, sizeof(ListaTrigrama));
+    if (indice->listas == NULL) {
+        printf("Erro ao alocar memoria para o indice de trigramas.\n");
+        exit(1);
+    }
+    indice->numTrigramas = NULL;
+    indice->contagem = NULL;
+    indice->tocadas = NULL;
+    indice->numTocadas = 0;
+    indice->capTocadas = 0;
+    indice->capHandles = 0;
+    indice->consulta = 0;
+    indice->quantidade = 0;
+}
+
+void liberarTrigramas(IndiceTrigramas *indice) {
+    for (int t = 0; t < NUM_TRIGRAMAS; t++) {
+        free(indice->listas[t].pistas);
+    }
+    free(indice->listas);
+    free(indice->numTrigramas);
+    free(indice->contagem);
+    free(indice->tocadas);
+    indice->listas = NULL;
+    indice->numTrigramas = NULL;
+    indice->contagem = NULL;
+    indice->tocadas = NULL;
+    indice->capTocadas = 0;
+    indice->capHandles = 0;
+    indice->quantidade = 0;
+}
+
+// -------------------------------------------------------
+// Função: indexarTrigramas
+// Acrescenta a pista às listas dos seus trigramas. Retorna
+// 1 se ela ainda não estava no índice.
+// -------------------------------------------------------
+int indexarTrigramas(IndiceTrigramas *indice, HandleTexto pista) {
+    unsigned int codigos[TAM_PISTA];
+
+    if (pista == TEXTO_VAZIO || pista == TEXTO_INEXISTENTE) return 0;
+
+    if (pista >= indice->capHandles) {
+        unsigned int novaCap = (indice->capHandles == 0) ? 1024 : indice->capHandles;
+        while (novaCap <= pista) {
+            novaCap *= 2;
+        }
+        indice->numTrigramas = (unsigned char *)realocarOuSair(indice->numTrigramas, novaCap);
+        indice->contagem = (unsigned int *)realocarOuSair(indice->contagem,
+                                                          novaCap * sizeof(unsigned int));
+        memset(indice->numTrigramas + indice->capHandles, 0, novaCap - indice->capHandles);
+        memset(indice->contagem + indice->capHandles, 0,
+               (novaCap - indice->capHandles) * sizeof(unsigned int));
+        indice->capHandles = novaCap;
+    }
+    if (indice->numTrigramas[pista] != 0) {
+        return 0; // já indexada
+    }
+
+    const char *texto = textoDe(pista);
+    int n = trigramasDoTexto(texto, strlen(texto), codigos);
+    for (int k = 0; k < n; k++) {
+        ListaTrigrama *lista = &indice->listas[codigos[k]];
+        if (lista->quantidade == lista->capacidade) {
+            lista->capacidade = (lista->capacidade == 0) ? 4 : lista->capacidade * 2;
+            lista->pistas = (HandleTexto *)realocarOuSair(lista->pistas,
+                                lista->capacidade * sizeof(HandleTexto));
+        }
+        lista->pistas[lista->quantidade++] = pista;
+    }
+    indice->numTrigramas[pista] = (unsigned char)n;
+    indice->quantidade++;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Distância de edição (Levenshtein) por vetores de bits
+// O padrão vira máscaras de 64 bits por caractere (em até
+// BLOCOS_MYERS blocos) e cada caractere do outro texto
+// atualiza uma coluna inteira da tabela de programação
+// dinâmica com poucas operações por bloco.
+// -------------------------------------------------------
+unsigned char dobrarCaixa(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+void prepararPadraoMyers(PadraoMyers *padrao, const char *texto, size_t tamanho) {
+    if (tamanho > 64 * BLOCOS_MYERS) {
+        tamanho = 64 * BLOCOS_MYERS;
+    }
+    padrao->tamanho = (int)tamanho;
+    padrao->blocos = (int)((tamanho + 63) / 64);
+    memset(padrao->peq, 0, sizeof(padrao->peq));
+    for (size_t i = 0; i < tamanho; i++) {
+        padrao->peq[dobrarCaixa((unsigned char)texto[i])][i / 64] |= 1ull << (i % 64);
+    }
+}
+
+int distanciaMyers(const PadraoMyers *padrao, const char *texto, size_t tamanho) {
+    unsigned long long pv[BLOCOS_MYERS], mv[BLOCOS_MYERS];
+    int m = padrao->tamanho;
+    int ultimo = padrao->blocos - 1;
+    unsigned long long bitFinal;
+    int distancia = m;
+
+    if (m == 0) {
+        return (int)tamanho;
+    }
+    bitFinal = 1ull << ((m - 1) % 64);
+    for (int b = 0; b < padrao->blocos; b++) {
+        pv[b] = ~0ull;
+        mv[b] = 0;
+    }
+
+    for (size_t j = 0; j < tamanho; j++) {
+        const unsigned long long *eqs = padrao->peq[dobrarCaixa((unsigned char)texto[j])];
+        int hin = 1; // a linha 0 cresce 1 a cada coluna (distância global)
+
+        for (int b = 0; b <= ultimo; b++) {
+            unsigned long long eq = eqs[b];
+            unsigned long long xv = eq | mv[b];
+            if (hin < 0) eq |= 1;
+            unsigned long long xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            unsigned long long ph = mv[b] | ~(xh | pv[b]);
+            unsigned long long mh = pv[b] & xh;
+            unsigned long long alto = (b == ultimo) ? bitFinal : (1ull << 63);
+            int hout = (ph & alto) ? 1 : (mh & alto) ? -1 : 0;
+
+            ph <<= 1;
+            mh <<= 1;
+            if (hin < 0) {
+                mh |= 1;
+            } else if (hin > 0) {
+                ph |= 1;
+            }
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+            hin = hout;
+        }
+        distancia += hin;
+    }
+    return distancia;
+}
+
+// -------------------------------------------------------
+// Função: buscarPistasParecidas
+// 1. Lê as listas dos trigramas da consulta, da mais curta
+//    para a mais longa, contando trigramas em comum por
+//    pista, até ORCAMENTO_TRIGRAMAS entradas lidas (os
+//    trigramas muito comuns quase não distinguem nada).
+// 2. Entre as pistas vistas, guarda as CANDIDATOS_FUZZY com
+//    mais trigramas em comum.
+// 3. Calcula a distância de edição delas e devolve até
+//    'max' resultados, da menor distância para a maior.
+// -------------------------------------------------------
+unsigned int buscarPistasParecidas(IndiceTrigramas *indice, const char *consulta,
+                                   ResultadoAproximado *saida, unsigned int max) {
+    unsigned int codigos[TAM_PISTA];
+    HandleTexto candidatas[CANDIDATOS_FUZZY];
+    unsigned int numCandidatas = 0;
+    size_t tamanho = strlen(consulta);
+    int n = trigramasDoTexto(consulta, tamanho, codigos);
+
+    if (indice->quantidade == 0 || n == 0) return 0;
+
+    // Listas mais curtas primeiro
+    for (int i = 1; i < n; i++) {
+        unsigned int codigo = codigos[i];
+        int j = i;
+        while (j > 0 && indice->listas[codigos[j - 1]].quantidade > indice->listas[codigo].quantidade) {
+            codigos[j] = codigos[j - 1];
+            j--;
+        }
+        codigos[j] = codigo;
+    }
+
+    // Nova consulta: as contagens antigas deixam de valer
+    if (++indice->consulta == (1u << 24)) {
+        memset(indice->contagem, 0, indice->capHandles * sizeof(unsigned int));
+        indice->consulta = 1;
+    }
+    unsigned int base = indice->consulta << 8;
+
+    unsigned int lidas = 0;
+    indice->numTocadas = 0;
+    for (int k = 0; k < n && (k == 0 || lidas < ORCAMENTO_TRIGRAMAS); k++) {
+        const ListaTrigrama *lista = &indice->listas[codigos[k]];
+        lidas += lista->quantidade;
+        for (unsigned int p = 0; p < lista->quantidade; p++) {
+            HandleTexto h = lista->pistas[p];
+            unsigned int c = indice->contagem[h];
+            if ((c & ~0xFFu) != base) {
+                if (indice->numTocadas == indice->capTocadas) {
+                    indice->capTocadas = (indice->capTocadas == 0) ? 1024 : indice->capTocadas * 2;
+                    indice->tocadas = (HandleTexto *)realocarOuSair(indice->tocadas,
+                                          indice->capTocadas * sizeof(HandleTexto));
+                }
+                indice->tocadas[indice->numTocadas++] = h;
+                c = base;
+            }
+            indice->contagem[h] = c + 1;
+        }
+    }
+
+    // Heap de mínimo pelos trigramas em comum: a pior
+    // candidata fica no topo para ser trocada
+    unsigned char comuns[CANDIDATOS_FUZZY];
+    for (unsigned int t = 0; t < indice->numTocadas; t++) {
+        HandleTexto h = indice->tocadas[t];
+        unsigned char c = (unsigned char)indice->contagem[h];
+
+        if (numCandidatas < CANDIDATOS_FUZZY) {
+            unsigned int i = numCandidatas++;
+            while (i > 0 && comuns[(i - 1) / 2] > c) {
+                candidatas[i] = candidatas[(i - 1) / 2];
+                comuns[i] = comuns[(i - 1) / 2];
+                i = (i - 1) / 2;
+            }
+            candidatas[i] = h;
+            comuns[i] = c;
+        } else if (c > comuns[0]) {
+            unsigned int i = 0;
+            while (1) {
+                unsigned int menor = 2 * i + 1;
+                if (menor >= CANDIDATOS_FUZZY) break;
+                if (menor + 1 < CANDIDATOS_FUZZY && comuns[menor + 1] < comuns[menor]) {
+                    menor++;
+                }
+                if (comuns[menor] >= c) break;
+                candidatas[i] = candidatas[menor];
+                comuns[i] = comuns[menor];
+                i = menor;
+            }
+            candidatas[i] = h;
+            comuns[i] = c;
+        }
+    }
+
+    // Distância exata das candidatas; ordenação por inserção
+    // (poucas saídas)
+    PadraoMyers padrao;
+    unsigned int numSaida = 0;
+    prepararPadraoMyers(&padrao, consulta, tamanho);
+    for (unsigned int c = 0; c < numCandidatas; c++) {
+        const char *texto = textoDe(candidatas[c]);
+        ResultadoAproximado r;
+        r.pista = candidatas[c];
+        r.distancia = distanciaMyers(&padrao, texto, strlen(texto));
+
+        unsigned int i = (numSaida < max) ? numSaida++ : max;
+        while (i > 0 && (saida[i - 1].distancia > r.distancia ||
+                         (saida[i - 1].distancia == r.distancia && saida[i - 1].pista > r.pista))) {
+            if (i < max) saida[i] = saida[i - 1];
+            i--;
+        }
+        if (i < max) saida[i] = r;
+    }
+    return numSaida;
+}
+
+// -------------------------------------------------------
+// Função: encontrarSuspeitoAproximado
+// Como encontrarSuspeito, mas tolera pistas digitadas com
+// pequenas diferenças: sem correspondência exata, usa a
+// pista indexada mais parecida que tenha suspeito. Em
+// '*pistaEncontrada' fica a pista usada (ou TEXTO_INEXISTENTE).
+// Com 'estatico', as pistas do caso vêm do hash perfeito e a
+// tabela só guarda as acrescentadas depois.
+// -------------------------------------------------------
+const char* encontrarSuspeitoAproximado(const MapaPerfeito *estatico, TabelaHash *tabela,
+                                        IndiceTrigramas *indice, const char *pista,
+                                        HandleTexto *pistaEncontrada) {
+    ResultadoAproximado parecidas[8];
+
+    *pistaEncontrada = TEXTO_INEXISTENTE;
+    if (pista == NULL || pista[0] == '\0') return NULL;
+
+    HandleTexto exata = buscarTexto(pista);
+    HandleTexto suspeito = suspeitoDaPista(estatico, tabela, exata);
+
+    if (suspeito != TEXTO_INEXISTENTE) {
+        *pistaEncontrada = exata;
+        return textoDe(suspeito);
+    }
+
+    unsigned int n = buscarPistasParecidas(indice, pista, parecidas, 8);
+    for (unsigned int i = 0; i < n; i++) {
+        suspeito = suspeitoDaPista(estatico, tabela, parecidas[i].pista);
+        if (suspeito != TEXTO_INEXISTENTE) {
+            *pistaEncontrada = parecidas[i].pista;
+            return textoDe(suspeito);
+        }
+    }
+    return NULL;
+}
+
+// -------------------------------------------------------
+// Função: buscarPistaAproximada
+// Modo --buscar: indexa as pistas de todas as salas e lista
+// as mais parecidas com a consulta, com o suspeito de cada
+// uma. Espera a mansão na forma explícita.
+// -------------------------------------------------------
+int buscarPistaAproximada(const Mansao *mansao, const char *consulta) {
+    MapaPerfeito mapa;
+    TabelaHash tabela;
+    IndiceTrigramas indice;
+    ResultadoAproximado parecidas[10];
+    HandleTexto usada;
+    HandleTexto *pistas = (HandleTexto *)realocarOuSair(NULL, (mansao->quantidade + 1) * sizeof(HandleTexto));
+    HandleTexto *suspeitos = (HandleTexto *)realocarOuSair(NULL, (mansao->quantidade + 1) * sizeof(HandleTexto));
+    unsigned int numPistas = 0;
+
+    inicializarHash(&tabela);
+    inicializarTrigramas(&indice);
+    for (unsigned int i = 0; i < mansao->quantidade; i++) {
+        HandleTexto pista = pistaSala(mansao, (int)i);
+        HandleTexto suspeito = suspeitoSala(mansao, (int)i);
+        if (pista != TEXTO_VAZIO && suspeito != TEXTO_VAZIO) {
+            pistas[numPistas] = pista;
+            suspeitos[numPistas++] = suspeito;
+            indexarTrigramas(&indice, pista);
+        }
+    }
+    // As pistas da mansão são todas conhecidas: hash perfeito,
+    // com a tabela dinâmica só se ele não puder ser montado
+    if (!construirMapaPerfeito(&mapa, pistas, suspeitos, numPistas)) {
+        inserirNaHashEmLote(&tabela, pistas, suspeitos, numPistas);
+    }
+    free(pistas);
+    free(suspeitos);
+
+    double inicio = segundosAgora();
+    const char *suspeito = encontrarSuspeitoAproximado(&mapa, &tabela, &indice, consulta, &usada);
+    unsigned int n = buscarPistasParecidas(&indice, consulta, parecidas, 10);
+    double gasto = segundosAgora() - inicio;
+
+    if (suspeito != NULL) {
+        printf("Suspeito: %s (pela pista \"%s\")\n", suspeito, textoDe(usada));
+    } else {
+        printf("Nenhuma pista parecida com \"%s\".\n", consulta);
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        HandleTexto dono = suspeitoDaPista(&mapa, &tabela, parecidas[i].pista);
+        printf("  %3d  %s -> %s\n", parecidas[i].distancia, textoDe(parecidas[i].pista),
+               (dono != TEXTO_INEXISTENTE) ? textoDe(dono) : "?");
+    }
+    printf("(%u pistas indexadas, busca em %.3f ms)\n", indice.quantidade, gasto * 1e3);
+
+    liberarTrigramas(&indice);
+    liberarHash(&tabela);
+    liberarMapaPerfeito(&mapa);
+    return 1;
+}
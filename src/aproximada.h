@@ -0,0 +1,68 @@
+#ifndef APROXIMADA_H
+#define APROXIMADA_H
+
+#include "mansao.h"
+#include "hash.h"
+#include "perfeito.h"
+
+#define ALFABETO_TRIGRAMA   38           // espaço, 26 letras, 10 dígitos, não ASCII
+#define NUM_TRIGRAMAS       (ALFABETO_TRIGRAMA * ALFABETO_TRIGRAMA * ALFABETO_TRIGRAMA)
+#define ORCAMENTO_TRIGRAMAS 32768        // entradas de listas lidas por busca aproximada
+#define CANDIDATOS_FUZZY    128          // pistas que chegam à distância de edição
+#define BLOCOS_MYERS        ((TAM_PISTA + 63) / 64)
+
+// -------------------------------------------------------
+// Índice de trigramas para a busca aproximada de pistas:
+// uma lista de pistas por trigrama (vetor denso de
+// NUM_TRIGRAMAS listas) e, por handle, o número de trigramas
+// da pista e a contagem da consulta em andamento. A contagem
+// leva o número da consulta nos 24 bits altos, então uma
+// consulta nova não precisa zerar nada e cada pista lida
+// custa um único acesso à memória.
+// -------------------------------------------------------
+typedef struct ListaTrigrama {
+    HandleTexto *pistas;
+    unsigned int quantidade;
+    unsigned int capacidade;
+} ListaTrigrama;
+
+typedef struct IndiceTrigramas {
+    ListaTrigrama *listas;
+    unsigned char *numTrigramas;      // 0 = pista fora do índice
+    unsigned int *contagem;           // (consulta << 8) | trigramas em comum
+    HandleTexto *tocadas;             // pistas vistas na consulta em andamento
+    unsigned int numTocadas;
+    unsigned int capTocadas;
+    unsigned int capHandles;
+    unsigned int consulta;            // < 2^24
+    unsigned int quantidade;          // pistas indexadas
+} IndiceTrigramas;
+
+typedef struct ResultadoAproximado {
+    HandleTexto pista;
+    int distancia;                    // distância de edição até a consulta
+} ResultadoAproximado;
+
+// Padrão pré-processado para a distância de Myers
+typedef struct PadraoMyers {
+    unsigned long long peq[256][BLOCOS_MYERS];
+    int tamanho;
+    int blocos;
+} PadraoMyers;
+
+void inicializarTrigramas(IndiceTrigramas *indice);
+int indexarTrigramas(IndiceTrigramas *indice, HandleTexto pista);
+unsigned int buscarPistasParecidas(IndiceTrigramas *indice, const char *consulta,
+                                   ResultadoAproximado *saida, unsigned int max);
+void liberarTrigramas(IndiceTrigramas *indice);
+const char* encontrarSuspeitoAproximado(const MapaPerfeito *estatico, TabelaHash *tabela,
+                                        IndiceTrigramas *indice, const char *pista,
+                                        HandleTexto *pistaEncontrada);
+int buscarPistaAproximada(const Mansao *mansao, const char *consulta);
+
+// Também usados pelos programas de bench/
+unsigned char dobrarCaixa(unsigned char c);
+void prepararPadraoMyers(PadraoMyers *padrao, const char *texto, size_t tamanho);
+int distanciaMyers(const PadraoMyers *padrao, const char *texto, size_t tamanho);
+
+#endif
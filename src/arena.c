@@ -0,0 +1,73 @@
+#include "arena.h"
+#include "estatisticas.h"
+
+// -------------------------------------------------------
+// Funções da Arena
+// -------------------------------------------------------
+void inicializarArena(Arena *arena) {
+    arena->atual = NULL;
+    arena->proximoBloco = BLOCO_ARENA_MIN;
+    arena->blocos = 0;
+}
+
+// Cabeçalho do bloco arredondado para manter o alinhamento
+size_t cabecalhoBlocoArena(void) {
+    return (sizeof(BlocoArena) + ALINHAMENTO_ARENA - 1) & ~(size_t)(ALINHAMENTO_ARENA - 1);
+}
+
+// -------------------------------------------------------
+// Função: alocarArena
+// Reserva 'tamanho' bytes alinhados no bloco atual; se não
+// couber, pede um bloco novo (cada vez maior, até o limite)
+// -------------------------------------------------------
+void* alocarArena(Arena *arena, size_t tamanho) {
+    BlocoArena *bloco = arena->atual;
+    size_t inicio = 0;
+
+    tamanho = (tamanho + ALINHAMENTO_ARENA - 1) & ~(size_t)(ALINHAMENTO_ARENA - 1);
+    if (bloco != NULL) {
+        inicio = bloco->usado;
+    }
+
+    if (bloco == NULL || inicio + tamanho > bloco->capacidade) {
+        size_t capacidade = arena->proximoBloco;
+        if (capacidade < tamanho) {
+            capacidade = tamanho;
+        }
+
+        bloco = (BlocoArena *)malloc(cabecalhoBlocoArena() + capacidade);
+        if (bloco == NULL) {
+            printf("Erro ao alocar memoria para a arena.\n");
+            exit(1);
+        }
+        ESTAT_CONTAR(BLOCOS_ARENA, 1);
+        bloco->anterior = arena->atual;
+        bloco->usado = 0;
+        bloco->capacidade = capacidade;
+        arena->atual = bloco;
+        arena->blocos++;
+        if (arena->proximoBloco < BLOCO_ARENA_MAX) {
+            arena->proximoBloco *= 2;
+        }
+        inicio = 0;
+    }
+
+    ESTAT_CONTAR(BYTES_ARENA, tamanho);
+    bloco->usado = inicio + tamanho;
+    return (char *)bloco + cabecalhoBlocoArena() + inicio;
+}
+
+// -------------------------------------------------------
+// Função: liberarArena
+// Devolve todos os blocos; tudo que saiu da arena deixa de
+// ser válido
+// -------------------------------------------------------
+void liberarArena(Arena *arena) {
+    BlocoArena *bloco = arena->atual;
+    while (bloco != NULL) {
+        BlocoArena *anterior = bloco->anterior;
+        free(bloco);
+        bloco = anterior;
+    }
+    inicializarArena(arena);
+}
@@ -0,0 +1,33 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "comum.h"
+
+#define BLOCO_ARENA_MIN     (64 * 1024)        // primeiro bloco da arena
+#define BLOCO_ARENA_MAX     (4 * 1024 * 1024)  // blocos dobram até este tamanho
+#define ALINHAMENTO_ARENA   16
+
+// -------------------------------------------------------
+// Arena de memória de uma investigação
+// Salas, nós de pistas e textos saem de blocos grandes e
+// contíguos, alocados "empurrando" um ponteiro. Nada é
+// liberado individualmente: liberarArena devolve tudo de
+// uma vez, sem percorrer as árvores.
+// -------------------------------------------------------
+typedef struct BlocoArena {
+    struct BlocoArena *anterior;
+    size_t usado;
+    size_t capacidade;
+} BlocoArena;
+
+typedef struct Arena {
+    BlocoArena *atual;        // bloco em uso (os anteriores ficam encadeados)
+    size_t proximoBloco;      // tamanho do próximo bloco a pedir
+    unsigned long blocos;     // quantos malloc a arena já fez
+} Arena;
+
+void inicializarArena(Arena *arena);
+void* alocarArena(Arena *arena, size_t tamanho);
+void liberarArena(Arena *arena);
+
+#endif
@@ -0,0 +1,133 @@
+// fileno fica fora do C puro: pede as declarações POSIX
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "arquivos.h"
+#include "textos.h"
+
+#ifdef _WIN32
+#include <io.h>
+#endif
+
+unsigned long long alinhar8(unsigned long long valor) {
+    return (valor + 7) & ~7ULL;
+}
+
+// Grava 'tamanho' bytes e completa com zeros até 'ate'
+int gravarBloco(FILE *arquivo, const void *dados, size_t tamanho, unsigned long long ate) {
+    static const char zeros[8] = { 0 };
+
+    if (tamanho > 0 && fwrite(dados, 1, tamanho, arquivo) != tamanho) {
+        return 0;
+    }
+    long posicao = ftell(arquivo);
+    if (posicao < 0 || (unsigned long long)posicao > ate) {
+        return 0;
+    }
+    return fwrite(zeros, 1, (size_t)(ate - (unsigned long long)posicao), arquivo) ==
+           (size_t)(ate - (unsigned long long)posicao);
+}
+
+// -------------------------------------------------------
+// Mapeamento de arquivos: mmap onde existe; no Windows o
+// arquivo é lido inteiro para um buffer
+// -------------------------------------------------------
+void* mapearArquivo(const char *caminho, size_t *tamanho) {
+#ifdef SEM_MMAP
+    FILE *arquivo = fopen(caminho, "rb");
+    void *dados;
+    long tam;
+
+    if (arquivo == NULL) return NULL;
+    if (fseek(arquivo, 0, SEEK_END) != 0 || (tam = ftell(arquivo)) <= 0) {
+        fclose(arquivo);
+        return NULL;
+    }
+    rewind(arquivo);
+    dados = malloc((size_t)tam);
+    if (dados == NULL || fread(dados, 1, (size_t)tam, arquivo) != (size_t)tam) {
+        free(dados);
+        fclose(arquivo);
+        return NULL;
+    }
+    fclose(arquivo);
+    *tamanho = (size_t)tam;
+    return dados;
+#else
+    struct stat info;
+    void *dados;
+    int fd = open(caminho, O_RDONLY);
+
+    if (fd < 0) return NULL;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    dados = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (dados == MAP_FAILED) return NULL;
+    *tamanho = (size_t)info.st_size;
+    return dados;
+#endif
+}
+
+void desmapearArquivo(void *dados, size_t tamanho) {
+#ifdef SEM_MMAP
+    (void)tamanho;
+    free(dados);
+#else
+    munmap(dados, tamanho);
+#endif
+}
+
+// -------------------------------------------------------
+// Durabilidade: fflush só entrega os dados ao sistema; para
+// que sobrevivam a uma queda da máquina é preciso fsync no
+// arquivo e, quando ele foi criado ou renomeado, na pasta
+// que o contém (é ela que guarda o nome). No Windows, _commit
+// faz o papel de fsync e pastas não são sincronizadas.
+// -------------------------------------------------------
+int sincronizarArquivo(FILE *arquivo) {
+    if (fflush(arquivo) != 0) {
+        return 0;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(arquivo)) == 0;
+#else
+    return fsync(fileno(arquivo)) == 0;
+#endif
+}
+
+int sincronizarPasta(const char *caminho) {
+#ifdef _WIN32
+    (void)caminho;
+    return 1;
+#else
+    const char *barra = strrchr(caminho, '/');
+    char *pasta;
+    int fd, ok;
+
+    if (barra == NULL) {
+        pasta = (char *)realocarOuSair(NULL, 2);
+        strcpy(pasta, ".");
+    } else {
+        size_t tam = (barra == caminho) ? 1 : (size_t)(barra - caminho);
+        pasta = (char *)realocarOuSair(NULL, tam + 1);
+        memcpy(pasta, caminho, tam);
+        pasta[tam] = '\0';
+    }
+    fd = open(pasta, O_RDONLY);
+    free(pasta);
+    if (fd < 0) {
+        return 0;
+    }
+    ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+#endif
+}
+
+// Um bloco [des, des + tam) cabe no arquivo e está alinhado?
+int blocoValido(unsigned long long des, unsigned long long tam, size_t tamArquivo) {
+    return (des % 8) == 0 && des <= tamArquivo && tam <= tamArquivo - des;
+}
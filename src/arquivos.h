@@ -0,0 +1,18 @@
+#ifndef ARQUIVOS_H
+#define ARQUIVOS_H
+
+// -------------------------------------------------------
+// Arquivos binários (mansão e sessão): blocos alinhados em
+// 8 bytes e mapeamento do arquivo inteiro na memória
+// -------------------------------------------------------
+#include "comum.h"
+
+unsigned long long alinhar8(unsigned long long valor);
+int gravarBloco(FILE *arquivo, const void *dados, size_t tamanho, unsigned long long ate);
+void* mapearArquivo(const char *caminho, size_t *tamanho);
+void desmapearArquivo(void *dados, size_t tamanho);
+int sincronizarArquivo(FILE *arquivo);
+int sincronizarPasta(const char *caminho);
+int blocoValido(unsigned long long des, unsigned long long tam, size_t tamArquivo);
+
+#endif
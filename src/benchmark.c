@@ -0,0 +1,381 @@
+#include "benchmark.h"
+#include "mansao.h"
+#include "perfeito.h"
+#include "arquivos.h"
+#include "estatisticas.h"
+
+// -------------------------------------------------------
+// Ferramenta: histogramaSondagem
+// Lê um corpus (um texto por linha, truncado como pista),
+// e para cada função de hash mede o tempo de hashear todos
+// os textos distintos e a distância de sondagem de cada um
+// numa tabela linear com máscara, do tamanho que a hash do
+// jogo teria (carga até 7/8). Mostra também hashes de 32
+// bits repetidos (o esperado é cerca de n^2 / 2^33).
+// -------------------------------------------------------
+int histogramaSondagem(const char *caminho) {
+    static const unsigned int limites[] = { 1, 2, 3, 4, 8, 16, 32, 64 };
+    static const char *rotulos[] = { "0", "1", "2", "3", "4-7", "8-15", "16-31", "32-63", "64+" };
+    const int numFaixas = 9;
+    size_t tamanho;
+    const char *dados = (const char *)mapearArquivo(caminho, &tamanho);
+
+    if (dados == NULL) {
+        printf("Nao foi possivel ler o corpus '%s'.\n", caminho);
+        return 0;
+    }
+
+    // Textos distintos, internados no pool
+    const char *fimArquivo = dados + tamanho;
+    for (const char *linha = dados; linha < fimArquivo; ) {
+        const char *fim = (const char *)memchr(linha, '\n', (size_t)(fimArquivo - linha));
+        char texto[TAM_PISTA];
+        size_t len;
+
+        if (fim == NULL) {
+            fim = fimArquivo;
+        }
+        len = (size_t)(fim - linha);
+        if (len > 0 && linha[len - 1] == '\r') len--;
+        if (len > TAM_PISTA - 1) len = TAM_PISTA - 1;
+        memcpy(texto, linha, len);
+        texto[len] = '\0';
+        internarTexto(texto, TAM_PISTA);
+        linha = fim + 1;
+    }
+    desmapearArquivo((void *)dados, tamanho);
+
+    unsigned int n = (poolTextos.quantidade > 0) ? poolTextos.quantidade - 1 : 0;
+    if (n == 0) {
+        printf("O corpus '%s' nao tem textos.\n", caminho);
+        return 0;
+    }
+
+    unsigned int cap = TAM_TABELA_HASH;
+    while ((unsigned long long)n * CARGA_MAX_DEN > (unsigned long long)cap * CARGA_MAX_NUM) {
+        cap *= 2;
+    }
+    unsigned int *hashes = (unsigned int *)realocarOuSair(NULL, n * sizeof(unsigned int));
+    unsigned int *ocupado = (unsigned int *)realocarOuSair(NULL, cap * sizeof(unsigned int));
+    unsigned int *tabela = (unsigned int *)realocarOuSair(NULL, cap * sizeof(unsigned int));
+
+    printf("%u textos distintos, tabela de %u slots (carga %.3f)\n", n, cap, (double)n / cap);
+    for (size_t f = 0; f < sizeof(funcoesHash) / sizeof(funcoesHash[0]); f++) {
+        unsigned long long faixas[9] = { 0 };
+        unsigned long long soma = 0;
+        unsigned int maxima = 0;
+        unsigned int repetidos = 0;
+        double melhor = 0;
+
+        // Tempo de hash: melhor de três passadas
+        for (int volta = 0; volta < 3; volta++) {
+            double inicio = segundosAgora();
+            for (HandleTexto h = 1; h <= n; h++) {
+                const EntradaPool *e = &poolTextos.entradas[h];
+                hashes[h - 1] = funcoesHash[f].funcao(&poolTextos.textos[e->deslocamento], e->tamanho);
+            }
+            double gasto = segundosAgora() - inicio;
+            if (volta == 0 || gasto < melhor) melhor = gasto;
+        }
+
+        // Sondagem linear; 'ocupado' marca slots com hash
+        // completo igual, para contar colisões de 32 bits
+        memset(ocupado, 0, cap * sizeof(unsigned int));
+        for (unsigned int i = 0; i < n; i++) {
+            unsigned int pos = hashes[i] & (cap - 1);
+            unsigned int distancia = 0;
+            int igual = 0;
+
+            while (ocupado[pos]) {
+                if (tabela[pos] == hashes[i]) igual = 1;
+                pos = (pos + 1) & (cap - 1);
+                distancia++;
+            }
+            ocupado[pos] = 1;
+            tabela[pos] = hashes[i];
+            repetidos += igual;
+
+            int faixa = 0;
+            while (faixa < numFaixas - 1 && distancia >= limites[faixa]) faixa++;
+            faixas[faixa]++;
+            soma += distancia;
+            if (distancia > maxima) maxima = distancia;
+        }
+
+        printf("\n%s: %.1f ns/texto, distancia media %.2f, maxima %u, hashes repetidos %u\n",
+               funcoesHash[f].nome, melhor * 1e9 / n, (double)soma / n, maxima, repetidos);
+        for (int k = 0; k < numFaixas; k++) {
+            printf("  %6s %10llu  %5.1f%%\n", rotulos[k], faixas[k], 100.0 * faixas[k] / n);
+        }
+    }
+
+    free(hashes);
+    free(ocupado);
+    free(tabela);
+    return 1;
+}
+
+// -------------------------------------------------------
+// Ferramenta: benchmark de mansões geradas
+// Gera mansões de 10^3 salas até 'maxSalas' em três formas
+// e duas distribuições de suspeitos, mede cada fase do jogo
+// separadamente e grava os tempos num JSON para comparar
+// versões. Cada fase vale o melhor de algumas repetições
+// (menos repetições nas mansões grandes). As fases buscaHash
+// e buscaPerf consultam todas as pistas pelo texto na tabela
+// dinâmica e no hash perfeito montado em hashPerf.
+// -------------------------------------------------------
+const char *nomesFormas[] = { "equilibrada", "cadeia", "aleatoria" };
+const char *nomesDistribuicoes[] = { "uniforme", "concentrada" };
+const char *nomesFases[NUM_FASES_BENCHMARK] = {
+    "construcao", "compactacao", "travessia", "coleta", "veredito",
+    "hashPerf", "buscaHash", "buscaPerf", "liberacao"
+};
+
+// xorshift64*: a mesma semente gera a mesma mansão
+unsigned long long proximoAleatorio(unsigned long long *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 0x2545F4914F6CDD1Dull;
+}
+
+// -------------------------------------------------------
+// Função: gerarMansaoBenchmark
+// Monta 'n' salas com criarSala. Cada sala nova ocupa uma
+// "vaga" (ponteiro esq/dir ainda livre) e abre as suas duas:
+// na equilibrada as vagas são usadas em ordem de largura, na
+// cadeia só existe uma vaga (lado sorteado) e na aleatória
+// a vaga é sorteada. 10% das salas não têm pista e 10%
+// repetem a pista de uma sala anterior.
+// -------------------------------------------------------
+Sala* gerarMansaoBenchmark(Arena *arena, int forma, int distribuicao, unsigned int n,
+                           unsigned long long semente) {
+    Sala ***vagas = (Sala ***)malloc((2 * (size_t)n + 1) * sizeof(Sala **));
+    unsigned int *idPista = (unsigned int *)malloc((size_t)n * sizeof(unsigned int));
+    unsigned int inicio = 0, fim = 0;
+    Sala *raiz = NULL;
+    char nome[TAM_NOME_SALA], pista[TAM_PISTA], suspeito[TAM_SUSPEITO];
+
+    if (vagas == NULL || idPista == NULL) {
+        printf("Erro ao alocar memoria para o benchmark.\n");
+        exit(1);
+    }
+
+    vagas[fim++] = &raiz;
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned long long r = proximoAleatorio(&semente);
+        unsigned int tipo = (unsigned int)(r % 10);
+
+        // Pista e suspeito
+        idPista[i] = (tipo == 1 && i > 0) ? idPista[(r >> 8) % i] : i;
+        snprintf(nome, sizeof(nome), "Sala %u", i);
+        snprintf(pista, sizeof(pista), "Pista %u encontrada no comodo", idPista[i]);
+        double u = (double)(proximoAleatorio(&semente) >> 11) / 9007199254740992.0;
+        int numero = (distribuicao == 0) ? (int)(u * SUSPEITOS_BENCHMARK)
+                                         : (int)(u * u * u * SUSPEITOS_BENCHMARK);
+        snprintf(suspeito, sizeof(suspeito), "Suspeito %d", numero);
+        Sala *sala = criarSala(arena, nome, (tipo == 0) ? "" : pista, (tipo == 0) ? "" : suspeito);
+
+        // Vaga ocupada pela sala
+        unsigned int v;
+        if (forma == 0) {
+            v = inicio++;
+        } else if (forma == 1) {
+            v = inicio;
+        } else {
+            v = inicio + (unsigned int)((r >> 32) % (fim - inicio));
+        }
+        *vagas[v] = sala;
+
+        // Vagas abertas pela sala
+        if (forma == 0) {
+            vagas[fim++] = &sala->esq;
+            vagas[fim++] = &sala->dir;
+        } else if (forma == 1) {
+            vagas[v] = (r & (1ull << 40)) ? &sala->esq : &sala->dir;
+        } else {
+            vagas[v] = &sala->esq;
+            vagas[fim++] = &sala->dir;
+        }
+    }
+
+    free(vagas);
+    free(idPista);
+    return raiz;
+}
+
+// Visitantes do benchmark: só lê o nome / coleta como explorarSalas
+void somarNomeSala(const Mansao *mansao, int sala, void *contexto) {
+    *(unsigned long long *)contexto += nomeSala(mansao, sala);
+}
+
+void coletarSala(const Mansao *mansao, int sala, void *contexto) {
+    ColetaPercurso *coleta = (ColetaPercurso *)contexto;
+    HandleTexto pista = pistaSala(mansao, sala);
+    HandleTexto suspeito = suspeitoSala(mansao, sala);
+
+    if (pista != TEXTO_VAZIO) {
+        inserirPista(coleta->pistas, pista);
+        if (suspeito != TEXTO_VAZIO) {
+            inserirNaHashPorHandle(coleta->tabela, pista, suspeito);
+        }
+    }
+}
+
+int executarBenchmark(const char *caminho, unsigned int maxSalas) {
+    FILE *json = fopen(caminho, "w");
+    unsigned long long soma = 0;
+    int primeiro = 1;
+    int ok = 1;
+
+    if (json == NULL) {
+        printf("Nao foi possivel criar '%s'.\n", caminho);
+        return 0;
+    }
+
+    fprintf(json, "{\n  \"versaoHash\": %d,\n  \"resultados\": [", VERSAO_HASH_TEXTO);
+    printf("%-12s %-12s %9s %9s", "forma", "suspeitos", "salas", "pistas");
+    for (int f = 0; f < NUM_FASES_BENCHMARK; f++) {
+        printf(" %11s", nomesFases[f]);
+    }
+    printf("   (ms)\n");
+
+    for (unsigned long long n = 1000; n <= maxSalas; n *= 10) {
+        int repeticoes = (n <= 10000) ? 5 : (n <= 100000) ? 3 : 1;
+
+        for (int forma = 0; forma < 3; forma++) {
+            for (int distribuicao = 0; distribuicao < 2; distribuicao++) {
+                double melhor[NUM_FASES_BENCHMARK];
+                unsigned int numPistas = 0;
+                double bitsPorPista = 0.0;
+                int implicita = 0;
+
+                for (int rep = 0; rep < repeticoes; rep++) {
+                    double marcas[NUM_FASES_BENCHMARK + 1];
+                    unsigned long long semente = 0x9E3779B97F4A7C15ull ^ (n * 6 + forma * 2 + distribuicao);
+                    Arena arena;
+                    Mansao mansao;
+                    ArvorePistas pistas;
+                    TabelaHash tabela;
+                    MapaPerfeito mapa;
+                    char nome[TAM_SUSPEITO];
+
+                    int *pilha = (int *)realocarOuSair(NULL, (size_t)n * sizeof(int));
+
+                    marcas[0] = segundosAgora();
+                    inicializarArena(&arena);
+                    Sala *raiz = gerarMansaoBenchmark(&arena, forma, distribuicao, (unsigned int)n, semente);
+                    marcas[1] = segundosAgora();
+
+                    compactarMansao(raiz, &mansao);
+                    tornarMansaoImplicita(&mansao);
+                    marcas[2] = segundosAgora();
+
+                    unsigned int visitadas = percorrerMansao(&mansao, pilha, somarNomeSala, &soma);
+                    marcas[3] = segundosAgora();
+
+                    inicializarPistas(&pistas, &arena);
+                    inicializarHash(&tabela);
+                    ColetaPercurso coleta = { &pistas, &tabela };
+                    percorrerMansao(&mansao, pilha, coletarSala, &coleta);
+                    marcas[4] = segundosAgora();
+
+                    // Veredito: contagem de cada suspeito, o mais
+                    // provável e a lista de pistas dele
+                    for (int s = 0; s < SUSPEITOS_BENCHMARK; s++) {
+                        snprintf(nome, sizeof(nome), "Suspeito %d", s);
+                        soma += (unsigned long long)contarPistasPorSuspeito(&tabela, nome);
+                    }
+                    int contagem;
+                    unsigned int quantidade;
+                    HandleTexto topo = suspeitoMaisProvavel(&tabela.placar, &contagem);
+                    const HandleTexto *lista = pistasDoSuspeito(&tabela, topo, &quantidade);
+                    for (unsigned int i = 0; i < quantidade; i++) {
+                        soma += lista[i];
+                    }
+                    marcas[5] = segundosAgora();
+
+                    // Hash perfeito das mesmas pistas da tabela e a
+                    // consulta de todas elas pelo texto, nas duas
+                    unsigned int numChaves = tabela.quantidade;
+                    HandleTexto *chaves = (HandleTexto *)realocarOuSair(NULL, ((size_t)numChaves + 1) * sizeof(HandleTexto));
+                    HandleTexto *valores = (HandleTexto *)realocarOuSair(NULL, ((size_t)numChaves + 1) * sizeof(HandleTexto));
+                    const char **respostas = (const char **)realocarOuSair(NULL, ((size_t)numChaves + 1) * sizeof(char *));
+                    for (unsigned int i = 0; i < numChaves; i++) {
+                        chaves[i] = entradaHash(&tabela, i)->pista;
+                        valores[i] = entradaHash(&tabela, i)->suspeito;
+                    }
+                    if (!construirMapaPerfeito(&mapa, chaves, valores, numChaves)) {
+                        printf("Erro: hash perfeito nao montado (%u pistas).\n", numChaves);
+                        ok = 0;
+                    }
+                    marcas[6] = segundosAgora();
+
+                    for (unsigned int i = 0; i < numChaves; i++) {
+                        respostas[i] = encontrarSuspeito(&tabela, textoDe(chaves[i]));
+                    }
+                    marcas[7] = segundosAgora();
+
+                    unsigned int divergencias = 0;
+                    for (unsigned int i = 0; i < numChaves; i++) {
+                        HandleTexto suspeito = consultarMapaPerfeito(&mapa, textoDe(chaves[i]));
+                        divergencias += (suspeito == TEXTO_INEXISTENTE || textoDe(suspeito) != respostas[i]);
+                    }
+                    marcas[8] = segundosAgora();
+
+                    if (divergencias != 0) {
+                        printf("Erro: %u pistas com suspeitos diferentes no hash perfeito.\n", divergencias);
+                        ok = 0;
+                    }
+                    numPistas = pistas.quantidade;
+                    implicita = (mansao.implicitas != NULL);
+                    bitsPorPista = bitsPorPistaMapaPerfeito(&mapa);
+                    free(chaves);
+                    free(valores);
+                    free(respostas);
+                    liberarMapaPerfeito(&mapa);
+                    liberarHash(&tabela);
+                    liberarArena(&arena);
+                    liberarMansao(&mansao);
+                    liberarPoolTextos();
+                    marcas[9] = segundosAgora();
+                    free(pilha);
+
+                    if (visitadas != n) {
+                        printf("Erro: a travessia visitou %u de %llu salas.\n", visitadas, n);
+                        ok = 0;
+                    }
+                    for (int f = 0; f < NUM_FASES_BENCHMARK; f++) {
+                        double gasto = marcas[f + 1] - marcas[f];
+                        if (rep == 0 || gasto < melhor[f]) melhor[f] = gasto;
+                    }
+                }
+
+                printf("%-12s %-12s %9llu %9u", nomesFormas[forma], nomesDistribuicoes[distribuicao],
+                       n, numPistas);
+                fprintf(json, "%s\n    {\"forma\": \"%s\", \"suspeitos\": \"%s\", \"salas\": %llu, "
+                        "\"pistas\": %u, \"implicita\": %s, \"bitsPorPista\": %.3f, "
+                        "\"repeticoes\": %d, \"ms\": {",
+                        primeiro ? "" : ",", nomesFormas[forma], nomesDistribuicoes[distribuicao],
+                        n, numPistas, implicita ? "true" : "false", bitsPorPista, repeticoes);
+                for (int f = 0; f < NUM_FASES_BENCHMARK; f++) {
+                    printf(" %11.3f", melhor[f] * 1e3);
+                    fprintf(json, "%s\"%s\": %.4f", (f == 0) ? "" : ", ", nomesFases[f], melhor[f] * 1e3);
+                }
+                printf("\n");
+                fprintf(json, "}}");
+                primeiro = 0;
+                ESTAT_VERIFICAR();
+            }
+        }
+    }
+    fprintf(json, "\n  ]\n}\n");
+
+    if (fclose(json) != 0) {
+        printf("Erro ao gravar '%s'.\n", caminho);
+        ok = 0;
+    }
+    if (soma == 1) printf("\n"); // mantém as travessias vivas
+    return ok;
+}
@@ -0,0 +1,26 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "pistas.h"
+#include "hash.h"
+#include "mansao.h"
+
+#define NUM_FASES_BENCHMARK 9            // construção ... liberação
+#define SUSPEITOS_BENCHMARK 64           // suspeitos das mansões geradas
+
+// Destino das pistas num percurso com coleta (coletarSala)
+typedef struct ColetaPercurso {
+    ArvorePistas *pistas;
+    TabelaHash *tabela;
+} ColetaPercurso;
+
+int histogramaSondagem(const char *caminho);
+int executarBenchmark(const char *caminho, unsigned int maxSalas);
+
+// Também usados pelos programas de bench/
+unsigned long long proximoAleatorio(unsigned long long *estado);
+Sala* gerarMansaoBenchmark(Arena *arena, int forma, int distribuicao, unsigned int n,
+                           unsigned long long semente);
+void somarNomeSala(const Mansao *mansao, int sala, void *contexto);
+
+#endif
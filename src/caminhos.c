@@ -0,0 +1,319 @@
+#include "caminhos.h"
+
+// -------------------------------------------------------
+// Índice de caminhos da mansão
+// -------------------------------------------------------
+
+// Sala de menor profundidade entre duas (desempate qualquer)
+int maisRasa(const IndiceCaminhos *indice, int a, int b) {
+    return (indice->profundidade[b] < indice->profundidade[a]) ? b : a;
+}
+
+// -------------------------------------------------------
+// Função: passeioDeEuler
+// Passeio de Euler iterativo a partir da raiz: a sala entra
+// ao ser alcançada e de novo na volta de cada filho (2n - 1
+// posições). A pilha guarda a sala e quantos filhos já
+// foram tratados.
+// -------------------------------------------------------
+void passeioDeEuler(IndiceCaminhos *indice, const Mansao *mansao) {
+    int *pilha = (int *)realocarOuSair(NULL, (size_t)indice->numSalas * sizeof(int));
+    unsigned char *etapa = (unsigned char *)realocarOuSair(NULL, indice->numSalas);
+    unsigned int pos = 0;
+    int topo = 0;
+
+    pilha[topo] = 0;
+    etapa[topo] = 0;
+    topo++;
+    while (topo > 0) {
+        int sala = pilha[topo - 1];
+        unsigned char e = etapa[topo - 1];
+
+        if (e == 0) {
+            indice->primeira[sala] = pos;
+        }
+        indice->euler[pos] = sala;
+        indice->ultima[sala] = pos;
+        pos++;
+
+        // Próximo filho ainda não visitado (0 = esq, 1 = dir)
+        int filho = SEM_SALA;
+        while (e < 2 && filho == SEM_SALA) {
+            filho = (e == 0) ? salaEsq(mansao, sala) : salaDir(mansao, sala);
+            e++;
+        }
+        etapa[topo - 1] = e;
+        if (filho != SEM_SALA) {
+            pilha[topo] = filho;
+            etapa[topo] = 0;
+            topo++;
+        } else {
+            topo--; // a volta ao pai entra no passeio na próxima volta do laço
+        }
+    }
+    indice->tamEuler = pos;
+    free(pilha);
+    free(etapa);
+}
+
+// -------------------------------------------------------
+// Função: construirIndiceCaminhos
+// Pré-processamento único da mansão:
+// - profundidade e caminho desde o Hall de cada sala. O
+//   caminho fica em blocos de até 64 movimentos: 'trilha'
+//   tem os movimentos desde a 'ancora' (o ancestral na
+//   profundidade múltipla de 64 logo acima), então até 64
+//   níveis o caminho inteiro é uma palavra;
+// - pista -> primeira sala (em largura) e suspeito -> salas;
+// - passeio de Euler e tabela esparsa de mínimos, para
+//   ancestral comum e pertinência a subárvore em O(1).
+// Os índices de sala são os da mansão (slots na implícita).
+// Num arquivo texto os ids podem vir em qualquer ordem (um
+// filho com id menor que o do pai), então as passadas
+// seguem a ordem em largura a partir do Hall, e não a dos
+// índices: assim o pai sempre é tratado antes dos filhos.
+// -------------------------------------------------------
+void construirIndiceCaminhos(IndiceCaminhos *indice, const Mansao *mansao) {
+    unsigned int limite = mansao->implicitas ? mansao->numSlots : mansao->quantidade;
+
+    memset(indice, 0, sizeof(*indice));
+    indice->limite = limite;
+    indice->numSalas = mansao->quantidade;
+    if (mansao->quantidade == 0) return;
+
+    indice->profundidade = (unsigned int *)realocarOuSair(NULL, (size_t)limite * sizeof(unsigned int));
+    indice->trilha = (unsigned long long *)realocarOuSair(NULL, (size_t)limite * sizeof(unsigned long long));
+    indice->ancora = (int *)realocarOuSair(NULL, (size_t)limite * sizeof(int));
+    indice->primeira = (unsigned int *)realocarOuSair(NULL, (size_t)limite * sizeof(unsigned int));
+    indice->ultima = (unsigned int *)realocarOuSair(NULL, (size_t)limite * sizeof(unsigned int));
+
+    // Ordem em largura: a fila, depois de esvaziada, é a lista
+    // das salas com cada pai antes dos filhos
+    int *ordem = (int *)realocarOuSair(NULL, (size_t)indice->numSalas * sizeof(int));
+    unsigned int numOrdem = 0;
+    ordem[numOrdem++] = 0;
+    for (unsigned int k = 0; k < numOrdem; k++) {
+        int esq = salaEsq(mansao, ordem[k]);
+        int dir = salaDir(mansao, ordem[k]);
+        if (esq != SEM_SALA && numOrdem < indice->numSalas) ordem[numOrdem++] = esq;
+        if (dir != SEM_SALA && numOrdem < indice->numSalas) ordem[numOrdem++] = dir;
+    }
+
+    // Caminhos: cada sala passa o seu para os filhos
+    indice->profundidade[0] = 0;
+    indice->trilha[0] = 0;
+    indice->ancora[0] = SEM_SALA;
+    for (unsigned int k = 0; k < numOrdem; k++) {
+        int i = ordem[k];
+        unsigned int p = indice->profundidade[i];
+        for (int lado = 0; lado < 2; lado++) {
+            int filho = lado ? salaDir(mansao, i) : salaEsq(mansao, i);
+            if (filho == SEM_SALA) continue;
+
+            indice->profundidade[filho] = p + 1;
+            if (p % 64 == 0) {
+                indice->ancora[filho] = i; // começa um bloco novo
+                indice->trilha[filho] = (unsigned long long)lado;
+            } else {
+                indice->ancora[filho] = indice->ancora[i];
+                indice->trilha[filho] = indice->trilha[i] | ((unsigned long long)lado << (p % 64));
+            }
+        }
+    }
+
+    // Pista -> sala e suspeito -> salas (CSR por handle)
+    indice->numHandles = poolTextos.quantidade;
+    indice->salaDaPista = (int *)realocarOuSair(NULL, (size_t)indice->numHandles * sizeof(int));
+    indice->inicioSuspeito = (unsigned int *)calloc((size_t)indice->numHandles + 1, sizeof(unsigned int));
+    if (indice->inicioSuspeito == NULL) {
+        printf("Erro ao alocar memoria para o indice de caminhos.\n");
+        exit(1);
+    }
+    for (unsigned int h = 0; h < indice->numHandles; h++) {
+        indice->salaDaPista[h] = SEM_SALA;
+    }
+    for (unsigned int k = 0; k < numOrdem; k++) {
+        int i = ordem[k];
+        HandleTexto pista = pistaSala(mansao, i);
+        HandleTexto suspeito = suspeitoSala(mansao, i);
+        if (pista != TEXTO_VAZIO && indice->salaDaPista[pista] == SEM_SALA) {
+            indice->salaDaPista[pista] = i;
+        }
+        if (suspeito != TEXTO_VAZIO) {
+            indice->inicioSuspeito[suspeito + 1]++;
+        }
+    }
+    for (unsigned int h = 0; h < indice->numHandles; h++) {
+        indice->inicioSuspeito[h + 1] += indice->inicioSuspeito[h];
+    }
+    indice->salasSuspeito = (int *)realocarOuSair(NULL,
+                                ((size_t)indice->inicioSuspeito[indice->numHandles] + 1) * sizeof(int));
+    unsigned int *proxima = (unsigned int *)realocarOuSair(NULL, (size_t)indice->numHandles * sizeof(unsigned int));
+    memcpy(proxima, indice->inicioSuspeito, (size_t)indice->numHandles * sizeof(unsigned int));
+    for (unsigned int k = 0; k < numOrdem; k++) {
+        HandleTexto suspeito = suspeitoSala(mansao, ordem[k]);
+        if (suspeito != TEXTO_VAZIO) {
+            indice->salasSuspeito[proxima[suspeito]++] = ordem[k];
+        }
+    }
+    free(proxima);
+    free(ordem);
+
+    // Passeio de Euler e tabela esparsa: o nível k guarda, para
+    // cada posição, a sala mais rasa das 2^(k+1) seguintes
+    indice->euler = (int *)realocarOuSair(NULL, (2 * (size_t)indice->numSalas) * sizeof(int));
+    passeioDeEuler(indice, mansao);
+
+    unsigned int m = indice->tamEuler;
+    indice->niveis = (int)maiorBit(m);
+    if (indice->niveis > 0) {
+        indice->esparsa = (int *)realocarOuSair(NULL, (size_t)indice->niveis * m * sizeof(int));
+    }
+    for (int k = 0; k < indice->niveis; k++) {
+        const int *anterior = (k == 0) ? indice->euler : indice->esparsa + (size_t)(k - 1) * m;
+        int *nivel = indice->esparsa + (size_t)k * m;
+        unsigned int meio = 1u << k;
+        for (unsigned int i = 0; i + 2 * meio <= m; i++) {
+            nivel[i] = maisRasa(indice, anterior[i], anterior[i + meio]);
+        }
+    }
+}
+
+void liberarIndiceCaminhos(IndiceCaminhos *indice) {
+    free(indice->profundidade);
+    free(indice->trilha);
+    free(indice->ancora);
+    free(indice->primeira);
+    free(indice->ultima);
+    free(indice->euler);
+    free(indice->esparsa);
+    free(indice->salaDaPista);
+    free(indice->inicioSuspeito);
+    free(indice->salasSuspeito);
+    memset(indice, 0, sizeof(*indice));
+}
+
+// Primeira sala (em largura) com a pista, ou SEM_SALA
+int salaComPista(const IndiceCaminhos *indice, HandleTexto pista) {
+    if (pista == TEXTO_VAZIO || pista >= indice->numHandles) return SEM_SALA;
+    return indice->salaDaPista[pista];
+}
+
+// Salas cujas pistas apontam para o suspeito
+const int* salasComSuspeito(const IndiceCaminhos *indice, HandleTexto suspeito,
+                            unsigned int *quantidade) {
+    if (suspeito == TEXTO_VAZIO || suspeito >= indice->numHandles) {
+        *quantidade = 0;
+        return NULL;
+    }
+    *quantidade = indice->inicioSuspeito[suspeito + 1] - indice->inicioSuspeito[suspeito];
+    return indice->salasSuspeito + indice->inicioSuspeito[suspeito];
+}
+
+// -------------------------------------------------------
+// Função: caminhoAteSala
+// Escreve em 'saida' os movimentos ('e'/'d') do Hall até a
+// sala e devolve quantos são, ou -1 se não couberem em 'tam'
+// (contando o '\0'). Um bloco de 64 movimentos por vez.
+// -------------------------------------------------------
+int caminhoAteSala(const IndiceCaminhos *indice, int sala, char *saida, size_t tam) {
+    unsigned int profundidade = indice->profundidade[sala];
+
+    if ((size_t)profundidade + 1 > tam) return -1;
+
+    saida[profundidade] = '\0';
+    while (sala != SEM_SALA && indice->profundidade[sala] > 0) {
+        unsigned int p = indice->profundidade[sala];
+        unsigned int noBloco = ((p - 1) % 64) + 1; // movimentos desde a âncora
+        unsigned long long bits = indice->trilha[sala];
+        for (unsigned int j = 0; j < noBloco; j++) {
+            saida[p - noBloco + j] = ((bits >> j) & 1ull) ? 'd' : 'e';
+        }
+        sala = indice->ancora[sala];
+    }
+    return (int)profundidade;
+}
+
+// Ancestral comum mais profundo de duas salas: a sala mais
+// rasa do passeio de Euler entre as primeiras visitas de ambas
+int ancestralComum(const IndiceCaminhos *indice, int a, int b) {
+    unsigned int i = indice->primeira[a];
+    unsigned int j = indice->primeira[b];
+
+    if (i > j) {
+        unsigned int t = i;
+        i = j;
+        j = t;
+    }
+    unsigned int tamanho = j - i + 1;
+    if (tamanho == 1) return indice->euler[i];
+
+    int k = (int)maiorBit(tamanho) - 1; // nível com blocos de 2^(k+1)
+    const int *nivel = indice->esparsa + (size_t)k * indice->tamEuler;
+    return maisRasa(indice, nivel[i], nivel[j + 1 - (2u << k)]);
+}
+
+// A sala está na subárvore de 'raiz' (inclusive)?
+int naSubarvore(const IndiceCaminhos *indice, int raiz, int sala) {
+    return indice->primeira[raiz] <= indice->primeira[sala] &&
+           indice->ultima[sala] <= indice->ultima[raiz];
+}
+
+// Imprime "  Sala: e d e" com o caminho do Hall até a sala
+void imprimirCaminho(const Mansao *mansao, const IndiceCaminhos *indice, int sala) {
+    size_t tam = (size_t)indice->profundidade[sala] + 1;
+    char *movimentos = (char *)realocarOuSair(NULL, tam);
+
+    caminhoAteSala(indice, sala, movimentos, tam);
+    printf("  %s:", textoDe(nomeSala(mansao, sala)));
+    if (movimentos[0] == '\0') {
+        printf(" (e o proprio Hall)");
+    }
+    for (size_t i = 0; movimentos[i] != '\0'; i++) {
+        printf(" %c", movimentos[i]);
+    }
+    printf("\n");
+    free(movimentos);
+}
+
+// -------------------------------------------------------
+// Função: mostrarCaminho
+// Modo --caminho: movimentos do Hall até a sala da pista
+// ou, para um suspeito, até cada sala que aponta para ele
+// e a sala a partir da qual todas ficam na mesma ala (o
+// ancestral comum delas).
+// -------------------------------------------------------
+int mostrarCaminho(const Mansao *mansao, const char *texto) {
+    IndiceCaminhos indice;
+    HandleTexto handle = buscarTexto(texto);
+    unsigned int quantidade;
+
+    construirIndiceCaminhos(&indice, mansao);
+
+    int sala = salaComPista(&indice, handle);
+    const int *salas = salasComSuspeito(&indice, handle, &quantidade);
+    if (sala != SEM_SALA) {
+        printf("Pista encontrada em %s (profundidade %u):\n",
+               textoDe(nomeSala(mansao, sala)), indice.profundidade[sala]);
+        imprimirCaminho(mansao, &indice, sala);
+    } else if (quantidade > 0) {
+        int comum = salas[0];
+        printf("%u sala(s) com pistas contra %s:\n", quantidade, texto);
+        for (unsigned int i = 0; i < quantidade; i++) {
+            if (i < 10) {
+                imprimirCaminho(mansao, &indice, salas[i]);
+            }
+            comum = ancestralComum(&indice, comum, salas[i]);
+        }
+        if (quantidade > 10) {
+            printf("  ... e mais %u\n", quantidade - 10);
+        }
+        printf("Todas ficam a partir de %s:\n", textoDe(nomeSala(mansao, comum)));
+        imprimirCaminho(mansao, &indice, comum);
+    } else {
+        printf("Nenhuma sala tem a pista ou o suspeito \"%s\".\n", texto);
+    }
+
+    liberarIndiceCaminhos(&indice);
+    return 1;
+}
@@ -0,0 +1,40 @@
+#ifndef CAMINHOS_H
+#define CAMINHOS_H
+
+#include "mansao.h"
+
+// -------------------------------------------------------
+// Índice de caminhos: pré-processamento único da mansão
+// para responder "como chego à sala desta pista?" sem andar
+// pela árvore. Vetores indexados pelo índice da sala (slot
+// na forma implícita) ou pelo handle do texto.
+// -------------------------------------------------------
+typedef struct IndiceCaminhos {
+    unsigned int numSalas;
+    unsigned int limite;              // tamanho dos vetores por sala
+    unsigned int *profundidade;       // Hall = 0
+    unsigned long long *trilha;       // movimentos desde 'ancora' (bit j = 1: 'd')
+    int *ancora;                      // ancestral na profundidade múltipla de 64 acima
+    unsigned int *primeira;           // primeira e última posição no passeio de Euler
+    unsigned int *ultima;
+    int *euler;                       // passeio de Euler (2n - 1 salas)
+    unsigned int tamEuler;
+    int *esparsa;                     // níveis da tabela esparsa, 'tamEuler' cada
+    int niveis;
+    int *salaDaPista;                 // por handle (SEM_SALA = nenhuma)
+    unsigned int *inicioSuspeito;     // por handle: salas do suspeito em salasSuspeito
+    int *salasSuspeito;
+    unsigned int numHandles;
+} IndiceCaminhos;
+
+void construirIndiceCaminhos(IndiceCaminhos *indice, const Mansao *mansao);
+void liberarIndiceCaminhos(IndiceCaminhos *indice);
+int salaComPista(const IndiceCaminhos *indice, HandleTexto pista);
+const int* salasComSuspeito(const IndiceCaminhos *indice, HandleTexto suspeito,
+                            unsigned int *quantidade);
+int caminhoAteSala(const IndiceCaminhos *indice, int sala, char *saida, size_t tam);
+int ancestralComum(const IndiceCaminhos *indice, int a, int b);
+int naSubarvore(const IndiceCaminhos *indice, int raiz, int sala);
+int mostrarCaminho(const Mansao *mansao, const char *texto);
+
+#endif
@@ -0,0 +1,21 @@
+#include "comum.h"
+
+// Relógio de parede em segundos, para medir as fases
+double segundosAgora(void) {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+// Maior bit ligado (log2 arredondado para baixo), mascara > 0
+unsigned int maiorBit(unsigned int mascara) {
+#if defined(__GNUC__)
+    return 31u - (unsigned int)__builtin_clz(mascara);
+#else
+    unsigned int i = 0;
+    while (mascara >>= 1) {
+        i++;
+    }
+    return i;
+#endif
+}
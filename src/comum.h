@@ -0,0 +1,35 @@
+#ifndef COMUM_H
+#define COMUM_H
+
+// -------------------------------------------------------
+// Nível Mestre: definições comuns a todos os módulos
+// (cabeçalhos do sistema, diferenças de plataforma e
+// tamanhos máximos dos textos)
+// -------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#define SEM_MMAP 1        // sem mmap: o arquivo binário é lido para a memória
+#define SEM_THREADS 1     // sem pthreads: o modo em lote roda em uma thread
+#define SEM_WRITEV 1      // sem writev: as partes da tela vão por fwrite
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#define TAM_NOME_SALA   50
+#define TAM_PISTA       120
+#define TAM_SUSPEITO    40
+
+double segundosAgora(void);
+unsigned int maiorBit(unsigned int mascara);
+
+#endif
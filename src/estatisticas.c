@@ -0,0 +1,236 @@
+#include "estatisticas.h"
+
+#ifdef ESTATISTICAS
+#include <signal.h>
+#endif
+
+// -------------------------------------------------------
+// Estatísticas de execução
+// -------------------------------------------------------
+#ifdef ESTATISTICAS
+_Thread_local EstatisticasThread *estatisticasDaThread = NULL;
+EstatisticasThread *todasEstatisticas = NULL;   // blocos de todas as threads
+const char *arquivoEstatisticas = NULL;          // destino do JSON
+volatile sig_atomic_t pedidoEstatisticas = 0;   // SIGUSR1 recebido
+#ifndef SEM_THREADS
+pthread_mutex_t travaEstatisticas = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+const char *nomesContadores[NUM_CONTADORES] = {
+#define NOME_CONTADOR(id, nome, juncao) nome,
+    CONTADORES_ESTATISTICA(NOME_CONTADOR)
+#undef NOME_CONTADOR
+};
+const int contadorEhMaximo[NUM_CONTADORES] = {
+#define JUNCAO_CONTADOR(id, nome, juncao) JUNCAO_##juncao,
+    CONTADORES_ESTATISTICA(JUNCAO_CONTADOR)
+#undef JUNCAO_CONTADOR
+};
+const char *nomesHistogramas[NUM_HISTOGRAMAS] = {
+#define NOME_HISTOGRAMA(id, nome) nome,
+    HISTOGRAMAS_ESTATISTICA(NOME_HISTOGRAMA)
+#undef NOME_HISTOGRAMA
+};
+
+unsigned long long nanossegundosAgora(void) {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (unsigned long long)t.tv_sec * 1000000000ull + (unsigned long long)t.tv_nsec;
+}
+
+// Primeiro uso numa thread: bloco zerado, posto na lista.
+// Os blocos só são devolvidos no fim do programa, então o
+// JSON ainda enxerga as threads do lote que já terminaram.
+EstatisticasThread* registrarThreadEstatisticas(void) {
+    EstatisticasThread *e = (EstatisticasThread *)calloc(1, sizeof(EstatisticasThread));
+
+    if (e == NULL) {
+        printf("Erro ao alocar memoria para as estatisticas.\n");
+        exit(1);
+    }
+    e->proximaAmostra = 1;
+#ifndef SEM_THREADS
+    pthread_mutex_lock(&travaEstatisticas);
+#endif
+    e->proxima = todasEstatisticas;
+    todasEstatisticas = e;
+#ifndef SEM_THREADS
+    pthread_mutex_unlock(&travaEstatisticas);
+#endif
+    estatisticasDaThread = e;
+    return e;
+}
+
+// Chamada sorteada por ESTAT_AMOSTRA: rearma a contagem e
+// devolve o instante inicial da medição
+unsigned long long reiniciarAmostra(void) {
+    estatisticasDaThread->proximaAmostra = AMOSTRAGEM_LATENCIA;
+    return nanossegundosAgora();
+}
+
+// Faixa do histograma para 'ns' (ver FAIXAS_LATENCIA)
+unsigned int faixaLatencia(unsigned long long ns) {
+    if (ns < (1u << BITS_SUBFAIXA)) return (unsigned int)ns;
+
+    unsigned int k = (ns >> 32) ? 32 + maiorBit((unsigned int)(ns >> 32)) : maiorBit((unsigned int)ns);
+    if (k > MAIOR_BIT_LATENCIA) return FAIXAS_LATENCIA - 1;
+    return ((k - BITS_SUBFAIXA + 1) << BITS_SUBFAIXA) +
+           (unsigned int)((ns >> (k - BITS_SUBFAIXA)) & ((1u << BITS_SUBFAIXA) - 1));
+}
+
+// Maior valor que cai na faixa (o que o JSON informa)
+unsigned long long limiteFaixa(unsigned int faixa) {
+    if (faixa < (1u << BITS_SUBFAIXA)) return faixa;
+
+    unsigned int deslocamento = (faixa >> BITS_SUBFAIXA) - 1;
+    unsigned long long base = (unsigned long long)((1u << BITS_SUBFAIXA) + (faixa & ((1u << BITS_SUBFAIXA) - 1)));
+    return ((base + 1) << deslocamento) - 1;
+}
+
+void registrarLatencia(int histograma, unsigned long long ns) {
+    HistogramaLatencia *h = &ESTAT_LOCAL()->histogramas[histograma];
+
+    h->faixas[faixaLatencia(ns)]++;
+    h->amostras++;
+    h->somaNs += ns;
+    if (ns > h->maiorNs) h->maiorNs = ns;
+}
+
+// Valor do percentil 'p' (0..1) de um histograma
+unsigned long long percentilLatencia(const HistogramaLatencia *h, double p) {
+    unsigned long long alvo = (unsigned long long)(p * (double)h->amostras + 0.5);
+    unsigned long long acumulado = 0;
+
+    if (alvo == 0) alvo = 1;
+    for (unsigned int f = 0; f < FAIXAS_LATENCIA; f++) {
+        acumulado += h->faixas[f];
+        if (acumulado >= alvo) {
+            unsigned long long limite = limiteFaixa(f);
+            return (limite < h->maiorNs) ? limite : h->maiorNs;
+        }
+    }
+    return h->maiorNs;
+}
+
+void gravarContadoresJson(FILE *json, const unsigned long long *contadores, const char *recuo) {
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        fprintf(json, "%s%s\"%s\": %llu", (c == 0) ? "" : ",", recuo, nomesContadores[c], contadores[c]);
+    }
+}
+
+// -------------------------------------------------------
+// Função: gravarEstatisticas
+// Junta os blocos de todas as threads e grava o JSON:
+// contadores (somados ou o maior), médias derivadas,
+// latências (amostras, soma, média e percentis) e os
+// contadores de cada thread. Blocos de threads ainda ativas
+// são lidos sem trava: os números podem estar um passo atrás.
+// -------------------------------------------------------
+int gravarEstatisticas(const char *caminho) {
+    unsigned long long total[NUM_CONTADORES] = { 0 };
+    HistogramaLatencia juntos[NUM_HISTOGRAMAS];
+    unsigned int numThreads = 0;
+    FILE *json = fopen(caminho, "w");
+
+    if (json == NULL) {
+        printf("Nao foi possivel criar '%s'.\n", caminho);
+        return 0;
+    }
+
+#ifndef SEM_THREADS
+    pthread_mutex_lock(&travaEstatisticas);
+#endif
+    memset(juntos, 0, sizeof(juntos));
+    for (const EstatisticasThread *e = todasEstatisticas; e != NULL; e = e->proxima) {
+        numThreads++;
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            if (!contadorEhMaximo[c]) {
+                total[c] += e->contadores[c];
+            } else if (e->contadores[c] > total[c]) {
+                total[c] = e->contadores[c];
+            }
+        }
+        for (int h = 0; h < NUM_HISTOGRAMAS; h++) {
+            const HistogramaLatencia *origem = &e->histogramas[h];
+            for (unsigned int f = 0; f < FAIXAS_LATENCIA; f++) {
+                juntos[h].faixas[f] += origem->faixas[f];
+            }
+            juntos[h].amostras += origem->amostras;
+            juntos[h].somaNs += origem->somaNs;
+            if (origem->maiorNs > juntos[h].maiorNs) juntos[h].maiorNs = origem->maiorNs;
+        }
+    }
+
+    fprintf(json, "{\n  \"threads\": %u,\n  \"amostragemLatencia\": %d,\n  \"contadores\": {",
+            numThreads, AMOSTRAGEM_LATENCIA);
+    gravarContadoresJson(json, total, "\n    ");
+    fprintf(json, "\n  },\n  \"sondagemMedia\": %.3f,\n  \"profundidadeMedia\": %.3f,\n  \"latenciasNs\": {",
+            total[EST_BUSCAS_HASH] ? (double)total[EST_GRUPOS_SONDADOS] / total[EST_BUSCAS_HASH] : 0.0,
+            total[EST_INSERCOES_PISTA] ? (double)total[EST_NIVEIS_DESCIDOS] / total[EST_INSERCOES_PISTA] : 0.0);
+    for (int h = 0; h < NUM_HISTOGRAMAS; h++) {
+        const HistogramaLatencia *j = &juntos[h];
+        fprintf(json, "%s\n    \"%s\": {\"amostras\": %llu, \"somaNs\": %llu, \"media\": %.1f, "
+                "\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+                (h == 0) ? "" : ",", nomesHistogramas[h], j->amostras, j->somaNs,
+                j->amostras ? (double)j->somaNs / j->amostras : 0.0,
+                percentilLatencia(j, 0.50), percentilLatencia(j, 0.90),
+                percentilLatencia(j, 0.99), percentilLatencia(j, 0.999), j->maiorNs);
+    }
+    fprintf(json, "\n  },\n  \"porThread\": [");
+    for (const EstatisticasThread *e = todasEstatisticas; e != NULL; e = e->proxima) {
+        fprintf(json, "%s\n    {", (e == todasEstatisticas) ? "" : ",");
+        gravarContadoresJson(json, e->contadores, " ");
+        fprintf(json, " }");
+    }
+    fprintf(json, "\n  ]\n}\n");
+#ifndef SEM_THREADS
+    pthread_mutex_unlock(&travaEstatisticas);
+#endif
+
+    if (fclose(json) != 0) {
+        printf("Erro ao gravar '%s'.\n", caminho);
+        return 0;
+    }
+    return 1;
+}
+
+// Grava o JSON final e devolve os blocos (via atexit)
+void encerrarEstatisticas(void) {
+    gravarEstatisticas(arquivoEstatisticas);
+    while (todasEstatisticas != NULL) {
+        EstatisticasThread *proxima = todasEstatisticas->proxima;
+        free(todasEstatisticas);
+        todasEstatisticas = proxima;
+    }
+    estatisticasDaThread = NULL;
+}
+
+#ifndef _WIN32
+void pedirEstatisticas(int sinal) {
+    (void)sinal;
+    pedidoEstatisticas = 1;
+}
+#endif
+
+// -------------------------------------------------------
+// Função: ativarEstatisticas
+// O JSON vai para 'caminho' na saída do programa e, em
+// sistemas POSIX, também a cada SIGUSR1 (gravado no próximo
+// ponto seguro da thread principal: um passo da exploração
+// ou uma configuração do benchmark)
+// -------------------------------------------------------
+void ativarEstatisticas(const char *caminho) {
+    arquivoEstatisticas = caminho;
+    atexit(encerrarEstatisticas);
+#ifndef _WIN32
+    signal(SIGUSR1, pedirEstatisticas);
+#endif
+}
+
+void verificarPedidoEstatisticas(void) {
+    if (pedidoEstatisticas && arquivoEstatisticas != NULL) {
+        pedidoEstatisticas = 0;
+        gravarEstatisticas(arquivoEstatisticas);
+    }
+}
+#endif
@@ -0,0 +1,115 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include "comum.h"
+
+// -------------------------------------------------------
+// Estatísticas de execução (compile com -DESTATISTICAS)
+// Cada thread soma nos seus próprios contadores e
+// histogramas, sem travas; o JSON junta todas no fim (ou
+// quando pedido). Latências de operações curtas são medidas
+// em uma de cada AMOSTRAGEM_LATENCIA chamadas, para o relógio
+// não pesar mais que a própria operação. Sem a opção, as
+// macros ESTAT_* não geram código.
+// Histograma no estilo HDR: abaixo de 2^BITS_SUBFAIXA ns,
+// uma faixa por ns; acima, cada potência de dois é dividida
+// em 2^BITS_SUBFAIXA faixas (erro relativo < 1/16).
+// -------------------------------------------------------
+#define AMOSTRAGEM_LATENCIA 256  // uma medição a cada 256 operações curtas
+#define BITS_SUBFAIXA       4
+#define MAIOR_BIT_LATENCIA  40   // ~18 min; acima disso cai na última faixa
+#define FAIXAS_LATENCIA     ((MAIOR_BIT_LATENCIA - BITS_SUBFAIXA + 2) << BITS_SUBFAIXA)
+
+// Contadores: nome no JSON e como juntar as threads
+#define CONTADORES_ESTATISTICA(C)                             \
+    C(BUSCAS_HASH,        "buscasHash",        SOMA)          \
+    C(GRUPOS_SONDADOS,    "gruposSondados",    SOMA)          \
+    C(MAIOR_SONDAGEM,     "maiorSondagem",     MAXIMO)        \
+    C(INSERCOES_PISTA,    "insercoesPista",    SOMA)          \
+    C(NIVEIS_DESCIDOS,    "niveisDescidos",    SOMA)          \
+    C(MAIOR_PROFUNDIDADE, "maiorProfundidade", MAXIMO)        \
+    C(SALAS_CRIADAS,      "salasCriadas",      SOMA)          \
+    C(NOS_PISTAS_CRIADOS, "nosPistasCriados",  SOMA)          \
+    C(BLOCOS_ARENA,       "blocosArena",       SOMA)          \
+    C(BYTES_ARENA,        "bytesArena",        SOMA)
+
+#define HISTOGRAMAS_ESTATISTICA(H)                            \
+    H(BUSCA_SUSPEITO,   "buscaSuspeito")                      \
+    H(INSERCAO_PISTA,   "insercaoPista")                      \
+    H(PASSO_EXPLORACAO, "passoExploracao")                    \
+    H(JULGAMENTO,       "julgamento")                         \
+    H(SESSAO_LOTE,      "sessaoLote")
+
+#define JUNCAO_SOMA   0
+#define JUNCAO_MAXIMO 1
+#define ENUM_CONTADOR(id, nome, juncao) EST_##id,
+#define ENUM_HISTOGRAMA(id, nome) LAT_##id,
+enum { CONTADORES_ESTATISTICA(ENUM_CONTADOR) NUM_CONTADORES };
+enum { HISTOGRAMAS_ESTATISTICA(ENUM_HISTOGRAMA) NUM_HISTOGRAMAS };
+#undef ENUM_CONTADOR
+#undef ENUM_HISTOGRAMA
+
+#ifdef ESTATISTICAS
+typedef struct HistogramaLatencia {
+    unsigned long long faixas[FAIXAS_LATENCIA];
+    unsigned long long amostras;
+    unsigned long long somaNs;
+    unsigned long long maiorNs;
+} HistogramaLatencia;
+
+typedef struct EstatisticasThread {
+    unsigned long long contadores[NUM_CONTADORES];
+    HistogramaLatencia histogramas[NUM_HISTOGRAMAS];
+    unsigned int proximaAmostra;       // operações até a próxima medição
+    struct EstatisticasThread *proxima; // lista de todas as threads
+} EstatisticasThread;
+
+extern _Thread_local EstatisticasThread *estatisticasDaThread;
+EstatisticasThread* registrarThreadEstatisticas(void);
+
+// Bloco da thread atual (criado na primeira vez)
+#define ESTAT_LOCAL() \
+    (estatisticasDaThread != NULL ? estatisticasDaThread : registrarThreadEstatisticas())
+
+#define ESTAT_CONTAR(id, n)   (ESTAT_LOCAL()->contadores[EST_##id] += (n))
+// Uma operação de custo 'v' (sondagem, descida na árvore):
+// conta a operação, soma o custo e guarda o maior
+#define ESTAT_CUSTO(ops, soma, maior, v) do {                             \
+        EstatisticasThread *e_ = ESTAT_LOCAL();                           \
+        e_->contadores[EST_##ops]++;                                      \
+        e_->contadores[EST_##soma] += (v);                                \
+        if ((unsigned long long)(v) > e_->contadores[EST_##maior])        \
+            e_->contadores[EST_##maior] = (unsigned long long)(v);        \
+    } while (0)
+// Mede sempre (fases) ou só nas chamadas sorteadas (operações curtas)
+#define ESTAT_INICIO(t)       unsigned long long t = nanossegundosAgora()
+#define ESTAT_AMOSTRA(t)      unsigned long long t =                      \
+        (--ESTAT_LOCAL()->proximaAmostra == 0) ? reiniciarAmostra() : 0
+#define ESTAT_FIM(id, t)      do {                                        \
+        if ((t) != 0) registrarLatencia(LAT_##id, nanossegundosAgora() - (t)); \
+    } while (0)
+// Tira do tempo medido uma espera (entrada do jogador)
+#define ESTAT_PAUSAR(t)       ((t) = nanossegundosAgora() - (t))
+#define ESTAT_RETOMAR(t)      ((t) = nanossegundosAgora() - (t))
+#define ESTAT_VERIFICAR()     verificarPedidoEstatisticas()
+#else
+#define ESTAT_CONTAR(id, n)   ((void)0)
+#define ESTAT_CUSTO(ops, soma, maior, v) ((void)(v))
+#define ESTAT_INICIO(t)
+#define ESTAT_AMOSTRA(t)
+#define ESTAT_FIM(id, t)      ((void)0)
+#define ESTAT_PAUSAR(t)       ((void)0)
+#define ESTAT_RETOMAR(t)      ((void)0)
+#define ESTAT_VERIFICAR()     ((void)0)
+#endif
+
+#ifdef ESTATISTICAS
+unsigned long long nanossegundosAgora(void);
+unsigned long long reiniciarAmostra(void);
+void registrarLatencia(int histograma, unsigned long long ns);
+int gravarEstatisticas(const char *caminho);
+void ativarEstatisticas(const char *caminho);
+void verificarPedidoEstatisticas(void);
+#endif
+
+#endif
@@ -0,0 +1,781 @@
+#include "hash.h"
+#include "estatisticas.h"
+
+#ifdef HASH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// -------------------------------------------------------
+// Funções da Tabela Hash (pista -> suspeito)
+// Endereçamento aberto com Robin Hood: quem está mais longe
+// da posição ideal "rouba" o slot de quem está mais perto,
+// o que mantém as sequências de sondagem curtas. Quando a
+// carga passa de 7/8 a tabela dobra, e as entradas antigas
+// são migradas aos poucos a cada inserção (sem pausas). Os
+// slots do crescimento seguinte também são limpos aos poucos
+// a partir de 3/4 da carga, e as entradas ficam em blocos que
+// não são copiados quando o armazenamento cresce.
+// -------------------------------------------------------
+
+// Byte de controle de um slot ocupado: 7 bits altos do hash
+unsigned char controleDoHash(unsigned int h) {
+    return (unsigned char)(h >> 25);
+}
+
+// Grava o byte de controle mantendo a cópia espelhada no fim
+void definirControle(SlotsHash *slots, unsigned int idx, unsigned char ctrl) {
+    slots->controle[idx] = ctrl;
+    if (idx < GRUPO_MAX) {
+        slots->controle[slots->capacidade + idx] = ctrl;
+    }
+}
+
+// -------------------------------------------------------
+// Comparação de grupos de bytes de controle
+// Cada variante compara 'larguraGrupo' bytes a partir de
+// 'ctrl' e devolve uma máscara (bit i = byte i igual ao
+// alvo); em 'vazios' fica a máscara dos slots livres.
+// Como só CTRL_VAZIO tem o bit alto ligado, os vazios são
+// exatamente o bit de sinal de cada byte.
+// -------------------------------------------------------
+unsigned int compararGrupoEscalar(const unsigned char *ctrl, unsigned char alvo,
+                                  unsigned int *vazios) {
+    unsigned int iguais = 0;
+    *vazios = 0;
+    for (unsigned int i = 0; i < 16; i++) {
+        if (ctrl[i] == alvo) iguais |= 1u << i;
+        if (ctrl[i] & CTRL_VAZIO) *vazios |= 1u << i;
+    }
+    return iguais;
+}
+
+#ifdef HASH_SIMD_X86
+__attribute__((target("sse2")))
+unsigned int compararGrupoSSE2(const unsigned char *ctrl, unsigned char alvo,
+                               unsigned int *vazios) {
+    __m128i grupo = _mm_loadu_si128((const __m128i *)ctrl);
+    *vazios = (unsigned int)_mm_movemask_epi8(grupo);
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(grupo, _mm_set1_epi8((char)alvo)));
+}
+
+__attribute__((target("avx2")))
+unsigned int compararGrupoAVX2(const unsigned char *ctrl, unsigned char alvo,
+                               unsigned int *vazios) {
+    __m256i grupo = _mm256_loadu_si256((const __m256i *)ctrl);
+    *vazios = (unsigned int)_mm256_movemask_epi8(grupo);
+    return (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(grupo, _mm256_set1_epi8((char)alvo)));
+}
+#endif
+
+// Variante em uso (escolhida por escolherGrupoHash)
+unsigned int (*compararGrupo)(const unsigned char *, unsigned char, unsigned int *) = NULL;
+unsigned int larguraGrupo = 16;
+
+// -------------------------------------------------------
+// Função: escolherGrupoHash
+// Consulta a CPU (CPUID) e escolhe a comparação mais larga
+// disponível; sem x86/GCC fica a versão escalar
+// -------------------------------------------------------
+void escolherGrupoHash(void) {
+    compararGrupo = compararGrupoEscalar;
+    larguraGrupo = 16;
+#ifdef HASH_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        compararGrupo = compararGrupoAVX2;
+        larguraGrupo = 32;
+    } else if (__builtin_cpu_supports("sse2")) {
+        compararGrupo = compararGrupoSSE2;
+        larguraGrupo = 16;
+    }
+#endif
+}
+
+// Pede ao processador para trazer 'endereco' para o cache
+void preCarregar(const void *endereco) {
+#if defined(__GNUC__)
+    __builtin_prefetch(endereco);
+#else
+    (void)endereco;
+#endif
+}
+
+// Posição do bit menos significativo ligado (mascara != 0)
+unsigned int menorBit(unsigned int mascara) {
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctz(mascara);
+#else
+    unsigned int i = 0;
+    while (!(mascara & 1u)) {
+        mascara >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Slots com os bytes de controle ainda por limpar
+void alocarSlotsSemLimpar(SlotsHash *slots, unsigned int capacidade) {
+    slots->controle = (unsigned char *)malloc(capacidade + GRUPO_MAX);
+    slots->pares = (ParSlot *)malloc(capacidade * sizeof(ParSlot));
+    if (slots->controle == NULL || slots->pares == NULL) {
+        printf("Erro ao alocar memoria para a tabela hash.\n");
+        exit(1);
+    }
+    slots->capacidade = capacidade;
+}
+
+void alocarSlotsHash(SlotsHash *slots, unsigned int capacidade) {
+    alocarSlotsSemLimpar(slots, capacidade);
+    memset(slots->controle, CTRL_VAZIO, capacidade + GRUPO_MAX);
+}
+
+void liberarSlotsHash(SlotsHash *slots) {
+    free(slots->controle);
+    free(slots->pares);
+    slots->controle = NULL;
+    slots->pares = NULL;
+    slots->capacidade = 0;
+}
+
+// -------------------------------------------------------
+// Funções do placar de suspeitos
+// -------------------------------------------------------
+void inicializarPlacar(PlacarSuspeitos *placar) {
+    placar->heap = NULL;
+    placar->tamHeap = 0;
+    placar->capacidade = 0;
+}
+
+void liberarPlacar(PlacarSuspeitos *placar) {
+    free(placar->heap);
+    inicializarPlacar(placar);
+}
+
+// 'a' fica acima de 'b' no heap? Empate: o suspeito que
+// apareceu antes no pool (handle menor) vence
+int precedeNoPlacar(const Suspeito *a, const Suspeito *b) {
+    return a->quantidade > b->quantidade || (a->quantidade == b->quantidade && a->nome < b->nome);
+}
+
+void trocarNoPlacar(PlacarSuspeitos *placar, unsigned int i, unsigned int j) {
+    Suspeito *tmp = placar->heap[i];
+    placar->heap[i] = placar->heap[j];
+    placar->heap[j] = tmp;
+    placar->heap[i]->posHeap = i;
+    placar->heap[j]->posHeap = j;
+}
+
+// Suspeito novo: entra no fim do heap, ainda sem pistas
+void entrarNoPlacar(PlacarSuspeitos *placar, Suspeito *s) {
+    if (placar->tamHeap == placar->capacidade) {
+        placar->capacidade = (placar->capacidade == 0) ? 16 : placar->capacidade * 2;
+        placar->heap = (Suspeito **)realocarOuSair(placar->heap, placar->capacidade * sizeof(Suspeito *));
+    }
+    s->posHeap = placar->tamHeap;
+    placar->heap[placar->tamHeap++] = s;
+}
+
+// -------------------------------------------------------
+// Função: ajustarPlacar
+// A quantidade de pistas do suspeito mudou: ele sobe ou
+// desce no heap. O(log S), com S = suspeitos distintos
+// -------------------------------------------------------
+void ajustarPlacar(PlacarSuspeitos *placar, Suspeito *s) {
+    unsigned int i = s->posHeap;
+
+    while (i > 0 && precedeNoPlacar(placar->heap[i], placar->heap[(i - 1) / 2])) {
+        trocarNoPlacar(placar, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    while (1) {
+        unsigned int maior = i;
+        unsigned int esq = 2 * i + 1;
+        unsigned int dir = 2 * i + 2;
+        if (esq < placar->tamHeap && precedeNoPlacar(placar->heap[esq], placar->heap[maior])) {
+            maior = esq;
+        }
+        if (dir < placar->tamHeap && precedeNoPlacar(placar->heap[dir], placar->heap[maior])) {
+            maior = dir;
+        }
+        if (maior == i) break;
+        trocarNoPlacar(placar, i, maior);
+        i = maior;
+    }
+}
+
+// Suspeito com mais pistas (TEXTO_INEXISTENTE se nenhum tem pista)
+HandleTexto suspeitoMaisProvavel(const PlacarSuspeitos *placar, int *contagem) {
+    if (placar->tamHeap == 0 || placar->heap[0]->quantidade == 0) {
+        *contagem = 0;
+        return TEXTO_INEXISTENTE;
+    }
+    *contagem = (int)placar->heap[0]->quantidade;
+    return placar->heap[0]->nome;
+}
+
+// -------------------------------------------------------
+// Funções do índice invertido suspeito -> pistas
+// -------------------------------------------------------
+void inicializarIndiceSuspeitos(IndiceSuspeitos *indice) {
+    indice->baldes = NULL;
+    indice->numBaldes = 0;
+    indice->numSuspeitos = 0;
+}
+
+void liberarIndiceSuspeitos(IndiceSuspeitos *indice) {
+    for (unsigned int b = 0; b < indice->numBaldes; b++) {
+        Suspeito *s = indice->baldes[b];
+        while (s != NULL) {
+            Suspeito *proximo = s->proximo;
+            free(s->pistas);
+            free(s);
+            s = proximo;
+        }
+    }
+    free(indice->baldes);
+    inicializarIndiceSuspeitos(indice);
+}
+
+Suspeito* buscarSuspeito(const IndiceSuspeitos *indice, HandleTexto nome) {
+    if (indice->numBaldes == 0 || nome == TEXTO_INEXISTENTE) return NULL;
+
+    Suspeito *s = indice->baldes[hashDe(nome) & (indice->numBaldes - 1)];
+    while (s != NULL && s->nome != nome) {
+        s = s->proximo;
+    }
+    return s;
+}
+
+// Dobra os baldes quando há mais suspeitos que baldes,
+// reaproveitando os nós (só os ponteiros mudam)
+void crescerIndiceSuspeitos(IndiceSuspeitos *indice) {
+    unsigned int novoNum = (indice->numBaldes == 0) ? 16 : indice->numBaldes * 2;
+    Suspeito **novos = (Suspeito **)calloc(novoNum, sizeof(Suspeito *));
+    if (novos == NULL) {
+        printf("Erro ao alocar memoria para o indice de suspeitos.\n");
+        exit(1);
+    }
+    for (unsigned int b = 0; b < indice->numBaldes; b++) {
+        Suspeito *s = indice->baldes[b];
+        while (s != NULL) {
+            Suspeito *proximo = s->proximo;
+            unsigned int destino = hashDe(s->nome) & (novoNum - 1);
+            s->proximo = novos[destino];
+            novos[destino] = s;
+            s = proximo;
+        }
+    }
+    free(indice->baldes);
+    indice->baldes = novos;
+    indice->numBaldes = novoNum;
+}
+
+Suspeito* obterSuspeito(IndiceSuspeitos *indice, HandleTexto nome) {
+    Suspeito *s = buscarSuspeito(indice, nome);
+    if (s != NULL) return s;
+
+    if (indice->numSuspeitos >= indice->numBaldes) {
+        crescerIndiceSuspeitos(indice);
+    }
+    s = (Suspeito *)malloc(sizeof(Suspeito));
+    if (s == NULL) {
+        printf("Erro ao alocar memoria para o indice de suspeitos.\n");
+        exit(1);
+    }
+    unsigned int b = hashDe(nome) & (indice->numBaldes - 1);
+    s->nome = nome;
+    s->pistas = NULL;
+    s->quantidade = 0;
+    s->capacidade = 0;
+    s->proximo = indice->baldes[b];
+    indice->baldes[b] = s;
+    indice->numSuspeitos++;
+    return s;
+}
+
+// Acrescenta a pista ao vetor do suspeito; devolve a posição
+unsigned int anexarPistaAoSuspeito(Suspeito *s, HandleTexto pista) {
+    if (s->quantidade == s->capacidade) {
+        s->capacidade = (s->capacidade == 0) ? 4 : s->capacidade * 2;
+        s->pistas = (HandleTexto *)realocarOuSair(s->pistas, s->capacidade * sizeof(HandleTexto));
+    }
+    s->pistas[s->quantidade] = pista;
+    return s->quantidade++;
+}
+
+// A tabela começa sem slots: os primeiros TAM_TABELA_HASH
+// são alocados na primeira inserção
+void inicializarHash(TabelaHash *tabela) {
+    if (compararGrupo == NULL) {
+        escolherGrupoHash();
+    }
+    tabela->atual.controle = NULL;
+    tabela->atual.pares = NULL;
+    tabela->atual.capacidade = 0;
+    tabela->ocupados = 0;
+    tabela->antiga.controle = NULL;
+    tabela->antiga.pares = NULL;
+    tabela->antiga.capacidade = 0;
+    tabela->posMigracao = 0;
+    tabela->proxima.controle = NULL;
+    tabela->proxima.pares = NULL;
+    tabela->proxima.capacidade = 0;
+    tabela->posLimpeza = 0;
+    tabela->numBlocos = 0;
+    tabela->quantidade = 0;
+    inicializarPlacar(&tabela->placar);
+    inicializarIndiceSuspeitos(&tabela->suspeitos);
+}
+
+void liberarHash(TabelaHash *tabela) {
+    liberarSlotsHash(&tabela->atual);
+    liberarSlotsHash(&tabela->antiga);
+    liberarSlotsHash(&tabela->proxima);
+    for (unsigned int b = 0; b < tabela->numBlocos; b++) {
+        free(tabela->blocos[b]);
+    }
+    tabela->numBlocos = 0;
+    tabela->ocupados = 0;
+    tabela->quantidade = 0;
+    liberarPlacar(&tabela->placar);
+    liberarIndiceSuspeitos(&tabela->suspeitos);
+}
+
+// A pista da entrada tem este texto? (o hash já bateu)
+int pistaTemTexto(HandleTexto pista, const char *texto, size_t tamanho) {
+    return poolTextos.entradas[pista].tamanho == tamanho && memcmp(textoDe(pista), texto, tamanho) == 0;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: buscarEntradaHash
+// Procura a pista nos slots e devolve o índice da entrada
+// (ou -1). Os bytes de controle são comparados em grupos de
+// 16 ou 32 (estilo "Swiss table"); o hash completo e o
+// handle da entrada ficam para os raros slots cujo fragmento
+// coincide. Com 'texto', a pista é procurada pelo texto (e
+// 'pista' é ignorada): a busca não passa pelo índice do pool.
+// Como não há remoções, a pista não pode estar depois do
+// primeiro slot vazio da sequência.
+// -------------------------------------------------------
+long buscarEntradaHash(const TabelaHash *tabela, const SlotsHash *slots, HandleTexto pista,
+                       const char *texto, size_t tamanho, unsigned int h) {
+    unsigned char ctrl = controleDoHash(h);
+    unsigned int cap = slots->capacidade;
+    unsigned int pos = h & (cap - 1);
+    unsigned int grupos = 0;
+
+    while (1) {
+        unsigned int vazios;
+        unsigned int iguais = compararGrupo(&slots->controle[pos], ctrl, &vazios);
+
+        grupos++;
+
+        if (vazios) {
+            iguais &= (vazios & (0u - vazios)) - 1; // só antes do primeiro vazio
+        }
+        while (iguais) {
+            unsigned int idx = pos + menorBit(iguais);
+            if (idx >= cap) idx -= cap;
+
+            if (slots->pares[idx].hash == h) {
+                unsigned int e = slots->pares[idx].indice;
+                HandleTexto candidata = entradaHash(tabela, e)->pista;
+                if ((texto == NULL) ? candidata == pista : pistaTemTexto(candidata, texto, tamanho)) {
+                    ESTAT_CUSTO(BUSCAS_HASH, GRUPOS_SONDADOS, MAIOR_SONDAGEM, grupos);
+                    return e;
+                }
+            }
+            iguais &= iguais - 1;
+        }
+        if (vazios) {
+            ESTAT_CUSTO(BUSCAS_HASH, GRUPOS_SONDADOS, MAIOR_SONDAGEM, grupos);
+            return -1;
+        }
+
+        pos += larguraGrupo;
+        if (pos >= cap) pos -= cap;
+    }
+}
+
+// -------------------------------------------------------
+// Função auxiliar: posicionarRobinHood
+// Coloca um slot (que sabidamente não está na tabela)
+// trocando de lugar com slots mais "ricos" pelo caminho.
+// A distância de cada slot vem do hash guardado em cache,
+// e só hash/índice se movem: as entradas ficam paradas.
+// -------------------------------------------------------
+void posicionarRobinHood(SlotsHash *slots, unsigned int h, unsigned int indice) {
+    unsigned int cap = slots->capacidade;
+    unsigned int idx = h & (cap - 1);
+    unsigned int distancia = 0;
+
+    while (slots->controle[idx] != CTRL_VAZIO) {
+        unsigned int casa = slots->pares[idx].hash & (cap - 1);
+        unsigned int distOcupante = (idx - casa) & (cap - 1);
+
+        if (distOcupante < distancia) {
+            ParSlot deslocado = slots->pares[idx];
+
+            definirControle(slots, idx, controleDoHash(h));
+            slots->pares[idx].hash = h;
+            slots->pares[idx].indice = indice;
+
+            h = deslocado.hash;
+            indice = deslocado.indice;
+            distancia = distOcupante;
+        }
+        if (++idx == cap) idx = 0;
+        distancia++;
+    }
+    definirControle(slots, idx, controleDoHash(h));
+    slots->pares[idx].hash = h;
+    slots->pares[idx].indice = indice;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: migrarHash
+// Move até 'passos' slots antigos para os slots atuais.
+// Os slots antigos não são apagados, para não quebrar as
+// sondagens das entradas que ainda não foram migradas.
+// -------------------------------------------------------
+void migrarHash(TabelaHash *tabela, unsigned int passos) {
+    while (tabela->antiga.capacidade != 0 && passos-- > 0) {
+        unsigned int pos = tabela->posMigracao;
+        if (tabela->antiga.controle[pos] != CTRL_VAZIO) {
+            posicionarRobinHood(&tabela->atual, tabela->antiga.pares[pos].hash,
+                                tabela->antiga.pares[pos].indice);
+            tabela->ocupados++;
+        }
+        if (++tabela->posMigracao == tabela->antiga.capacidade) {
+            liberarSlotsHash(&tabela->antiga);
+            tabela->posMigracao = 0;
+        }
+    }
+}
+
+// -------------------------------------------------------
+// Função auxiliar: prepararCrescimento
+// Passada a carga de 3/4, aloca os slots do próximo
+// crescimento e limpa LIMPAR_POR_INSERCAO bytes de controle
+// deles por inserção. Até a carga de 7/8 há pelo menos
+// capacidade/8 inserções, e são 2 * capacidade bytes: o
+// crescimento encontra os slots prontos (ou quase).
+// -------------------------------------------------------
+void prepararCrescimento(TabelaHash *tabela) {
+    SlotsHash *proxima = &tabela->proxima;
+
+    if ((unsigned long long)tabela->ocupados * 4 < (unsigned long long)tabela->atual.capacidade * 3) {
+        return;
+    }
+    if (proxima->capacidade == 0) {
+        alocarSlotsSemLimpar(proxima, tabela->atual.capacidade * 2);
+        tabela->posLimpeza = 0;
+    }
+
+    unsigned int total = proxima->capacidade + GRUPO_MAX;
+    if (tabela->posLimpeza < total) {
+        unsigned int n = total - tabela->posLimpeza;
+        if (n > LIMPAR_POR_INSERCAO) n = LIMPAR_POR_INSERCAO;
+        memset(proxima->controle + tabela->posLimpeza, CTRL_VAZIO, n);
+        tabela->posLimpeza += n;
+    }
+}
+
+// -------------------------------------------------------
+// Função auxiliar: crescerHash
+// Troca os slots atuais por outros com o dobro do tamanho
+// (ou pelos primeiros); os atuais passam a ser os "antigos"
+// e migram aos poucos. Os slots novos vêm de 'proxima',
+// já limpos por prepararCrescimento.
+// -------------------------------------------------------
+void crescerHash(TabelaHash *tabela) {
+    // Se ainda houver migração pendente, termina antes de crescer
+    migrarHash(tabela, tabela->antiga.capacidade);
+
+    tabela->antiga = tabela->atual;
+    tabela->posMigracao = 0;
+
+    if (tabela->antiga.capacidade == 0) {
+        alocarSlotsHash(&tabela->atual, TAM_TABELA_HASH);
+    } else {
+        if (tabela->proxima.capacidade != tabela->antiga.capacidade * 2) {
+            liberarSlotsHash(&tabela->proxima);
+            alocarSlotsSemLimpar(&tabela->proxima, tabela->antiga.capacidade * 2);
+            tabela->posLimpeza = 0;
+        }
+        tabela->atual = tabela->proxima;
+        memset(tabela->atual.controle + tabela->posLimpeza, CTRL_VAZIO,
+               tabela->atual.capacidade + GRUPO_MAX - tabela->posLimpeza);
+        tabela->proxima.controle = NULL;
+        tabela->proxima.pares = NULL;
+        tabela->proxima.capacidade = 0;
+        tabela->posLimpeza = 0;
+    }
+    tabela->ocupados = 0;
+}
+
+// -------------------------------------------------------
+// Função: entradaHash
+// Entrada pelo índice. O bloco k guarda os índices de
+// 16 * (2^k - 1) a 16 * (2^(k+1) - 1) - 1, então o bloco é
+// o maior bit de (índice + 16), menos 4.
+// -------------------------------------------------------
+HashEntry* entradaHash(const TabelaHash *tabela, unsigned int indice) {
+    unsigned int j = indice + (1u << BITS_PRIMEIRO_BLOCO);
+    unsigned int bloco = maiorBit(j) - BITS_PRIMEIRO_BLOCO;
+    return &tabela->blocos[bloco][j - (1u << (bloco + BITS_PRIMEIRO_BLOCO))];
+}
+
+// -------------------------------------------------------
+// Função auxiliar: novaEntradaHash
+// Acrescenta a pista ao armazenamento frio e devolve o índice.
+// Cheio o último bloco, aloca outro com o dobro do tamanho;
+// as entradas existentes nunca mudam de lugar.
+// -------------------------------------------------------
+unsigned int novaEntradaHash(TabelaHash *tabela, HandleTexto pista, HandleTexto suspeito) {
+    unsigned int capacidade = ((1u << tabela->numBlocos) - 1) << BITS_PRIMEIRO_BLOCO;
+    if (tabela->quantidade == capacidade) {
+        if (tabela->numBlocos == MAX_BLOCOS_ENTRADAS) {
+            printf("Tabela hash cheia!\n");
+            exit(1);
+        }
+        size_t tamanho = (size_t)1 << (tabela->numBlocos + BITS_PRIMEIRO_BLOCO);
+        tabela->blocos[tabela->numBlocos] = (HashEntry *)malloc(tamanho * sizeof(HashEntry));
+        if (tabela->blocos[tabela->numBlocos] == NULL) {
+            printf("Erro ao alocar memoria para a tabela hash.\n");
+            exit(1);
+        }
+        tabela->numBlocos++;
+    }
+
+    HashEntry *nova = entradaHash(tabela, tabela->quantidade);
+    nova->pista = pista;
+    nova->suspeito = suspeito;
+
+    return tabela->quantidade++;
+}
+
+// Procura a pista (pelo handle ou, com 'texto', pelo texto)
+// nos slots atuais e, durante uma migração, também nos antigos
+long localizarChaveHash(const TabelaHash *tabela, HandleTexto pista, const char *texto,
+                        size_t tamanho, unsigned int h) {
+    if (tabela->atual.capacidade == 0) {
+        return -1; // nenhuma inserção ainda
+    }
+    long e = buscarEntradaHash(tabela, &tabela->atual, pista, texto, tamanho, h);
+    if (e < 0 && tabela->antiga.capacidade != 0) {
+        e = buscarEntradaHash(tabela, &tabela->antiga, pista, texto, tamanho, h);
+    }
+    return e;
+}
+
+long localizarEntradaHash(const TabelaHash *tabela, HandleTexto pista, unsigned int h) {
+    return localizarChaveHash(tabela, pista, NULL, 0, h);
+}
+
+// -------------------------------------------------------
+// Índice invertido: põe a pista da entrada no vetor do seu
+// suspeito, ou a tira de lá trocando-a pela última (a
+// pista movida tem sua posição corrigida na entrada dela).
+// Nos dois casos o suspeito é reajustado no placar.
+// -------------------------------------------------------
+void indexarPista(TabelaHash *tabela, unsigned int entrada) {
+    HashEntry *e = entradaHash(tabela, entrada);
+    if (e->suspeito == TEXTO_VAZIO || e->suspeito == TEXTO_INEXISTENTE) return;
+
+    unsigned int antes = tabela->suspeitos.numSuspeitos;
+    Suspeito *s = obterSuspeito(&tabela->suspeitos, e->suspeito);
+    if (tabela->suspeitos.numSuspeitos != antes) {
+        entrarNoPlacar(&tabela->placar, s);
+    }
+    e->posNoSuspeito = anexarPistaAoSuspeito(s, e->pista);
+    ajustarPlacar(&tabela->placar, s);
+}
+
+void desindexarPista(TabelaHash *tabela, unsigned int entrada) {
+    HashEntry *e = entradaHash(tabela, entrada);
+    if (e->suspeito == TEXTO_VAZIO || e->suspeito == TEXTO_INEXISTENTE) return;
+
+    Suspeito *s = buscarSuspeito(&tabela->suspeitos, e->suspeito);
+    HandleTexto ultima = s->pistas[--s->quantidade];
+    if (e->posNoSuspeito < s->quantidade) {
+        s->pistas[e->posNoSuspeito] = ultima;
+        long movida = localizarEntradaHash(tabela, ultima, hashDe(ultima));
+        entradaHash(tabela, (unsigned int)movida)->posNoSuspeito = e->posNoSuspeito;
+    }
+    ajustarPlacar(&tabela->placar, s);
+}
+
+// -------------------------------------------------------
+// Função: pistasDoSuspeito
+// Vetor com as pistas que apontam para o suspeito (NULL e
+// quantidade 0 se nenhuma): custa o tamanho da resposta
+// -------------------------------------------------------
+const HandleTexto* pistasDoSuspeito(const TabelaHash *tabela, HandleTexto suspeito,
+                                    unsigned int *quantidade) {
+    const Suspeito *s = buscarSuspeito(&tabela->suspeitos, suspeito);
+    if (s == NULL || s->quantidade == 0) {
+        *quantidade = 0;
+        return NULL;
+    }
+    *quantidade = s->quantidade;
+    return s->pistas;
+}
+
+// -------------------------------------------------------
+// Função: inserirNaHashPorHandle
+// Insere associação pista -> suspeito na tabela hash
+// (se a pista já existir, apenas atualiza o suspeito) e
+// mantém o placar e o índice de suspeitos em dia.
+// O hash vem pronto do pool: nenhuma string é percorrida.
+// -------------------------------------------------------
+void inserirNaHashPorHandle(TabelaHash *tabela, HandleTexto pista, HandleTexto suspeito) {
+    if (pista == TEXTO_VAZIO || pista == TEXTO_INEXISTENTE) return;
+
+    unsigned int h = hashDe(pista);
+
+    long existente = localizarEntradaHash(tabela, pista, h);
+    if (existente >= 0) {
+        HashEntry *entrada = entradaHash(tabela, (unsigned int)existente);
+        HandleTexto anterior = entrada->suspeito;
+        if (anterior != suspeito) {
+            desindexarPista(tabela, (unsigned int)existente);
+            entrada->suspeito = suspeito;
+            indexarPista(tabela, (unsigned int)existente);
+        }
+        return;
+    }
+
+    if ((tabela->ocupados + 1) * CARGA_MAX_DEN > tabela->atual.capacidade * CARGA_MAX_NUM) {
+        crescerHash(tabela);
+    }
+
+    unsigned int indice = novaEntradaHash(tabela, pista, suspeito);
+    posicionarRobinHood(&tabela->atual, h, indice);
+    tabela->ocupados++;
+    indexarPista(tabela, indice);
+
+    migrarHash(tabela, MIGRAR_POR_INSERCAO);
+    prepararCrescimento(tabela);
+}
+
+// Versão com textos: interna pista e suspeito e insere
+void inserirNaHash(TabelaHash *tabela, const char *pista, const char *suspeito) {
+    if (pista == NULL || pista[0] == '\0') return;
+
+    HandleTexto hPista = internarTexto(pista, TAM_PISTA);
+    inserirNaHashPorHandle(tabela, hPista, internarTexto(suspeito, TAM_SUSPEITO));
+}
+
+// -------------------------------------------------------
+// Função auxiliar: reservarHash
+// Garante espaço para 'total' pistas sem crescer no meio de
+// um lote: termina a migração pendente e reposiciona tudo de
+// uma vez em slots do tamanho final
+// -------------------------------------------------------
+void reservarHash(TabelaHash *tabela, unsigned long long total) {
+    unsigned int novaCap = tabela->atual.capacidade;
+
+    if (total * CARGA_MAX_DEN <= (unsigned long long)novaCap * CARGA_MAX_NUM) {
+        return;
+    }
+    if (novaCap == 0) {
+        novaCap = TAM_TABELA_HASH;
+    }
+    while (total * CARGA_MAX_DEN > (unsigned long long)novaCap * CARGA_MAX_NUM) {
+        novaCap *= 2;
+    }
+
+    migrarHash(tabela, tabela->antiga.capacidade);
+    liberarSlotsHash(&tabela->proxima);
+    tabela->posLimpeza = 0;
+    SlotsHash velhos = tabela->atual;
+    alocarSlotsHash(&tabela->atual, novaCap);
+    tabela->ocupados = 0;
+    for (unsigned int pos = 0; pos < velhos.capacidade; pos++) {
+        if (velhos.controle[pos] != CTRL_VAZIO) {
+            posicionarRobinHood(&tabela->atual, velhos.pares[pos].hash, velhos.pares[pos].indice);
+            tabela->ocupados++;
+        }
+    }
+    liberarSlotsHash(&velhos);
+}
+
+// -------------------------------------------------------
+// Função: inserirNaHashEmLote
+// Insere n pares pista -> suspeito. A tabela é reservada
+// para o lote inteiro antes, e a cada LOTE_PREFETCH pares os
+// slots iniciais de todos são pedidos ao cache antes das
+// sondagens, para que as faltas de cache se sobreponham.
+// -------------------------------------------------------
+void inserirNaHashEmLote(TabelaHash *tabela, const HandleTexto *pistas,
+                         const HandleTexto *suspeitos, size_t n) {
+    reservarHash(tabela, (unsigned long long)tabela->quantidade + n);
+
+    for (size_t ini = 0; ini < n; ini += LOTE_PREFETCH) {
+        size_t fim = (ini + LOTE_PREFETCH < n) ? ini + LOTE_PREFETCH : n;
+        unsigned int cap = tabela->atual.capacidade;
+
+        for (size_t i = ini; i < fim; i++) {
+            if (pistas[i] == TEXTO_VAZIO || pistas[i] == TEXTO_INEXISTENTE) continue;
+            unsigned int pos = hashDe(pistas[i]) & (cap - 1);
+            preCarregar(&tabela->atual.controle[pos]);
+            preCarregar(&tabela->atual.pares[pos]);
+        }
+        for (size_t i = ini; i < fim; i++) {
+            inserirNaHashPorHandle(tabela, pistas[i], suspeitos[i]);
+        }
+    }
+}
+
+// -------------------------------------------------------
+// Função: encontrarSuspeitoPorHandle
+// Handle do suspeito associado a uma pista (ou
+// TEXTO_INEXISTENTE se a pista não estiver na tabela)
+// -------------------------------------------------------
+HandleTexto encontrarSuspeitoPorHandle(TabelaHash *tabela, HandleTexto pista) {
+    if (pista == TEXTO_VAZIO || pista == TEXTO_INEXISTENTE) return TEXTO_INEXISTENTE;
+
+    long e = localizarEntradaHash(tabela, pista, hashDe(pista));
+    return (e >= 0) ? entradaHash(tabela, (unsigned int)e)->suspeito : TEXTO_INEXISTENTE;
+}
+
+// -------------------------------------------------------
+// Função: encontrarSuspeito
+// Retorna o suspeito associado a uma pista (ou NULL se não
+// achar). O texto vai direto para a tabela, com o mesmo hash
+// que o pool lhe daria: procurar o handle no pool antes
+// custaria outra sondagem, com suas faltas de cache.
+// -------------------------------------------------------
+const char* encontrarSuspeito(TabelaHash *tabela, const char *pista) {
+    if (pista == NULL || pista[0] == '\0') return NULL;
+
+    ESTAT_AMOSTRA(inicio);
+    size_t tamanho = strlen(pista);
+    long e = localizarChaveHash(tabela, TEXTO_INEXISTENTE, pista, tamanho, hashTexto(pista, tamanho));
+    HandleTexto suspeito = (e >= 0) ? entradaHash(tabela, (unsigned int)e)->suspeito : TEXTO_INEXISTENTE;
+    ESTAT_FIM(BUSCA_SUSPEITO, inicio);
+    return (suspeito != TEXTO_INEXISTENTE) ? textoDe(suspeito) : NULL; // NULL = não encontrou
+}
+
+// Pistas distintas que apontam para o suspeito: o tamanho do
+// seu vetor no índice invertido
+int contagemDoSuspeito(const TabelaHash *tabela, HandleTexto suspeito) {
+    const Suspeito *s = buscarSuspeito(&tabela->suspeitos, suspeito);
+    return (s != NULL) ? (int)s->quantidade : 0;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: contarPistasPorSuspeito
+// Quantas pistas coletadas apontam para o suspeito. O índice
+// invertido já tem a conta: basta achar o handle do nome.
+// -------------------------------------------------------
+int contarPistasPorSuspeito(const TabelaHash *tabelaHash, const char *suspeitoAlvo) {
+    HandleTexto alvo = buscarTexto(suspeitoAlvo);
+
+    if (alvo == TEXTO_INEXISTENTE) {
+        return 0; // nome que não aparece em nenhuma sala
+    }
+    return contagemDoSuspeito(tabelaHash, alvo);
+}
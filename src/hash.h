@@ -0,0 +1,138 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include "textos.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HASH_SIMD_X86 1   // grupos SSE2/AVX2 escolhidos em tempo de execução
+#endif
+
+#define TAM_TABELA_HASH 64   // capacidade inicial (potência de dois, >= GRUPO_MAX); dobra sob demanda
+#define CARGA_MAX_NUM       7   // fator de carga máximo da hash: 7/8
+#define CARGA_MAX_DEN       8
+#define MIGRAR_POR_INSERCAO 16  // slots antigos migrados a cada inserção
+#define LIMPAR_POR_INSERCAO 64  // bytes de controle do próximo crescimento limpos a cada inserção
+#define BITS_PRIMEIRO_BLOCO 4   // o bloco k de entradas tem 2^(4+k) entradas
+#define MAX_BLOCOS_ENTRADAS 28  // blocos de entradas (cobrem todos os índices de 32 bits)
+#define CTRL_VAZIO          0x80  // byte de controle de slot livre
+#define GRUPO_MAX           32    // maior grupo de bytes de controle comparado de uma vez
+#define LOTE_PREFETCH       16           // inserções na hash com slots pré-carregados
+
+// -------------------------------------------------------
+// Entrada da tabela hash: pista -> suspeito
+// Fica no armazenamento "frio": só é lida depois que o byte
+// de controle e o hash completo do slot já bateram.
+// -------------------------------------------------------
+typedef struct HashEntry {
+    HandleTexto pista;
+    HandleTexto suspeito;
+    unsigned int posNoSuspeito;  // posição da pista no vetor do suspeito
+} HashEntry;
+
+// -------------------------------------------------------
+// Slots da tabela hash (dados "quentes", dois vetores)
+// controle: CTRL_VAZIO ou os 7 bits altos do hash da pista;
+// 64 slots cabem em uma única linha de cache. Os primeiros
+// GRUPO_MAX bytes são espelhados depois do fim, para que um
+// grupo que começa perto do final possa ser lido de uma vez.
+// pares: hash completo e entrada juntos, porque um acerto
+// no controle sempre lê os dois (uma falta de cache, não duas).
+// -------------------------------------------------------
+typedef struct ParSlot {
+    unsigned int hash;         // hash da pista (do pool; dá a distância)
+    unsigned int indice;       // posição da entrada em 'blocos'
+} ParSlot;
+
+typedef struct SlotsHash {
+    unsigned char *controle;   // byte de controle por slot
+    ParSlot *pares;            // hash e entrada de cada slot
+    unsigned int capacidade;   // 0 = sem slots
+} SlotsHash;
+
+// -------------------------------------------------------
+// Índice invertido suspeito -> pistas (o "Suspeito" do
+// algoritmos_avancados.c). Cada suspeito guarda um vetor
+// contíguo com os handles das pistas que apontam para ele;
+// os suspeitos ficam numa hash com listas encadeadas,
+// chaveada pelo hash do nome que já está no pool.
+// -------------------------------------------------------
+typedef struct Suspeito {
+    HandleTexto nome;
+    HandleTexto *pistas;       // pistas que apontam para o suspeito
+    unsigned int quantidade;   // também a chave do suspeito no placar
+    unsigned int capacidade;
+    unsigned int posHeap;      // posição no heap do placar
+    struct Suspeito *proximo;  // próximo suspeito no mesmo balde
+} Suspeito;
+
+// -------------------------------------------------------
+// Placar de suspeitos: heap de máximo com os suspeitos do
+// índice invertido, pela quantidade de pistas de cada um.
+// É reajustado sempre que o vetor de um suspeito muda, então
+// o "suspeito mais provável" não depende do número de
+// pistas, e o heap só tem uma posição por suspeito.
+// -------------------------------------------------------
+typedef struct PlacarSuspeitos {
+    Suspeito **heap;
+    unsigned int tamHeap;
+    unsigned int capacidade;
+} PlacarSuspeitos;
+
+typedef struct IndiceSuspeitos {
+    Suspeito **baldes;         // potência de dois
+    unsigned int numBaldes;
+    unsigned int numSuspeitos;
+} IndiceSuspeitos;
+
+// -------------------------------------------------------
+// Tabela hash redimensionável. Durante um crescimento, os
+// slots anteriores continuam válidos até serem migrados.
+// Os slots do crescimento seguinte são preparados aos
+// poucos, e as entradas ficam em blocos que nunca mudam de
+// lugar: nenhuma inserção copia ou limpa a tabela inteira.
+// -------------------------------------------------------
+typedef struct TabelaHash {
+    SlotsHash atual;
+    unsigned int ocupados;     // slots ocupados em 'atual'
+    SlotsHash antiga;          // slots em migração (capacidade 0 = nenhum)
+    unsigned int posMigracao;  // próximo slot antigo a migrar
+    SlotsHash proxima;         // slots do próximo crescimento (capacidade 0 = nenhum)
+    unsigned int posLimpeza;   // bytes de controle de 'proxima' já limpos
+    HashEntry *blocos[MAX_BLOCOS_ENTRADAS]; // armazenamento frio, cada bloco o dobro do anterior
+    unsigned int numBlocos;
+    unsigned int quantidade;   // total de pistas distintas
+    PlacarSuspeitos placar;    // suspeitos do índice por número de pistas
+    IndiceSuspeitos suspeitos; // índice invertido suspeito -> pistas
+} TabelaHash;
+
+void inicializarHash(TabelaHash *tabela);
+void inserirNaHash(TabelaHash *tabela, const char *pista, const char *suspeito);
+void inserirNaHashPorHandle(TabelaHash *tabela, HandleTexto pista, HandleTexto suspeito);
+void inserirNaHashEmLote(TabelaHash *tabela, const HandleTexto *pistas,
+                         const HandleTexto *suspeitos, size_t n);
+const char* encontrarSuspeito(TabelaHash *tabela, const char *pista);
+HandleTexto encontrarSuspeitoPorHandle(TabelaHash *tabela, HandleTexto pista);
+void liberarHash(TabelaHash *tabela);
+HashEntry* entradaHash(const TabelaHash *tabela, unsigned int indice);
+
+const HandleTexto* pistasDoSuspeito(const TabelaHash *tabela, HandleTexto suspeito,
+                                    unsigned int *quantidade);
+int contagemDoSuspeito(const TabelaHash *tabela, HandleTexto suspeito);
+HandleTexto suspeitoMaisProvavel(const PlacarSuspeitos *placar, int *contagem);
+int contarPistasPorSuspeito(const TabelaHash *tabelaHash, const char *suspeitoAlvo);
+
+// Comparação de grupos de bytes de controle: a variante em
+// uso fica em compararGrupo (escolhida por escolherGrupoHash)
+extern unsigned int (*compararGrupo)(const unsigned char *, unsigned char, unsigned int *);
+extern unsigned int larguraGrupo;
+void escolherGrupoHash(void);
+unsigned int compararGrupoEscalar(const unsigned char *ctrl, unsigned char alvo,
+                                  unsigned int *vazios);
+#ifdef HASH_SIMD_X86
+unsigned int compararGrupoSSE2(const unsigned char *ctrl, unsigned char alvo,
+                               unsigned int *vazios);
+unsigned int compararGrupoAVX2(const unsigned char *ctrl, unsigned char alvo,
+                               unsigned int *vazios);
+#endif
+
+#endif
@@ -0,0 +1,411 @@
+#include "lote.h"
+#include "arquivos.h"
+#include "estatisticas.h"
+
+// -------------------------------------------------------
+// Modo em lote
+// Cada linha do roteiro é uma sessão: movimentos 'e'/'d'
+// (espaços ignorados), depois 's' e o nome do acusado, como
+// em "eed s Mordomo". Sem 's' a exploração acaba no fim da
+// linha e não há julgamento. Linhas vazias ou iniciadas por
+// '#' são ignoradas. A saída tem uma linha por sessão:
+//   sessao <TAB> veredito <TAB> apontam <TAB> salas <TAB>
+//   invalidos <TAB> pistas separadas por '|' (ordem de coleta)
+// -------------------------------------------------------
+void inicializarLote(EstadoLote *lote) {
+    lote->numHandles = poolTextos.quantidade;
+    lote->marca = (unsigned int *)calloc(lote->numHandles, sizeof(unsigned int));
+    lote->suspeitoDe = (HandleTexto *)malloc(lote->numHandles * sizeof(HandleTexto));
+    lote->marcaSuspeito = (unsigned int *)calloc(lote->numHandles, sizeof(unsigned int));
+    lote->contagem = (int *)malloc(lote->numHandles * sizeof(int));
+    lote->capColetadas = 64;
+    lote->coletadas = (HandleTexto *)malloc(lote->capColetadas * sizeof(HandleTexto));
+    if (lote->marca == NULL || lote->suspeitoDe == NULL || lote->marcaSuspeito == NULL ||
+        lote->contagem == NULL || lote->coletadas == NULL) {
+        printf("Erro ao alocar memoria para o modo em lote.\n");
+        exit(1);
+    }
+    lote->numColetadas = 0;
+    lote->sessao = 0;
+    lote->movimentos = 0;
+}
+
+void liberarLote(EstadoLote *lote) {
+    free(lote->marca);
+    free(lote->suspeitoDe);
+    free(lote->marcaSuspeito);
+    free(lote->contagem);
+    free(lote->coletadas);
+    lote->marca = NULL;
+    lote->suspeitoDe = NULL;
+    lote->marcaSuspeito = NULL;
+    lote->contagem = NULL;
+    lote->coletadas = NULL;
+}
+
+// Mesma regra de explorarSalas: a pista entra uma vez e o
+// suspeito só é trocado quando a sala aponta para alguém.
+// As contagens por suspeito acompanham cada troca.
+void coletarNoLote(EstadoLote *lote, HandleTexto pista, HandleTexto suspeito) {
+    if (pista == TEXTO_VAZIO) return;
+
+    if (lote->marca[pista] != lote->sessao) {
+        if (lote->numColetadas == lote->capColetadas) {
+            lote->capColetadas *= 2;
+            lote->coletadas = (HandleTexto *)realocarOuSair(lote->coletadas,
+                                  lote->capColetadas * sizeof(HandleTexto));
+        }
+        lote->marca[pista] = lote->sessao;
+        lote->suspeitoDe[pista] = TEXTO_INEXISTENTE;
+        lote->coletadas[lote->numColetadas++] = pista;
+    }
+    if (suspeito != TEXTO_VAZIO && suspeito != lote->suspeitoDe[pista]) {
+        if (lote->suspeitoDe[pista] != TEXTO_INEXISTENTE) {
+            lote->contagem[lote->suspeitoDe[pista]]--;
+        }
+        if (lote->marcaSuspeito[suspeito] != lote->sessao) {
+            lote->marcaSuspeito[suspeito] = lote->sessao;
+            lote->contagem[suspeito] = 0;
+        }
+        lote->contagem[suspeito]++;
+        lote->suspeitoDe[pista] = suspeito;
+    }
+}
+
+// -------------------------------------------------------
+// Saída do modo em lote: cada bloco de sessões escreve no
+// seu próprio buffer, e os buffers são gravados em ordem
+// -------------------------------------------------------
+void escreverSaida(SaidaLote *saida, const char *texto, size_t tamanho) {
+    if (saida->usado + tamanho > saida->capacidade) {
+        size_t novaCap = (saida->capacidade == 0) ? 4096 : saida->capacidade * 2;
+        while (novaCap < saida->usado + tamanho) {
+            novaCap *= 2;
+        }
+        saida->dados = (char *)realocarOuSair(saida->dados, novaCap);
+        saida->capacidade = novaCap;
+    }
+    memcpy(saida->dados + saida->usado, texto, tamanho);
+    saida->usado += tamanho;
+}
+
+// -------------------------------------------------------
+// Função: executarSessaoLote
+// Roda a sessão 'numero' (linha [ini, fim) do roteiro) e
+// escreve o resultado em 'saida'
+// -------------------------------------------------------
+void executarSessaoLote(const Mansao *mansao, EstadoLote *lote, unsigned int numero,
+                        const char *ini, const char *fim, SaidaLote *saida) {
+    int atual = 0;
+    unsigned int salas = 1;
+    unsigned int invalidos = 0;
+    const char *acusado = NULL;
+
+    lote->sessao++;
+    lote->numColetadas = 0;
+    coletarNoLote(lote, pistaSala(mansao, 0), suspeitoSala(mansao, 0));
+
+    for (const char *c = ini; c < fim; c++) {
+        int proxima;
+
+        if (*c == ' ' || *c == '\t' || *c == '\r') continue;
+        lote->movimentos++;
+        if (*c == 's' || *c == 'S') {
+            acusado = c + 1;
+            break;
+        }
+        if (*c == 'e' || *c == 'E') {
+            proxima = salaEsq(mansao, atual);
+        } else if (*c == 'd' || *c == 'D') {
+            proxima = salaDir(mansao, atual);
+        } else {
+            proxima = SEM_SALA;
+        }
+        if (proxima == SEM_SALA) {
+            invalidos++;
+            continue;
+        }
+        atual = proxima;
+        salas++;
+        coletarNoLote(lote, pistaSala(mansao, atual), suspeitoSala(mansao, atual));
+    }
+
+    // Julgamento: o nome vai até o fim da linha, sem espaços
+    // nas pontas, e é truncado como no modo interativo
+    const char *veredito = "SEM_ACUSACAO";
+    int contador = 0;
+    if (acusado != NULL) {
+        char nome[TAM_SUSPEITO];
+        size_t len;
+
+        while (acusado < fim && (*acusado == ' ' || *acusado == '\t')) acusado++;
+        while (fim > acusado && (fim[-1] == ' ' || fim[-1] == '\t' || fim[-1] == '\r')) fim--;
+        len = (size_t)(fim - acusado);
+        if (len > TAM_SUSPEITO - 1) {
+            len = TAM_SUSPEITO - 1;
+        }
+        memcpy(nome, acusado, len);
+        nome[len] = '\0';
+
+        if (lote->numColetadas == 0) {
+            veredito = "SEM_PISTAS";
+        } else if (len > 0) {
+            HandleTexto alvo = buscarTexto(nome);
+            if (alvo != TEXTO_INEXISTENTE && lote->marcaSuspeito[alvo] == lote->sessao) {
+                contador = lote->contagem[alvo];
+            }
+            veredito = (contador >= 2) ? "SUSTENTADA" : (contador == 1) ? "DUVIDOSO" : "INOCENTE";
+        }
+    }
+
+    char cabecalho[128];
+    int tam = snprintf(cabecalho, sizeof(cabecalho), "%u\t%s\t%d\t%u\t%u\t",
+                       numero, veredito, contador, salas, invalidos);
+    escreverSaida(saida, cabecalho, (size_t)tam);
+    for (unsigned int i = 0; i < lote->numColetadas; i++) {
+        const char *pista = textoDe(lote->coletadas[i]);
+        if (i > 0) escreverSaida(saida, "|", 1);
+        escreverSaida(saida, pista, strlen(pista));
+    }
+    escreverSaida(saida, "\n", 1);
+}
+
+// -------------------------------------------------------
+// Travas das filas de blocos (sem threads, não fazem nada)
+// -------------------------------------------------------
+void iniciarTravaFila(FilaBlocos *fila) {
+#ifdef SEM_THREADS
+    (void)fila;
+#else
+    pthread_mutex_init(&fila->trava, NULL);
+#endif
+}
+
+void destruirTravaFila(FilaBlocos *fila) {
+#ifdef SEM_THREADS
+    (void)fila;
+#else
+    pthread_mutex_destroy(&fila->trava);
+#endif
+}
+
+void travarFila(FilaBlocos *fila) {
+#ifdef SEM_THREADS
+    (void)fila;
+#else
+    pthread_mutex_lock(&fila->trava);
+#endif
+}
+
+void destravarFila(FilaBlocos *fila) {
+#ifdef SEM_THREADS
+    (void)fila;
+#else
+    pthread_mutex_unlock(&fila->trava);
+#endif
+}
+
+// -------------------------------------------------------
+// Função: pegarBloco
+// O trabalhador tira o próximo bloco do início da sua fila;
+// se ela estiver vazia, rouba a metade final da fila de
+// outro trabalhador. Retorna 0 quando não há mais blocos.
+// -------------------------------------------------------
+int pegarBloco(ExecucaoLote *execucao, int id, unsigned int *bloco) {
+    FilaBlocos *minha = &execucao->filas[id];
+
+    travarFila(minha);
+    if (minha->inicio < minha->fim) {
+        *bloco = minha->inicio++;
+        destravarFila(minha);
+        return 1;
+    }
+    destravarFila(minha);
+
+    for (int i = 1; i < execucao->numTrabalhadores; i++) {
+        FilaBlocos *vitima = &execucao->filas[(id + i) % execucao->numTrabalhadores];
+        unsigned int inicio, fim;
+
+        travarFila(vitima);
+        inicio = vitima->inicio + (vitima->fim - vitima->inicio) / 2;
+        fim = vitima->fim;
+        vitima->fim = inicio;
+        destravarFila(vitima);
+
+        if (inicio < fim) {
+            // O primeiro bloco roubado é executado já; o resto
+            // vira a fila deste trabalhador
+            travarFila(minha);
+            minha->inicio = inicio + 1;
+            minha->fim = fim;
+            destravarFila(minha);
+            *bloco = inicio;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// -------------------------------------------------------
+// Função: trabalharLote
+// Corpo de cada trabalhador: a mansão e o pool de textos são
+// só lidos, então são compartilhados sem travas; o estado
+// das sessões (pistas coletadas) é próprio de cada um
+// -------------------------------------------------------
+void* trabalharLote(void *arg) {
+    TrabalhadorLote *trabalhador = (TrabalhadorLote *)arg;
+    ExecucaoLote *execucao = trabalhador->execucao;
+    EstadoLote lote;
+    unsigned int bloco;
+
+    inicializarLote(&lote);
+    while (pegarBloco(execucao, trabalhador->id, &bloco)) {
+        unsigned int primeira = bloco * SESSOES_POR_BLOCO;
+        unsigned int ultima = primeira + SESSOES_POR_BLOCO;
+        if (ultima > execucao->numSessoes) {
+            ultima = execucao->numSessoes;
+        }
+        for (unsigned int s = primeira; s < ultima; s++) {
+            ESTAT_AMOSTRA(sessao);
+            executarSessaoLote(execucao->mansao, &lote, s + 1, execucao->sessoes[s].ini,
+                               execucao->sessoes[s].fim, &execucao->saidas[bloco]);
+            ESTAT_FIM(SESSAO_LOTE, sessao);
+        }
+    }
+    trabalhador->movimentos = lote.movimentos;
+    liberarLote(&lote);
+    return NULL;
+}
+
+// Núcleos disponíveis (1 se não der para saber)
+int numeroDeNucleos(void) {
+#if defined(SEM_THREADS)
+    return 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+// -------------------------------------------------------
+// Função: executarLote
+// Mapeia o roteiro, separa as sessões e as divide em blocos
+// entre 'threads' trabalhadores (0 = um por núcleo). Não há
+// E/S por movimento; o resumo vai para stderr.
+// -------------------------------------------------------
+int executarLote(const Mansao *mansao, const char *roteiro, int threads) {
+    ExecucaoLote execucao;
+    size_t tamanho;
+    const char *dados;
+    unsigned int capSessoes = 1024;
+
+    if (mansao->quantidade == 0) {
+        printf("Nao ha salas na mansao.\n");
+        return 0;
+    }
+
+    dados = (const char *)mapearArquivo(roteiro, &tamanho);
+    if (dados == NULL) {
+        printf("Nao foi possivel ler o roteiro '%s'.\n", roteiro);
+        return 0;
+    }
+
+    // Separar as sessões (linhas não vazias que não são comentário)
+    execucao.mansao = mansao;
+    execucao.numSessoes = 0;
+    execucao.sessoes = (SessaoLote *)realocarOuSair(NULL, capSessoes * sizeof(SessaoLote));
+
+    const char *fimArquivo = dados + tamanho;
+    for (const char *linha = dados; linha < fimArquivo; ) {
+        const char *fim = (const char *)memchr(linha, '\n', (size_t)(fimArquivo - linha));
+        if (fim == NULL) {
+            fim = fimArquivo;
+        }
+
+        const char *c = linha;
+        while (c < fim && (*c == ' ' || *c == '\t' || *c == '\r')) c++;
+        if (c < fim && *c != '#') {
+            if (execucao.numSessoes == capSessoes) {
+                capSessoes *= 2;
+                execucao.sessoes = (SessaoLote *)realocarOuSair(execucao.sessoes,
+                                       capSessoes * sizeof(SessaoLote));
+            }
+            execucao.sessoes[execucao.numSessoes].ini = c;
+            execucao.sessoes[execucao.numSessoes].fim = fim;
+            execucao.numSessoes++;
+        }
+        linha = fim + 1;
+    }
+
+    execucao.numBlocos = (execucao.numSessoes + SESSOES_POR_BLOCO - 1) / SESSOES_POR_BLOCO;
+    execucao.saidas = (SaidaLote *)calloc(execucao.numBlocos + 1, sizeof(SaidaLote));
+
+    // Cada trabalhador começa com uma faixa contígua de blocos
+    if (threads <= 0) {
+        threads = numeroDeNucleos();
+    }
+#ifdef SEM_THREADS
+    threads = 1;
+#endif
+    if ((unsigned int)threads > execucao.numBlocos) {
+        threads = (execucao.numBlocos > 0) ? (int)execucao.numBlocos : 1;
+    }
+    execucao.numTrabalhadores = threads;
+    execucao.filas = (FilaBlocos *)calloc((size_t)threads, sizeof(FilaBlocos));
+    TrabalhadorLote *trabalhadores = (TrabalhadorLote *)calloc((size_t)threads, sizeof(TrabalhadorLote));
+    if (execucao.saidas == NULL || execucao.filas == NULL || trabalhadores == NULL) {
+        printf("Erro ao alocar memoria para o modo em lote.\n");
+        exit(1);
+    }
+    for (int i = 0; i < threads; i++) {
+        iniciarTravaFila(&execucao.filas[i]);
+        execucao.filas[i].inicio = (unsigned int)((unsigned long long)execucao.numBlocos * i / threads);
+        execucao.filas[i].fim = (unsigned int)((unsigned long long)execucao.numBlocos * (i + 1) / threads);
+        trabalhadores[i].execucao = &execucao;
+        trabalhadores[i].id = i;
+    }
+
+    double inicio = segundosAgora();
+#ifdef SEM_THREADS
+    trabalharLote(&trabalhadores[0]);
+#else
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&trabalhadores[i].thread, NULL, trabalharLote, &trabalhadores[i]) != 0) {
+            printf("Erro ao criar thread do modo em lote.\n");
+            exit(1);
+        }
+    }
+    trabalharLote(&trabalhadores[0]);
+    for (int i = 1; i < threads; i++) {
+        pthread_join(trabalhadores[i].thread, NULL);
+    }
+#endif
+    double segundos = segundosAgora() - inicio;
+
+    // Resultados na ordem do roteiro
+    unsigned long long movimentos = 0;
+    for (unsigned int b = 0; b < execucao.numBlocos; b++) {
+        fwrite(execucao.saidas[b].dados, 1, execucao.saidas[b].usado, stdout);
+        free(execucao.saidas[b].dados);
+    }
+    fflush(stdout);
+    for (int i = 0; i < threads; i++) {
+        movimentos += trabalhadores[i].movimentos;
+        destruirTravaFila(&execucao.filas[i]);
+    }
+
+    fprintf(stderr, "%u sessoes, %llu movimentos, %d thread(s) em %.3f s",
+            execucao.numSessoes, movimentos, threads, segundos);
+    if (segundos > 0) {
+        fprintf(stderr, " (%.0f sessoes/s, %.1f milhoes de movimentos/s)",
+                execucao.numSessoes / segundos, movimentos / segundos / 1e6);
+    }
+    fprintf(stderr, "\n");
+
+    free(trabalhadores);
+    free(execucao.filas);
+    free(execucao.saidas);
+    free(execucao.sessoes);
+    desmapearArquivo((void *)dados, tamanho);
+    return 1;
+}
@@ -0,0 +1,74 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "mansao.h"
+
+#define SESSOES_POR_BLOCO   64           // unidade de trabalho do modo em lote
+
+// -------------------------------------------------------
+// Estado do modo em lote: cada linha do roteiro é uma sessão.
+// Em vez de esvaziar árvore e hash a cada sessão, as pistas
+// são marcadas com o número da sessão em vetores indexados
+// pelo handle, então começar uma sessão nova custa O(1).
+// -------------------------------------------------------
+typedef struct EstadoLote {
+    unsigned int *marca;           // sessão em que a pista foi coletada
+    HandleTexto *suspeitoDe;       // suspeito da pista na sessão (último visto)
+    unsigned int *marcaSuspeito;   // sessão em que 'contagem' do suspeito vale
+    int *contagem;                 // pistas do suspeito na sessão
+    HandleTexto *coletadas;        // pistas da sessão, em ordem de coleta
+    unsigned int numColetadas;
+    unsigned int capColetadas;
+    unsigned int numHandles;       // tamanho de 'marca' e 'suspeitoDe'
+    unsigned int sessao;
+    unsigned long long movimentos; // movimentos lidos em todas as sessões
+} EstadoLote;
+
+// -------------------------------------------------------
+// Execução do lote em várias threads. As sessões são
+// agrupadas em blocos de SESSOES_POR_BLOCO; cada trabalhador
+// tem uma fila de blocos e, quando ela acaba, rouba metade
+// da fila de outro (work stealing).
+// -------------------------------------------------------
+typedef struct SessaoLote {
+    const char *ini;               // linha do roteiro [ini, fim)
+    const char *fim;
+} SessaoLote;
+
+typedef struct SaidaLote {
+    char *dados;
+    size_t usado;
+    size_t capacidade;
+} SaidaLote;
+
+typedef struct FilaBlocos {
+#ifndef SEM_THREADS
+    pthread_mutex_t trava;
+#endif
+    unsigned int inicio;           // blocos [inicio, fim) ainda não pegos
+    unsigned int fim;
+} FilaBlocos;
+
+typedef struct ExecucaoLote {
+    const Mansao *mansao;          // compartilhada, só leitura
+    SessaoLote *sessoes;
+    unsigned int numSessoes;
+    unsigned int numBlocos;
+    SaidaLote *saidas;             // uma por bloco
+    FilaBlocos *filas;             // uma por trabalhador
+    int numTrabalhadores;
+} ExecucaoLote;
+
+typedef struct TrabalhadorLote {
+    ExecucaoLote *execucao;
+    int id;
+#ifndef SEM_THREADS
+    pthread_t thread;
+#endif
+    unsigned long long movimentos;
+} TrabalhadorLote;
+
+int executarLote(const Mansao *mansao, const char *roteiro, int threads);
+int numeroDeNucleos(void);
+
+#endif
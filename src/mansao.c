@@ -0,0 +1,735 @@
+#include "mansao.h"
+#include "arquivos.h"
+#include "estatisticas.h"
+
+// -------------------------------------------------------
+// Função: criarSala
+// Cria na arena um cômodo com pista e suspeito associados
+// -------------------------------------------------------
+Sala* criarSala(Arena *arena, const char *nome, const char *pista, const char *suspeito) {
+    Sala *nova = (Sala *)alocarArena(arena, sizeof(Sala));
+
+    ESTAT_CONTAR(SALAS_CRIADAS, 1);
+    nova->nome = internarTexto(nome, TAM_NOME_SALA);
+    nova->pista = internarTexto(pista, TAM_PISTA);
+    nova->suspeito = internarTexto(suspeito, TAM_SUSPEITO);
+
+    nova->esq = NULL;
+    nova->dir = NULL;
+
+    return nova;
+}
+
+// -------------------------------------------------------
+// Funções da Mansão compacta
+// -------------------------------------------------------
+
+// -------------------------------------------------------
+// Acesso às salas pelo índice, nas duas formas da mansão.
+// Na implícita o índice é o slot e os filhos saem da conta.
+// -------------------------------------------------------
+HandleTexto nomeSala(const Mansao *mansao, int sala) {
+    return mansao->implicitas ? mansao->implicitas[sala].nome : mansao->salas[sala].nome;
+}
+
+HandleTexto pistaSala(const Mansao *mansao, int sala) {
+    return mansao->implicitas ? mansao->implicitas[sala].pista : mansao->salas[sala].pista;
+}
+
+HandleTexto suspeitoSala(const Mansao *mansao, int sala) {
+    return mansao->implicitas ? mansao->implicitas[sala].suspeito : mansao->salas[sala].suspeito;
+}
+
+// Slot do filho na forma implícita, se houver sala nele
+int filhoImplicito(const Mansao *mansao, unsigned int slot) {
+    return (slot < mansao->numSlots && mansao->implicitas[slot].nome != TEXTO_VAZIO)
+           ? (int)slot : SEM_SALA;
+}
+
+int salaEsq(const Mansao *mansao, int sala) {
+    if (mansao->implicitas) {
+        return filhoImplicito(mansao, 2u * (unsigned int)sala + 1);
+    }
+    return mansao->salas[sala].esq;
+}
+
+int salaDir(const Mansao *mansao, int sala) {
+    if (mansao->implicitas) {
+        return filhoImplicito(mansao, 2u * (unsigned int)sala + 2);
+    }
+    return mansao->salas[sala].dir;
+}
+
+// -------------------------------------------------------
+// Função: percorrerMansao
+// Visita todas as salas em pré-ordem com uma pilha explícita
+// de 'mansao->quantidade' posições, fornecida por quem chama:
+// nada de recursão, então uma cadeia de milhões de salas não
+// estoura a pilha do processo. Retorna quantas salas visitou.
+// -------------------------------------------------------
+unsigned int percorrerMansao(const Mansao *mansao, int *pilha, VisitaSala visitar, void *contexto) {
+    unsigned int visitadas = 0;
+    int topo = 0;
+
+    if (mansao->quantidade == 0) return 0;
+
+    pilha[topo++] = 0;
+    while (topo > 0) {
+        int sala = pilha[--topo];
+        int esq = salaEsq(mansao, sala);
+        int dir = salaDir(mansao, sala);
+
+        visitar(mansao, sala, contexto);
+        visitadas++;
+        if (dir != SEM_SALA) pilha[topo++] = dir;
+        if (esq != SEM_SALA) pilha[topo++] = esq;
+    }
+    return visitadas;
+}
+
+// -------------------------------------------------------
+// Função: compactarMansao
+// Converte a árvore montada com criarSala para o vetor
+// compacto, em ordem de largura (raiz no índice 0). Usa uma
+// fila no próprio vetor, sem recursão.
+// -------------------------------------------------------
+void compactarMansao(Sala *raiz, Mansao *mansao) {
+    unsigned int capacidade = 64;
+    unsigned int quantidade = 0;
+    Sala **fila = (Sala **)malloc(capacidade * sizeof(Sala *));
+    SalaCompacta *salas = (SalaCompacta *)malloc(capacidade * sizeof(SalaCompacta));
+
+    if (fila == NULL || salas == NULL) {
+        printf("Erro ao alocar memoria para a mansao.\n");
+        exit(1);
+    }
+
+    if (raiz != NULL) {
+        fila[quantidade++] = raiz;
+    }
+
+    for (unsigned int i = 0; i < quantidade; i++) {
+        Sala *sala = fila[i];
+
+        // Cada sala enfileira no máximo dois filhos
+        if (quantidade + 2 > capacidade) {
+            capacidade *= 2;
+            fila = (Sala **)realloc(fila, capacidade * sizeof(Sala *));
+            salas = (SalaCompacta *)realloc(salas, capacidade * sizeof(SalaCompacta));
+            if (fila == NULL || salas == NULL) {
+                printf("Erro ao alocar memoria para a mansao.\n");
+                exit(1);
+            }
+        }
+
+        salas[i].nome = sala->nome;
+        salas[i].pista = sala->pista;
+        salas[i].suspeito = sala->suspeito;
+        salas[i].esq = SEM_SALA;
+        salas[i].dir = SEM_SALA;
+
+        if (sala->esq != NULL) {
+            salas[i].esq = (int)quantidade;
+            fila[quantidade++] = sala->esq;
+        }
+        if (sala->dir != NULL) {
+            salas[i].dir = (int)quantidade;
+            fila[quantidade++] = sala->dir;
+        }
+    }
+
+    free(fila);
+    mansao->salas = salas;
+    mansao->implicitas = NULL;
+    mansao->quantidade = quantidade;
+    mansao->numSlots = 0;
+    mansao->mapa = NULL;
+    mansao->tamMapa = 0;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: validarMansao
+// Confere se os filhos formam uma árvore com raiz na sala 0:
+// índices válidos, no máximo um pai por sala e todas as
+// salas alcançáveis a partir da raiz
+// -------------------------------------------------------
+int validarMansao(const SalaCompacta *salas, unsigned int quantidade) {
+    unsigned char *temPai = (unsigned char *)calloc(quantidade ? quantidade : 1, 1);
+    int ok = 1;
+
+    if (temPai == NULL) {
+        printf("Erro ao alocar memoria para a mansao.\n");
+        exit(1);
+    }
+
+    for (unsigned int i = 0; i < quantidade && ok; i++) {
+        int filhos[2] = { salas[i].esq, salas[i].dir };
+        for (int f = 0; f < 2; f++) {
+            if (filhos[f] == SEM_SALA) continue;
+            if (filhos[f] <= 0 || (unsigned int)filhos[f] >= quantidade || temPai[filhos[f]]) {
+                printf("Mansao invalida: a sala %u tem um filho invalido (%d).\n", i, filhos[f]);
+                ok = 0;
+                break;
+            }
+            temPai[filhos[f]] = 1;
+        }
+    }
+
+    // Com um pai por sala e a raiz sem pai, basta contar as
+    // salas alcançáveis para descartar ciclos soltos
+    if (ok && quantidade > 0) {
+        unsigned int *pilha = (unsigned int *)malloc(quantidade * sizeof(unsigned int));
+        unsigned int topo = 0, visitadas = 0;
+        if (pilha == NULL) {
+            printf("Erro ao alocar memoria para a mansao.\n");
+            exit(1);
+        }
+        pilha[topo++] = 0;
+        while (topo > 0) {
+            unsigned int i = pilha[--topo];
+            visitadas++;
+            if (salas[i].esq != SEM_SALA) pilha[topo++] = (unsigned int)salas[i].esq;
+            if (salas[i].dir != SEM_SALA) pilha[topo++] = (unsigned int)salas[i].dir;
+        }
+        free(pilha);
+        if (visitadas != quantidade) {
+            printf("Mansao invalida: %u sala(s) nao sao alcancaveis a partir da sala 0.\n",
+                   quantidade - visitadas);
+            ok = 0;
+        }
+    }
+
+    free(temPai);
+    return ok;
+}
+
+// Separa o próximo campo de uma linha "a|b|c" (altera a linha)
+char* proximoCampo(char **cursor) {
+    char *inicio = *cursor;
+    if (inicio == NULL) {
+        return NULL;
+    }
+    char *barra = strchr(inicio, '|');
+    if (barra != NULL) {
+        *barra = '\0';
+        *cursor = barra + 1;
+    } else {
+        *cursor = NULL;
+    }
+    return inicio;
+}
+
+// Lê o índice de um filho: "-" (ou vazio) = sem filho
+int lerFilho(const char *campo, int *filho) {
+    char *fim;
+
+    if (campo == NULL) {
+        return 0;
+    }
+    if (campo[0] == '\0' || strcmp(campo, "-") == 0) {
+        *filho = SEM_SALA;
+        return 1;
+    }
+    long valor = strtol(campo, &fim, 10);
+    if (*fim != '\0' || valor < 0 || valor > 0x7FFFFFFFL) {
+        return 0;
+    }
+    *filho = (int)valor;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: carregarMansaoTexto
+// Lê uma mansão no formato texto, uma sala por linha:
+//     id|nome|pista|suspeito|esq|dir
+// 'id' vai de 0 a N-1 (0 é o Hall de Entrada), pista e
+// suspeito podem ficar vazios e "-" indica filho ausente.
+// Linhas vazias ou começando com '#' são ignoradas.
+// Retorna 1 em caso de sucesso e 0 em caso de erro.
+// -------------------------------------------------------
+int carregarMansaoTexto(const char *caminho, Mansao *mansao) {
+    FILE *arquivo = fopen(caminho, "r");
+    char linha[TAM_LINHA_MANSAO];
+    SalaCompacta *salas = NULL;
+    unsigned char *definida = NULL;
+    unsigned int capacidade = 0, quantidade = 0, numLinha = 0;
+
+    if (arquivo == NULL) {
+        printf("Nao foi possivel abrir '%s'.\n", caminho);
+        return 0;
+    }
+
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numLinha++;
+        linha[strcspn(linha, "\r\n")] = '\0';
+        if (linha[0] == '\0' || linha[0] == '#') continue;
+
+        char *cursor = linha;
+        char *campoId = proximoCampo(&cursor);
+        char *nome = proximoCampo(&cursor);
+        char *pista = proximoCampo(&cursor);
+        char *suspeito = proximoCampo(&cursor);
+        char *campoEsq = proximoCampo(&cursor);
+        char *campoDir = proximoCampo(&cursor);
+        int id, esq, dir;
+
+        if (campoDir == NULL || cursor != NULL || !lerFilho(campoId, &id) || id == SEM_SALA ||
+            !lerFilho(campoEsq, &esq) || !lerFilho(campoDir, &dir) || nome[0] == '\0') {
+            printf("%s:%u: linha invalida (esperado id|nome|pista|suspeito|esq|dir).\n",
+                   caminho, numLinha);
+            fclose(arquivo);
+            free(salas);
+            free(definida);
+            return 0;
+        }
+
+        if ((unsigned int)id >= capacidade) {
+            unsigned int novaCap = (capacidade == 0) ? 64 : capacidade;
+            while ((unsigned int)id >= novaCap) novaCap *= 2;
+            salas = (SalaCompacta *)realloc(salas, novaCap * sizeof(SalaCompacta));
+            definida = (unsigned char *)realloc(definida, novaCap);
+            if (salas == NULL || definida == NULL) {
+                printf("Erro ao alocar memoria para a mansao.\n");
+                exit(1);
+            }
+            memset(&definida[capacidade], 0, novaCap - capacidade);
+            capacidade = novaCap;
+        }
+        if (definida[id]) {
+            printf("%s:%u: sala %d definida duas vezes.\n", caminho, numLinha, id);
+            fclose(arquivo);
+            free(salas);
+            free(definida);
+            return 0;
+        }
+
+        definida[id] = 1;
+        salas[id].nome = internarTexto(nome, TAM_NOME_SALA);
+        salas[id].pista = internarTexto(pista, TAM_PISTA);
+        salas[id].suspeito = internarTexto(suspeito, TAM_SUSPEITO);
+        salas[id].esq = esq;
+        salas[id].dir = dir;
+        if ((unsigned int)id + 1 > quantidade) {
+            quantidade = (unsigned int)id + 1;
+        }
+    }
+    fclose(arquivo);
+
+    for (unsigned int i = 0; i < quantidade; i++) {
+        if (!definida[i]) {
+            printf("%s: a sala %u nao foi definida.\n", caminho, i);
+            free(salas);
+            free(definida);
+            return 0;
+        }
+    }
+    free(definida);
+
+    if (quantidade == 0 || !validarMansao(salas, quantidade)) {
+        if (quantidade == 0) printf("%s: nenhuma sala encontrada.\n", caminho);
+        free(salas);
+        return 0;
+    }
+
+    mansao->salas = salas;
+    mansao->implicitas = NULL;
+    mansao->quantidade = quantidade;
+    mansao->numSlots = 0;
+    mansao->mapa = NULL;
+    mansao->tamMapa = 0;
+    return 1;
+}
+
+// Escreve um texto do pool verificando se cabe no formato
+int escreverCampoTexto(FILE *arquivo, HandleTexto handle) {
+    const char *texto = textoDe(handle);
+    if (strpbrk(texto, "|\r\n") != NULL) {
+        printf("O texto \"%s\" contem '|' ou quebra de linha e nao cabe no formato texto.\n", texto);
+        return 0;
+    }
+    fputs(texto, arquivo);
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: salvarMansaoTexto
+// Grava a mansão no formato lido por carregarMansaoTexto
+// -------------------------------------------------------
+int salvarMansaoTexto(const Mansao *mansao, const char *caminho) {
+    FILE *arquivo;
+    int ok = 1;
+
+    if (mansao->salas == NULL) {
+        printf("Apenas a forma explicita da mansao pode ser gravada.\n");
+        return 0;
+    }
+
+    arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) {
+        printf("Nao foi possivel criar '%s'.\n", caminho);
+        return 0;
+    }
+
+    fprintf(arquivo, "# id|nome|pista|suspeito|esq|dir\n");
+    for (unsigned int i = 0; i < mansao->quantidade && ok; i++) {
+        const SalaCompacta *sala = &mansao->salas[i];
+        fprintf(arquivo, "%u|", i);
+        ok = escreverCampoTexto(arquivo, sala->nome) && fputc('|', arquivo) != EOF &&
+             escreverCampoTexto(arquivo, sala->pista) && fputc('|', arquivo) != EOF &&
+             escreverCampoTexto(arquivo, sala->suspeito);
+        if (sala->esq == SEM_SALA) fprintf(arquivo, "|-"); else fprintf(arquivo, "|%d", sala->esq);
+        if (sala->dir == SEM_SALA) fprintf(arquivo, "|-\n"); else fprintf(arquivo, "|%d\n", sala->dir);
+    }
+
+    if (fclose(arquivo) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        printf("Erro ao gravar '%s'.\n", caminho);
+    }
+    return ok;
+}
+
+// -------------------------------------------------------
+// Função: gravarMansaoBinaria
+// Grava as salas e uma imagem do pool de textos (entradas,
+// índice e textos) no arquivo aberto, a partir da posição 0.
+// Carregar essa imagem é só mapeá-la.
+// -------------------------------------------------------
+int gravarMansaoBinaria(const Mansao *mansao, FILE *arquivo) {
+    CabecalhoMansao cab;
+
+    if (poolTextos.quantidade == 0) {
+        internarTexto("", 1); // garante o handle TEXTO_VAZIO
+    }
+
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magico, MAGICO_MANSAO, 8);
+    cab.numSalas = mansao->quantidade;
+    cab.numTextos = poolTextos.quantidade;
+    cab.capIndice = poolTextos.capIndice;
+    cab.versaoHash = VERSAO_HASH_TEXTO;
+    cab.tamTextos = poolTextos.usoTextos;
+    cab.desSalas = alinhar8(sizeof(cab));
+    cab.desEntradas = alinhar8(cab.desSalas + (unsigned long long)cab.numSalas * sizeof(SalaCompacta));
+    cab.desIndice = alinhar8(cab.desEntradas + (unsigned long long)cab.numTextos * sizeof(EntradaPool));
+    cab.desTextos = alinhar8(cab.desIndice + (unsigned long long)cab.capIndice * sizeof(HandleTexto));
+
+    return gravarBloco(arquivo, &cab, sizeof(cab), cab.desSalas) &&
+           gravarBloco(arquivo, mansao->salas, cab.numSalas * sizeof(SalaCompacta), cab.desEntradas) &&
+           gravarBloco(arquivo, poolTextos.entradas, cab.numTextos * sizeof(EntradaPool), cab.desIndice) &&
+           gravarBloco(arquivo, poolTextos.indice, cab.capIndice * sizeof(HandleTexto), cab.desTextos) &&
+           gravarBloco(arquivo, poolTextos.textos, (size_t)cab.tamTextos, cab.desTextos + cab.tamTextos);
+}
+
+// -------------------------------------------------------
+// Função: salvarMansaoBinaria
+// Grava a imagem binária da mansão em 'caminho'
+// -------------------------------------------------------
+int salvarMansaoBinaria(const Mansao *mansao, const char *caminho) {
+    FILE *arquivo;
+    int ok;
+
+    if (mansao->salas == NULL) {
+        printf("Apenas a forma explicita da mansao pode ser gravada.\n");
+        return 0;
+    }
+
+    arquivo = fopen(caminho, "wb");
+    if (arquivo == NULL) {
+        printf("Nao foi possivel criar '%s'.\n", caminho);
+        return 0;
+    }
+
+    ok = gravarMansaoBinaria(mansao, arquivo);
+    if (fclose(arquivo) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        printf("Erro ao gravar '%s'.\n", caminho);
+    }
+    return ok;
+}
+
+// Confere a assinatura e se os blocos cabem na imagem
+int cabecalhoMansaoValido(const CabecalhoMansao *cab, size_t tamanho) {
+    return tamanho >= sizeof(*cab) && memcmp(cab->magico, MAGICO_MANSAO, 8) == 0 &&
+           cab->numSalas != 0 && cab->numTextos != 0 &&
+           cab->capIndice != 0 && (cab->capIndice & (cab->capIndice - 1)) == 0 &&
+           blocoValido(cab->desSalas, (unsigned long long)cab->numSalas * sizeof(SalaCompacta), tamanho) &&
+           blocoValido(cab->desEntradas, (unsigned long long)cab->numTextos * sizeof(EntradaPool), tamanho) &&
+           blocoValido(cab->desIndice, (unsigned long long)cab->capIndice * sizeof(HandleTexto), tamanho) &&
+           blocoValido(cab->desTextos, cab->tamTextos, tamanho);
+}
+
+// -------------------------------------------------------
+// Função: validarImagemMansao
+// Confere o conteúdo de uma imagem vinda de fora: os textos
+// do pool terminam em '\0' dentro do bloco de textos, os
+// handles das salas e do índice existem, o índice tem slot
+// livre e os filhos formam uma árvore (validarMansao). Uma
+// passada O(n), feita uma vez antes de adotar a imagem.
+// -------------------------------------------------------
+int validarImagemMansao(const void *dados, size_t tamanho) {
+    const CabecalhoMansao *cab = (const CabecalhoMansao *)dados;
+
+    if (!cabecalhoMansaoValido(cab, tamanho)) {
+        return 0;
+    }
+
+    const SalaCompacta *salas = (const SalaCompacta *)((const char *)dados + cab->desSalas);
+    const EntradaPool *entradas = (const EntradaPool *)((const char *)dados + cab->desEntradas);
+    const HandleTexto *indice = (const HandleTexto *)((const char *)dados + cab->desIndice);
+    const char *textos = (const char *)dados + cab->desTextos;
+
+    for (unsigned int h = 0; h < cab->numTextos; h++) {
+        unsigned long long fim = (unsigned long long)entradas[h].deslocamento + entradas[h].tamanho;
+        if (fim >= cab->tamTextos || textos[fim] != '\0') {
+            printf("Mansao invalida: o texto %u sai do bloco de textos.\n", h);
+            return 0;
+        }
+    }
+    unsigned int ocupados = 0;
+    for (unsigned int pos = 0; pos < cab->capIndice; pos++) {
+        if (indice[pos] >= cab->numTextos) {
+            printf("Mansao invalida: o indice do pool aponta para o texto %u.\n", indice[pos]);
+            return 0;
+        }
+        ocupados += indice[pos] != 0;
+    }
+    if (ocupados == cab->capIndice) {
+        printf("Mansao invalida: o indice do pool nao tem slot livre.\n");
+        return 0;
+    }
+    for (unsigned int i = 0; i < cab->numSalas; i++) {
+        if (salas[i].nome >= cab->numTextos || salas[i].pista >= cab->numTextos ||
+            salas[i].suspeito >= cab->numTextos) {
+            printf("Mansao invalida: a sala %u usa um texto inexistente.\n", i);
+            return 0;
+        }
+    }
+    return validarMansao(salas, cab->numSalas);
+}
+
+// -------------------------------------------------------
+// Função: adotarMansaoBinaria
+// Usa salas e pool direto da imagem em memória (arquivo
+// mapeado ou embutida no executável): só o cabeçalho é
+// conferido, então o tempo não depende do número de salas.
+// O conteúdo não é revalidado: imagens de fora passam antes
+// por validarImagemMansao, e o pool de textos precisa estar
+// vazio. Retorna 0 se o cabeçalho não é válido.
+// -------------------------------------------------------
+int adotarMansaoBinaria(void *dados, size_t tamanho, Mansao *mansao) {
+    const CabecalhoMansao *cab = (const CabecalhoMansao *)dados;
+
+    if (!cabecalhoMansaoValido(cab, tamanho)) {
+        return 0;
+    }
+
+    // O pool passa a usar os vetores da imagem
+    poolTextos.entradas = (EntradaPool *)((char *)dados + cab->desEntradas);
+    poolTextos.quantidade = cab->numTextos;
+    poolTextos.capacidade = cab->numTextos;
+    poolTextos.textos = (char *)dados + cab->desTextos;
+    poolTextos.usoTextos = (size_t)cab->tamTextos;
+    poolTextos.capTextos = (size_t)cab->tamTextos;
+    poolTextos.indice = (HandleTexto *)((char *)dados + cab->desIndice);
+    poolTextos.capIndice = cab->capIndice;
+    poolTextos.emprestado = 1;
+
+    // Imagem gravada com outra função de hash: os hashes do
+    // pool são refeitos numa cópia própria (as salas continuam
+    // na imagem, os handles não mudam)
+    if (cab->versaoHash != VERSAO_HASH_TEXTO) {
+        tornarPoolProprio();
+        for (HandleTexto h = 0; h < poolTextos.quantidade; h++) {
+            EntradaPool *e = &poolTextos.entradas[h];
+            e->hash = hashTexto(&poolTextos.textos[e->deslocamento], e->tamanho);
+        }
+        reconstruirIndicePool(poolTextos.capIndice);
+    }
+
+    mansao->salas = (const SalaCompacta *)((char *)dados + cab->desSalas);
+    mansao->implicitas = NULL;
+    mansao->quantidade = cab->numSalas;
+    mansao->numSlots = 0;
+    mansao->mapa = dados;
+    mansao->tamMapa = tamanho;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: carregarMansaoBinaria
+// Mapeia o arquivo, confere a imagem inteira (o arquivo vem
+// do usuário) e a adota
+// -------------------------------------------------------
+int carregarMansaoBinaria(const char *caminho, Mansao *mansao) {
+    size_t tamanho;
+    void *mapa;
+
+    if (poolTextos.quantidade != 0) {
+        printf("O pool de textos ja esta em uso; carregue a mansao binaria antes de tudo.\n");
+        return 0;
+    }
+
+    mapa = mapearArquivo(caminho, &tamanho);
+    if (mapa == NULL) {
+        printf("Nao foi possivel abrir '%s'.\n", caminho);
+        return 0;
+    }
+    if (!validarImagemMansao(mapa, tamanho) || !adotarMansaoBinaria(mapa, tamanho, mansao)) {
+        printf("'%s' nao e um arquivo de mansao valido.\n", caminho);
+        desmapearArquivo(mapa, tamanho);
+        return 0;
+    }
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: carregarMansao
+// Detecta o formato pela assinatura e carrega o arquivo
+// -------------------------------------------------------
+int carregarMansao(const char *caminho, Mansao *mansao) {
+    char magico[8];
+    FILE *arquivo = fopen(caminho, "rb");
+    int binario;
+
+    if (arquivo == NULL) {
+        printf("Nao foi possivel abrir '%s'.\n", caminho);
+        return 0;
+    }
+    binario = fread(magico, 1, 8, arquivo) == 8 && memcmp(magico, MAGICO_MANSAO, 8) == 0;
+    fclose(arquivo);
+
+    return binario ? carregarMansaoBinaria(caminho, mansao)
+                   : carregarMansaoTexto(caminho, mansao);
+}
+
+// -------------------------------------------------------
+// Função: tornarMansaoImplicita
+// Troca a forma explícita pela implícita. Cada sala vai
+// para o slot 2p+1 ou 2p+2 do pai p; se a árvore for tão
+// desequilibrada que o vetor passaria de FOLGA_IMPLICITA
+// vezes o número de salas, nada muda e a função retorna 0.
+// -------------------------------------------------------
+int tornarMansaoImplicita(Mansao *mansao) {
+    unsigned int n = mansao->quantidade;
+    unsigned long long limite = (unsigned long long)n * FOLGA_IMPLICITA + 16;
+    unsigned long long *slotDe;
+    unsigned long long numSlots = 0;
+
+    if (mansao->implicitas != NULL || n == 0) {
+        return mansao->implicitas != NULL;
+    }
+
+    // Primeira passada: o slot de cada sala. Na forma
+    // explícita os pais sempre vêm antes dos filhos quando a
+    // mansão foi montada por compactarMansao, mas arquivos
+    // em texto podem ter qualquer ordem: usamos uma pilha.
+    slotDe = (unsigned long long *)malloc(n * sizeof(unsigned long long));
+    int *pilha = (int *)malloc(n * sizeof(int));
+    if (slotDe == NULL || pilha == NULL) {
+        printf("Erro ao alocar memoria para a mansao.\n");
+        exit(1);
+    }
+
+    int topo = 0;
+    pilha[topo++] = 0;
+    slotDe[0] = 0;
+    while (topo > 0) {
+        int sala = pilha[--topo];
+        unsigned long long slot = slotDe[sala];
+        if (slot + 1 > numSlots) {
+            numSlots = slot + 1;
+        }
+        if (numSlots > limite) {
+            break;
+        }
+        if (mansao->salas[sala].esq != SEM_SALA) {
+            slotDe[mansao->salas[sala].esq] = 2 * slot + 1;
+            pilha[topo++] = mansao->salas[sala].esq;
+        }
+        if (mansao->salas[sala].dir != SEM_SALA) {
+            slotDe[mansao->salas[sala].dir] = 2 * slot + 2;
+            pilha[topo++] = mansao->salas[sala].dir;
+        }
+    }
+    free(pilha);
+
+    if (numSlots > limite) {
+        free(slotDe);
+        return 0;
+    }
+
+    SalaImplicita *implicitas = (SalaImplicita *)calloc((size_t)numSlots, sizeof(SalaImplicita));
+    if (implicitas == NULL) {
+        printf("Erro ao alocar memoria para a mansao.\n");
+        exit(1);
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        implicitas[slotDe[i]].nome = mansao->salas[i].nome;
+        implicitas[slotDe[i]].pista = mansao->salas[i].pista;
+        implicitas[slotDe[i]].suspeito = mansao->salas[i].suspeito;
+    }
+    free(slotDe);
+
+    if (mansao->mapa == NULL) {
+        free((void *)mansao->salas);
+        mansao->salas = NULL;
+    }
+    mansao->implicitas = implicitas;
+    mansao->numSlots = (unsigned int)numSlots;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: liberarMansao
+// Com arquivo mapeado, o pool de textos aponta para ele:
+// chame liberarPoolTextos antes (ou torne o pool próprio).
+// A imagem embutida (tamMapa 0) nunca sai da memória.
+// -------------------------------------------------------
+void liberarMansao(Mansao *mansao) {
+    if (mansao->mapa != NULL) {
+        if (mansao->tamMapa > 0) {
+            if (poolTextos.emprestado) {
+                tornarPoolProprio();
+            }
+            desmapearArquivo(mansao->mapa, mansao->tamMapa);
+        }
+    } else {
+        free((void *)mansao->salas);
+    }
+    free((void *)mansao->implicitas);
+    mansao->salas = NULL;
+    mansao->implicitas = NULL;
+    mansao->quantidade = 0;
+    mansao->numSlots = 0;
+    mansao->mapa = NULL;
+    mansao->tamMapa = 0;
+}
+
+// -------------------------------------------------------
+// Função: converterMansao
+// Texto -> binário ou binário -> texto, conforme a entrada
+// -------------------------------------------------------
+int converterMansao(const char *entrada, const char *saida) {
+    Mansao mansao;
+    int ok;
+
+    if (!carregarMansao(entrada, &mansao)) {
+        return 0;
+    }
+    if (mansao.mapa != NULL) {
+        ok = salvarMansaoTexto(&mansao, saida);
+    } else {
+        ok = salvarMansaoBinaria(&mansao, saida);
+    }
+    if (ok) {
+        printf("Mansao com %u sala(s) convertida: %s -> %s\n", mansao.quantidade, entrada, saida);
+    }
+
+    liberarPoolTextos();
+    liberarMansao(&mansao);
+    return ok;
+}
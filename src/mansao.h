@@ -0,0 +1,107 @@
+#ifndef MANSAO_H
+#define MANSAO_H
+
+#include "arena.h"
+#include "textos.h"
+
+#define SEM_SALA            (-1)         // filho inexistente na mansão compacta
+#define FOLGA_IMPLICITA     4            // forma implícita só se slots <= 4x salas
+#define TAM_LINHA_MANSAO    1024         // maior linha aceita no formato texto
+#define MAGICO_MANSAO       "DQMANS01"   // assinatura do formato binário
+
+// -------------------------------------------------------
+// Struct da Sala (árvore binária da mansão)
+// Os textos são handles do pool (TEXTO_VAZIO se não houver)
+// -------------------------------------------------------
+typedef struct Sala {
+    HandleTexto nome;      // nome da sala
+    HandleTexto pista;     // texto da pista
+    HandleTexto suspeito;  // nome do suspeito ligado à pista
+    struct Sala *esq;
+    struct Sala *dir;
+} Sala;
+
+// -------------------------------------------------------
+// Mansão compacta (somente leitura)
+// Mesma árvore de salas, mas em um vetor: os filhos são
+// índices e os textos são handles do pool. É o formato que
+// o jogo percorre e também o layout do arquivo binário, que
+// é mapeado na memória e usado sem nenhuma conversão.
+// -------------------------------------------------------
+typedef struct SalaCompacta {
+    HandleTexto nome;
+    HandleTexto pista;
+    HandleTexto suspeito;
+    int esq;               // índice do filho ou SEM_SALA
+    int dir;
+} SalaCompacta;
+
+// -------------------------------------------------------
+// Forma implícita (ordem de largura / Eytzinger): a sala do
+// slot i tem filhos nos slots 2i+1 e 2i+2, então não há
+// índices de filhos. Slots sem sala têm nome TEXTO_VAZIO.
+// Só compensa em árvores cheias ou quase cheias.
+// -------------------------------------------------------
+typedef struct SalaImplicita {
+    HandleTexto nome;
+    HandleTexto pista;
+    HandleTexto suspeito;
+} SalaImplicita;
+
+typedef struct Mansao {
+    const SalaCompacta *salas;        // forma explícita: salas[0] é o Hall de Entrada
+    const SalaImplicita *implicitas;  // forma implícita (NULL = usa 'salas')
+    unsigned int quantidade;          // número de salas
+    unsigned int numSlots;            // tamanho de 'implicitas'
+    void *mapa;                       // arquivo binário mapeado (NULL = salas no heap)
+    size_t tamMapa;                   // 0 com 'mapa': imagem embutida no executável
+} Mansao;
+
+// Função chamada para cada sala num percurso da mansão
+typedef void (*VisitaSala)(const Mansao *mansao, int sala, void *contexto);
+
+// -------------------------------------------------------
+// Cabeçalho do arquivo binário da mansão. Os deslocamentos
+// são contados do início do arquivo e alinhados em 8 bytes;
+// os números ficam na ordem de bytes da máquina.
+// Layout: cabeçalho | salas | entradas do pool | índice do
+// pool | textos
+// -------------------------------------------------------
+typedef struct CabecalhoMansao {
+    char magico[8];                   // MAGICO_MANSAO
+    unsigned int numSalas;
+    unsigned int numTextos;           // entradas do pool
+    unsigned int capIndice;           // slots do índice do pool
+    unsigned int versaoHash;          // VERSAO_HASH_TEXTO de quem gravou (0 = antiga)
+    unsigned long long tamTextos;     // bytes de texto (com os '\0')
+    unsigned long long desSalas;
+    unsigned long long desEntradas;
+    unsigned long long desIndice;
+    unsigned long long desTextos;
+} CabecalhoMansao;
+
+Sala* criarSala(Arena *arena, const char *nome, const char *pista, const char *suspeito);
+
+HandleTexto nomeSala(const Mansao *mansao, int sala);
+HandleTexto pistaSala(const Mansao *mansao, int sala);
+HandleTexto suspeitoSala(const Mansao *mansao, int sala);
+int salaEsq(const Mansao *mansao, int sala);
+int salaDir(const Mansao *mansao, int sala);
+
+void compactarMansao(Sala *raiz, Mansao *mansao);
+unsigned int percorrerMansao(const Mansao *mansao, int *pilha, VisitaSala visitar, void *contexto);
+
+int tornarMansaoImplicita(Mansao *mansao);
+int carregarMansaoTexto(const char *caminho, Mansao *mansao);
+int salvarMansaoTexto(const Mansao *mansao, const char *caminho);
+int cabecalhoMansaoValido(const CabecalhoMansao *cab, size_t tamanho);
+int validarImagemMansao(const void *dados, size_t tamanho);
+int adotarMansaoBinaria(void *dados, size_t tamanho, Mansao *mansao);
+int carregarMansaoBinaria(const char *caminho, Mansao *mansao);
+int gravarMansaoBinaria(const Mansao *mansao, FILE *arquivo);
+int salvarMansaoBinaria(const Mansao *mansao, const char *caminho);
+void liberarMansao(Mansao *mansao);
+int carregarMansao(const char *caminho, Mansao *mansao);
+int converterMansao(const char *entrada, const char *saida);
+
+#endif
@@ -0,0 +1,97 @@
+// Gerado por "mestre --gerar-tabelas" a partir de MANSAO_PADRAO:
+// nao edite. Imagem binaria (DQMANS01) da mansao padrao com o pool
+// de textos: 7 salas, 18 textos, indice de 512 slots (sem colisoes).
+#define MANSAO_PADRAO_EMBUTIDA 1
+
+static const unsigned long long IMAGEM_MANSAO_PADRAO[360] = {
+    0x3130534e414d5144ULL, 0x0000001200000007ULL, 0x0000000100000200ULL, 0x0000000000000196ULL,
+    0x0000000000000040ULL, 0x00000000000000d0ULL, 0x00000000000001a8ULL, 0x00000000000009a8ULL,
+    0x0000000200000001ULL, 0x0000000100000003ULL, 0x0000000400000002ULL, 0x0000000300000005ULL,
+    0x0000000400000003ULL, 0x0000000700000006ULL, 0x0000000500000008ULL, 0x0000000900000006ULL,
+    0x000000080000000aULL, 0xffffffffffffffffULL, 0x0000000c0000000bULL, 0xffffffff00000003ULL,
+    0x0000000dffffffffULL, 0x0000000f0000000eULL, 0xffffffffffffffffULL, 0x0000001100000010ULL,
+    0xffffffff0000000fULL, 0x00000000ffffffffULL, 0x0000000000000000ULL, 0x00000001e6b487d7ULL,
+    0x8bfae90c0000000fULL, 0x0000002b00000011ULL, 0x0000003d3157e441ULL, 0xcffa6dbd00000007ULL,
+    0x0000000d00000045ULL, 0x0000005378cad9caULL, 0xd01564630000002aULL, 0x000000070000007eULL,
+    0x00000086123695b1ULL, 0x978f715600000020ULL, 0x0000000a000000a7ULL, 0x000000b2e5fcb9c8ULL,
+    0x1b1a5c980000000aULL, 0x00000026000000bdULL, 0x000000e44bc2f85eULL, 0x0a37d66e0000000eULL,
+    0x00000030000000f3ULL, 0x00000124377b6aa9ULL, 0xa85d4eb100000008ULL, 0x0000002d0000012dULL,
+    0x0000015b7c9f188eULL, 0xd14609ff0000000aULL, 0x0000000600000166ULL, 0x0000016d0f689dd0ULL,
+    0x8b28ac7b00000028ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000200000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x000000000000000aULL, 0x0000000000000000ULL, 0x0000000500000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x000000000000000bULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000001100000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x000000000000000eULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000009ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000c00000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000d00000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000007ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000600000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000300000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000008ULL, 0x0000000000000004ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000f00000000ULL, 0x6564206c6c614800ULL, 0x61646172746e4520ULL, 0x6d20736176754c00ULL,
+    0x7361646168636e61ULL, 0x6164617869656420ULL, 0x206f747265702073ULL, 0x6469626163206f64ULL,
+    0x726f4d006f726965ULL, 0x6c6153006f6d6f64ULL, 0x7473452065642061ULL, 0x6461676550007261ULL,
+    0x6173206564207361ULL, 0x676e65206f746170ULL, 0x6e206f6461786172ULL, 0x657465706174206fULL,
+    0x6f43006f72616320ULL, 0x61460061686e697aULL, 0x20616a7573206163ULL, 0x6469646e6f637365ULL,
+    0x2073617274612061ULL, 0x4300616970206164ULL, 0x726965686e697a6fULL, 0x6f696c6269420061ULL,
+    0x76694c0061636574ULL, 0x6572206564206f72ULL, 0x6320736174696563ULL, 0x6e69676170206d6fULL,
+    0x6167736172207361ULL, 0x616c615300736164ULL, 0x6973754d20656420ULL, 0x6974726150006163ULL,
+    0x6d6f632061727574ULL, 0x6f6361746f6e6120ULL, 0x6572626f73207365ULL, 0x7261726f68206f20ULL,
+    0x7263206f64206f69ULL, 0x7073654400656d69ULL, 0x6961430061736e65ULL, 0x6566206564206178ULL,
+    0x61746e656d617272ULL, 0x6174726562612073ULL, 0x7269656f70206520ULL, 0x6978656d65722061ULL,
+    0x696472614a006164ULL, 0x614a006f7269656eULL, 0x676550006d696472ULL, 0x20616e2073616461ULL,
+    0x6f6d206172726574ULL, 0x657020616461686cULL, 0x65206164206f7472ULL, 0x0000006166757473ULL,
+};
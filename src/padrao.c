@@ -0,0 +1,262 @@
+#include "padrao.h"
+#include "arquivos.h"
+
+// Imagem da mansão padrão gerada por --gerar-tabelas; sem
+// ela, a mansão é montada em tempo de execução
+#if defined(__has_include)
+#if __has_include("mansao_padrao.h")
+#include "mansao_padrao.h"
+#endif
+#endif
+
+// -------------------------------------------------------
+// Mansão padrão, em forma declarativa. Cada linha é uma
+// sala: identificador, nome, pista, suspeito e os filhos à
+// esquerda e à direita (NENHUMA quando não há). A primeira
+// sala é o Hall de Entrada.
+// -------------------------------------------------------
+
+// Suspeitos: você pode mudar os nomes se quiser
+#define MORDOMO    "Mordomo"
+#define COZINHEIRA "Cozinheira"
+#define JARDINEIRO "Jardineiro"
+
+#define MANSAO_PADRAO(SALA)                                                        \
+    SALA(HALL_ENTRADA, "Hall de Entrada",                                          \
+         "Luvas manchadas deixadas perto do cabideiro", MORDOMO,                   \
+         SALA_ESTAR, COZINHA)                                                      \
+    SALA(SALA_ESTAR, "Sala de Estar",                                              \
+         "Pegadas de sapato engraxado no tapete caro", MORDOMO,                    \
+         BIBLIOTECA, SALA_MUSICA)                                                  \
+    SALA(COZINHA, "Cozinha",                                                       \
+         "Faca suja escondida atras da pia", COZINHEIRA,                           \
+         DESPENSA, JARDIM)                                                         \
+    SALA(BIBLIOTECA, "Biblioteca",                                                 \
+         "Livro de receitas com paginas rasgadas", COZINHEIRA,                     \
+         NENHUMA, NENHUMA)                                                         \
+    SALA(SALA_MUSICA, "Sala de Musica",                                            \
+         "Partitura com anotacoes sobre o horario do crime", MORDOMO,              \
+         NENHUMA, NENHUMA)                                                         \
+    SALA(DESPENSA, "Despensa",                                                     \
+         "Caixa de ferramentas aberta e poeira remexida", JARDINEIRO,              \
+         NENHUMA, NENHUMA)                                                         \
+    SALA(JARDIM, "Jardim",                                                         \
+         "Pegadas na terra molhada perto da estufa", JARDINEIRO,                   \
+         NENHUMA, NENHUMA)
+
+#define ID_SALA_PADRAO(id, nome, pista, suspeito, esq, dir) SALA_PADRAO_##id,
+enum { SALA_PADRAO_NENHUMA = SEM_SALA, MANSAO_PADRAO(ID_SALA_PADRAO) NUM_SALAS_PADRAO };
+#undef ID_SALA_PADRAO
+
+typedef struct SalaDeclarada {
+    const char *nome;
+    const char *pista;
+    const char *suspeito;
+    int esq;                      // índice em SALAS_PADRAO ou SEM_SALA
+    int dir;
+} SalaDeclarada;
+
+#define DADOS_SALA_PADRAO(id, nome, pista, suspeito, esq, dir) \
+    { nome, pista, suspeito, SALA_PADRAO_##esq, SALA_PADRAO_##dir },
+static const SalaDeclarada SALAS_PADRAO[NUM_SALAS_PADRAO] = { MANSAO_PADRAO(DADOS_SALA_PADRAO) };
+#undef DADOS_SALA_PADRAO
+
+// -------------------------------------------------------
+// Função: construirMansaoPadrao
+// Monta a mansão declarada com criarSala e a converte para
+// a forma compacta (interna os textos no pool)
+// -------------------------------------------------------
+void construirMansaoPadrao(Arena *arena, Mansao *mansao) {
+    Sala *salas[NUM_SALAS_PADRAO];
+
+    for (int i = 0; i < NUM_SALAS_PADRAO; i++) {
+        salas[i] = criarSala(arena, SALAS_PADRAO[i].nome, SALAS_PADRAO[i].pista,
+                             SALAS_PADRAO[i].suspeito);
+    }
+    for (int i = 0; i < NUM_SALAS_PADRAO; i++) {
+        int esq = SALAS_PADRAO[i].esq;
+        int dir = SALAS_PADRAO[i].dir;
+        salas[i]->esq = (esq != SEM_SALA) ? salas[esq] : NULL;
+        salas[i]->dir = (dir != SEM_SALA) ? salas[dir] : NULL;
+    }
+
+    compactarMansao(salas[0], mansao);
+}
+
+// Texto do handle é igual ao declarado?
+int textoDeclarado(HandleTexto handle, const char *texto) {
+    return handle < poolTextos.quantidade && strcmp(textoDe(handle), texto) == 0;
+}
+
+// -------------------------------------------------------
+// Função: conferirMansaoPadrao
+// A imagem embutida corresponde à lista declarada? Percorre
+// as duas árvores juntas, comparando textos e filhos (sem
+// hash nem alocação). Uma imagem que não foi regerada
+// depois de mudar a lista é recusada.
+// -------------------------------------------------------
+int conferirMansaoPadrao(const Mansao *mansao) {
+    int pilhaImagem[NUM_SALAS_PADRAO];
+    int pilhaLista[NUM_SALAS_PADRAO];
+    int topo = 0;
+    unsigned int visitadas = 0;
+
+    if (mansao->quantidade != NUM_SALAS_PADRAO) return 0;
+
+    pilhaImagem[topo] = 0;
+    pilhaLista[topo++] = 0;
+    while (topo > 0) {
+        topo--;
+        int sala = pilhaImagem[topo];
+        const SalaDeclarada *declarada = &SALAS_PADRAO[pilhaLista[topo]];
+        int esq = salaEsq(mansao, sala);
+        int dir = salaDir(mansao, sala);
+
+        if (++visitadas > NUM_SALAS_PADRAO ||
+            !textoDeclarado(nomeSala(mansao, sala), declarada->nome) ||
+            !textoDeclarado(pistaSala(mansao, sala), declarada->pista) ||
+            !textoDeclarado(suspeitoSala(mansao, sala), declarada->suspeito) ||
+            (esq == SEM_SALA) != (declarada->esq == SEM_SALA) ||
+            (dir == SEM_SALA) != (declarada->dir == SEM_SALA)) {
+            return 0;
+        }
+        if (esq != SEM_SALA) {
+            pilhaImagem[topo] = esq;
+            pilhaLista[topo++] = declarada->esq;
+        }
+        if (dir != SEM_SALA) {
+            pilhaImagem[topo] = dir;
+            pilhaLista[topo++] = declarada->dir;
+        }
+    }
+    return visitadas == NUM_SALAS_PADRAO;
+}
+
+// -------------------------------------------------------
+// Função: montarMansaoPadrao
+// Com a imagem gerada por --gerar-tabelas, a mansão e o
+// pool (já com o índice pronto) são usados direto dos dados
+// constantes do executável: nada é alocado nem hasheado.
+// Sem ela, ou se ela não bate com a lista, a mansão é
+// construída em tempo de execução.
+// -------------------------------------------------------
+void montarMansaoPadrao(Arena *arena, Mansao *mansao) {
+#ifdef MANSAO_PADRAO_EMBUTIDA
+    if (poolTextos.quantidade == 0 &&
+        adotarMansaoBinaria((void *)IMAGEM_MANSAO_PADRAO, sizeof(IMAGEM_MANSAO_PADRAO), mansao)) {
+        mansao->tamMapa = 0; // embutida: liberarMansao não a devolve
+        if (conferirMansaoPadrao(mansao)) {
+            return;
+        }
+        liberarPoolTextos();
+        liberarMansao(mansao);
+    }
+#endif
+    construirMansaoPadrao(arena, mansao);
+}
+
+// -------------------------------------------------------
+// Função auxiliar: tornarIndicePerfeito
+// Dobra o índice do pool (até 'capMax' slots) até que cada
+// texto caia num slot só seu: toda busca por um texto
+// conhecido acerta na primeira sondagem
+// -------------------------------------------------------
+int tornarIndicePerfeito(unsigned int capMax) {
+    for (unsigned int cap = poolTextos.capIndice; cap <= capMax; cap *= 2) {
+        unsigned char *ocupado = (unsigned char *)calloc(cap, 1);
+        HandleTexto h;
+
+        if (ocupado == NULL) {
+            printf("Erro ao alocar memoria para o pool de textos.\n");
+            exit(1);
+        }
+        for (h = 1; h < poolTextos.quantidade; h++) {
+            unsigned int pos = poolTextos.entradas[h].hash & (cap - 1);
+            if (ocupado[pos]) break;
+            ocupado[pos] = 1;
+        }
+        free(ocupado);
+        if (h == poolTextos.quantidade) {
+            reconstruirIndicePool(cap);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// -------------------------------------------------------
+// Ferramenta: gerarTabelasMansao
+// Constrói a mansão declarada e grava em 'caminho' um
+// cabeçalho C com a imagem binária dela (formato de
+// gravarMansaoBinaria, em palavras de 64 bits para ficar
+// alinhada). Incluído por padrao.c, ele dispensa a
+// montagem no início do jogo. A imagem vale para a função
+// de hash e a ordem de bytes de quem a gerou; com outras,
+// o jogo refaz os hashes ou monta a mansão.
+// -------------------------------------------------------
+int gerarTabelasMansao(const char *caminho) {
+    Arena arena;
+    Mansao mansao;
+    FILE *imagem;
+    FILE *saida;
+    unsigned long long *palavras = NULL;
+    size_t numPalavras = 0;
+    int perfeito;
+    int ok;
+
+    inicializarArena(&arena);
+    construirMansaoPadrao(&arena, &mansao);
+    perfeito = tornarIndicePerfeito(1u << 16);
+
+    // A imagem vai para um arquivo temporário e volta em palavras
+    imagem = tmpfile();
+    ok = imagem != NULL && gravarMansaoBinaria(&mansao, imagem) && fflush(imagem) == 0;
+    if (ok) {
+        long tamanho = ftell(imagem);
+        ok = tamanho > 0;
+        if (ok) {
+            // os textos terminam a imagem: a última palavra é completada com zeros
+            numPalavras = (size_t)alinhar8((unsigned long long)tamanho) / 8;
+            palavras = (unsigned long long *)realocarOuSair(NULL, numPalavras * 8);
+            palavras[numPalavras - 1] = 0;
+            rewind(imagem);
+            ok = fread(palavras, 1, (size_t)tamanho, imagem) == (size_t)tamanho;
+        }
+    }
+    if (imagem != NULL) {
+        fclose(imagem);
+    }
+
+    saida = ok ? fopen(caminho, "w") : NULL;
+    if (saida == NULL) {
+        printf("Nao foi possivel criar '%s'.\n", caminho);
+        ok = 0;
+    } else {
+        fprintf(saida, "// Gerado por \"mestre --gerar-tabelas\" a partir de MANSAO_PADRAO:\n"
+                       "// nao edite. Imagem binaria (%s) da mansao padrao com o pool\n"
+                       "// de textos: %u salas, %u textos, indice de %u slots%s.\n"
+                       "#define MANSAO_PADRAO_EMBUTIDA 1\n\n"
+                       "static const unsigned long long IMAGEM_MANSAO_PADRAO[%zu] = {\n",
+                MAGICO_MANSAO, mansao.quantidade, poolTextos.quantidade, poolTextos.capIndice,
+                perfeito ? " (sem colisoes)" : "", numPalavras);
+        for (size_t i = 0; i < numPalavras; i++) {
+            fprintf(saida, "%s0x%016llxULL,%s", (i % 4 == 0) ? "    " : " ", palavras[i],
+                    (i % 4 == 3 || i + 1 == numPalavras) ? "\n" : "");
+        }
+        fprintf(saida, "};\n");
+        if (fclose(saida) != 0) {
+            printf("Erro ao gravar '%s'.\n", caminho);
+            ok = 0;
+        }
+    }
+    if (ok) {
+        printf("%s: %u salas, %zu bytes, indice de %u slots%s.\n", caminho, mansao.quantidade,
+               numPalavras * 8, poolTextos.capIndice, perfeito ? " sem colisoes" : "");
+    }
+
+    free(palavras);
+    liberarMansao(&mansao);
+    liberarArena(&arena);
+    liberarPoolTextos();
+    return ok;
+}
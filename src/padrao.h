@@ -0,0 +1,13 @@
+#ifndef PADRAO_H
+#define PADRAO_H
+
+// -------------------------------------------------------
+// Mansão padrão do jogo (lista declarada em padrao.c)
+// -------------------------------------------------------
+#include "mansao.h"
+
+void construirMansaoPadrao(Arena *arena, Mansao *mansao);
+void montarMansaoPadrao(Arena *arena, Mansao *mansao);
+int gerarTabelasMansao(const char *caminho);
+
+#endif
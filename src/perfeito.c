@@ -0,0 +1,305 @@
+#include "perfeito.h"
+
+// -------------------------------------------------------
+// Hash perfeito mínimo
+// -------------------------------------------------------
+
+// Reduz x (32 bits uniformes) ao intervalo [0, n) sem divisão
+unsigned int reduzirIntervalo(unsigned int x, unsigned int n) {
+    return (unsigned int)(((unsigned long long)x * n) >> 32);
+}
+
+unsigned int baldesDaParticao(unsigned int n) {
+    return (n + CHAVES_POR_BALDE - 1) / CHAVES_POR_BALDE;
+}
+
+// Slot (dentro da partição de 'n' pistas) da pista de hash
+// 'h' com o deslocamento 'k': cada k é um sorteio novo
+unsigned int slotPerfeito(unsigned long long h, unsigned int k, unsigned int n) {
+    return reduzirIntervalo((unsigned int)misturar64(h, 0x9E3779B97F4A7C15ull ^ k), n);
+}
+
+// Texto de uma pista do pool e seu tamanho
+const char* textoETamanho(HandleTexto handle, size_t *tamanho) {
+    *tamanho = poolTextos.entradas[handle].tamanho;
+    return &poolTextos.textos[poolTextos.entradas[handle].deslocamento];
+}
+
+// -------------------------------------------------------
+// Função auxiliar: montarParticaoPerfeita
+// CHD numa partição de 'n' pistas: os baldes são tratados
+// do maior para o menor, e cada um fica com o primeiro k que
+// leva todas as suas pistas a slots livres e distintos.
+// Devolve 0 se algum balde esgotar os 65536 valores de k (a
+// semente da partição não serve).
+// -------------------------------------------------------
+int montarParticaoPerfeita(const unsigned long long *hashes, unsigned int n, unsigned int semente,
+                           unsigned short *deslocamentos, unsigned int *posicoes) {
+    unsigned long long chaves[MAX_CHAVES_PARTICAO];
+    unsigned int membros[MAX_CHAVES_PARTICAO];
+    unsigned int inicio[MAX_CHAVES_PARTICAO / CHAVES_POR_BALDE + 2];
+    unsigned int ordem[MAX_CHAVES_PARTICAO / CHAVES_POR_BALDE + 1];
+    unsigned int porTamanho[MAX_CHAVES_PARTICAO + 2];
+    unsigned int slots[MAX_CHAVES_PARTICAO];
+    unsigned char ocupado[MAX_CHAVES_PARTICAO];
+    unsigned int numBaldes = baldesDaParticao(n);
+    unsigned int maior = 0;
+
+    if (n == 0) return 1;
+    if (n > MAX_CHAVES_PARTICAO) return 0;
+
+    // Pistas agrupadas por balde (contagem + prefixos)
+    memset(inicio, 0, (numBaldes + 2) * sizeof(unsigned int));
+    for (unsigned int j = 0; j < n; j++) {
+        inicio[reduzirIntervalo((unsigned int)hashes[j], numBaldes) + 2]++;
+    }
+    for (unsigned int b = 0; b < numBaldes; b++) {
+        if (inicio[b + 2] > maior) maior = inicio[b + 2];
+        inicio[b + 2] += inicio[b + 1];
+    }
+    for (unsigned int j = 0; j < n; j++) {
+        unsigned int b = reduzirIntervalo((unsigned int)hashes[j], numBaldes);
+        membros[inicio[b + 1]] = j;
+        chaves[inicio[b + 1]++] = hashes[j] ^ semente;
+    }
+
+    // Baldes do maior para o menor (contagem por tamanho)
+    memset(porTamanho, 0, (maior + 2) * sizeof(unsigned int));
+    for (unsigned int b = 0; b < numBaldes; b++) {
+        porTamanho[maior - (inicio[b + 1] - inicio[b]) + 1]++;
+    }
+    for (unsigned int t = 0; t <= maior; t++) {
+        porTamanho[t + 1] += porTamanho[t];
+    }
+    for (unsigned int b = 0; b < numBaldes; b++) {
+        ordem[porTamanho[maior - (inicio[b + 1] - inicio[b])]++] = b;
+    }
+
+    memset(deslocamentos, 0, numBaldes * sizeof(unsigned short));
+    memset(ocupado, 0, n);
+    for (unsigned int i = 0; i < numBaldes; i++) {
+        unsigned int b = ordem[i];
+        const unsigned long long *h = &chaves[inicio[b]];
+        unsigned int tam = inicio[b + 1] - inicio[b];
+        unsigned int k = 0;
+
+        if (tam == 0) break; // os demais também estão vazios
+
+        for (; k <= 0xFFFF; k++) {
+            unsigned int j;
+            for (j = 0; j < tam; j++) {
+                slots[j] = slotPerfeito(h[j], k, n);
+                if (ocupado[slots[j]]) break;
+                ocupado[slots[j]] = 2; // provisório, pega repetição no balde
+            }
+            for (unsigned int r = 0; r < j; r++) {
+                ocupado[slots[r]] = 0;
+            }
+            if (j == tam) break;
+        }
+        if (k > 0xFFFF) return 0;
+
+        deslocamentos[b] = (unsigned short)k;
+        for (unsigned int j = 0; j < tam; j++) {
+            ocupado[slots[j]] = 1;
+            posicoes[membros[inicio[b] + j]] = slots[j];
+        }
+    }
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: construirMapaPerfeito
+// Monta o hash perfeito mínimo de pistas[i] -> suspeitos[i].
+// Pistas repetidas ficam com o último suspeito (como na
+// tabela dinâmica). Partição que não fecha troca só a sua
+// semente; a semente global só muda se uma partição ficar
+// grande demais ou se dois textos tiverem o mesmo hash de
+// 64 bits. Se nada servir, devolve 0 com o mapa vazio, e
+// quem chamou usa só a tabela dinâmica.
+// -------------------------------------------------------
+int construirMapaPerfeito(MapaPerfeito *mapa, const HandleTexto *pistas,
+                          const HandleTexto *suspeitos, size_t n) {
+    unsigned long long locais[MAX_CHAVES_PARTICAO];
+    unsigned int posicoes[MAX_CHAVES_PARTICAO];
+    unsigned int *ultima = NULL;
+    unsigned int quantidade = 0;
+
+    memset(mapa, 0, sizeof(*mapa));
+
+    // Uma entrada por pista distinta (a última ocorrência)
+    if (poolTextos.quantidade > 0) {
+        ultima = (unsigned int *)realocarOuSair(NULL, (size_t)poolTextos.quantidade * sizeof(unsigned int));
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (pistas[i] != TEXTO_VAZIO && pistas[i] != TEXTO_INEXISTENTE) {
+            ultima[pistas[i]] = (unsigned int)i;
+        }
+    }
+    unsigned int *origem = (unsigned int *)realocarOuSair(NULL, (n + 1) * sizeof(unsigned int));
+    for (size_t i = 0; i < n; i++) {
+        if (pistas[i] != TEXTO_VAZIO && pistas[i] != TEXTO_INEXISTENTE && ultima[pistas[i]] == i) {
+            origem[quantidade++] = (unsigned int)i;
+        }
+    }
+    free(ultima);
+    if (quantidade == 0) {
+        free(origem);
+        return 1;
+    }
+
+    unsigned int numParticoes = (quantidade + CHAVES_POR_PARTICAO - 1) / CHAVES_POR_PARTICAO;
+    unsigned long long *hashes = (unsigned long long *)realocarOuSair(NULL, quantidade * sizeof(unsigned long long));
+    unsigned int *ordem = (unsigned int *)realocarOuSair(NULL, quantidade * sizeof(unsigned int));
+    unsigned int *inicio = (unsigned int *)realocarOuSair(NULL, (numParticoes + 1) * sizeof(unsigned int));
+
+    mapa->quantidade = quantidade;
+    mapa->numParticoes = numParticoes;
+    mapa->particoes = (ParticaoPerfeita *)realocarOuSair(NULL, (numParticoes + 1) * sizeof(ParticaoPerfeita));
+    mapa->deslocamentos = (unsigned short *)realocarOuSair(NULL,
+        ((size_t)quantidade / CHAVES_POR_BALDE + numParticoes) * sizeof(unsigned short));
+    mapa->pistas = (HandleTexto *)realocarOuSair(NULL, quantidade * sizeof(HandleTexto));
+    mapa->suspeitos = (HandleTexto *)realocarOuSair(NULL, quantidade * sizeof(HandleTexto));
+
+    int pronto = 0;
+    for (int tentativa = 0; tentativa < TENTATIVAS_PERFEITO && !pronto; tentativa++) {
+        ParticaoPerfeita *particoes = mapa->particoes;
+
+        mapa->semente = misturar64(0x9E3779B97F4A7C15ull, (unsigned long long)tentativa + 1);
+
+        // Partições: contagem, prefixos e distribuição
+        memset(inicio, 0, (numParticoes + 1) * sizeof(unsigned int));
+        for (unsigned int i = 0; i < quantidade; i++) {
+            size_t tam;
+            const char *texto = textoETamanho(pistas[origem[i]], &tam);
+            hashes[i] = hashTexto64(texto, tam, mapa->semente);
+            inicio[reduzirIntervalo((unsigned int)(hashes[i] >> 32), numParticoes) + 1]++;
+        }
+        int cabem = 1;
+        particoes[0].primeiroBalde = 0;
+        for (unsigned int p = 0; p < numParticoes; p++) {
+            unsigned int tam = inicio[p + 1];
+            if (tam > MAX_CHAVES_PARTICAO) cabem = 0;
+            particoes[p].primeiraChave = inicio[p];
+            particoes[p + 1].primeiroBalde = particoes[p].primeiroBalde + baldesDaParticao(tam);
+            inicio[p + 1] += inicio[p];
+        }
+        particoes[numParticoes].primeiraChave = quantidade;
+        particoes[numParticoes].semente = 0;
+        if (!cabem) continue;
+        for (unsigned int i = 0; i < quantidade; i++) {
+            unsigned int p = reduzirIntervalo((unsigned int)(hashes[i] >> 32), numParticoes);
+            ordem[inicio[p]++] = i;
+        }
+
+        pronto = 1;
+        for (unsigned int p = 0; p < numParticoes && pronto; p++) {
+            unsigned int primeira = particoes[p].primeiraChave;
+            unsigned int tam = particoes[p + 1].primeiraChave - primeira;
+            int fechou = 0;
+
+            for (unsigned int j = 0; j < tam; j++) {
+                locais[j] = hashes[ordem[primeira + j]];
+            }
+            for (unsigned int s = 0; s < TENTATIVAS_PERFEITO && !fechou; s++) {
+                particoes[p].semente = (unsigned int)misturar64(mapa->semente ^ p, s + 1);
+                fechou = montarParticaoPerfeita(locais, tam, particoes[p].semente,
+                                                &mapa->deslocamentos[particoes[p].primeiroBalde], posicoes);
+            }
+            if (!fechou) {
+                pronto = 0;
+                break;
+            }
+            for (unsigned int j = 0; j < tam; j++) {
+                unsigned int i = origem[ordem[primeira + j]];
+                mapa->pistas[primeira + posicoes[j]] = pistas[i];
+                mapa->suspeitos[primeira + posicoes[j]] = suspeitos[i];
+            }
+        }
+    }
+
+    free(hashes);
+    free(ordem);
+    free(inicio);
+    free(origem);
+    if (!pronto) {
+        liberarMapaPerfeito(mapa);
+        return 0;
+    }
+    return 1;
+}
+
+// Slot da pista de hash 'h' (ou -1 se a partição for vazia)
+long slotMapaPerfeito(const MapaPerfeito *mapa, unsigned long long h) {
+    const ParticaoPerfeita *particao = &mapa->particoes[reduzirIntervalo((unsigned int)(h >> 32),
+                                                                         mapa->numParticoes)];
+    unsigned int n = particao[1].primeiraChave - particao->primeiraChave;
+    unsigned int numBaldes = particao[1].primeiroBalde - particao->primeiroBalde;
+
+    if (n == 0) return -1;
+
+    unsigned int k = mapa->deslocamentos[particao->primeiroBalde + reduzirIntervalo((unsigned int)h, numBaldes)];
+    return (long)particao->primeiraChave + (long)slotPerfeito(h ^ particao->semente, k, n);
+}
+
+// -------------------------------------------------------
+// Função: consultarMapaPerfeito
+// Suspeito de uma pista pelo texto: um hash, um slot e uma
+// comparação com a pista guardada nele. TEXTO_INEXISTENTE
+// se a pista não for do conjunto.
+// -------------------------------------------------------
+HandleTexto consultarMapaPerfeito(const MapaPerfeito *mapa, const char *pista) {
+    if (mapa == NULL || mapa->quantidade == 0 || pista == NULL || pista[0] == '\0') {
+        return TEXTO_INEXISTENTE;
+    }
+
+    size_t tamanho = strlen(pista);
+    long slot = slotMapaPerfeito(mapa, hashTexto64(pista, tamanho, mapa->semente));
+    if (slot < 0) return TEXTO_INEXISTENTE;
+
+    size_t tamGuardada;
+    const char *guardada = textoETamanho(mapa->pistas[slot], &tamGuardada);
+    if (tamGuardada != tamanho || memcmp(guardada, pista, tamanho) != 0) {
+        return TEXTO_INEXISTENTE;
+    }
+    return mapa->suspeitos[slot];
+}
+
+// Mesma consulta partindo do handle: a verificação é a
+// igualdade dos handles
+HandleTexto consultarMapaPerfeitoPorHandle(const MapaPerfeito *mapa, HandleTexto pista) {
+    if (mapa == NULL || mapa->quantidade == 0 || pista == TEXTO_VAZIO || pista == TEXTO_INEXISTENTE) {
+        return TEXTO_INEXISTENTE;
+    }
+
+    size_t tamanho;
+    const char *texto = textoETamanho(pista, &tamanho);
+    long slot = slotMapaPerfeito(mapa, hashTexto64(texto, tamanho, mapa->semente));
+    return (slot >= 0 && mapa->pistas[slot] == pista) ? mapa->suspeitos[slot] : TEXTO_INEXISTENTE;
+}
+
+// Suspeito de uma pista: primeiro o mapa perfeito (pistas
+// conhecidas de antemão), depois a tabela dinâmica (pistas
+// acrescentadas durante o jogo)
+HandleTexto suspeitoDaPista(const MapaPerfeito *estatico, TabelaHash *tabela, HandleTexto pista) {
+    HandleTexto suspeito = consultarMapaPerfeitoPorHandle(estatico, pista);
+    return (suspeito != TEXTO_INEXISTENTE) ? suspeito : encontrarSuspeitoPorHandle(tabela, pista);
+}
+
+// Custo do índice em bits por pista, sem contar os vetores
+// de pistas e suspeitos (que qualquer tabela teria)
+double bitsPorPistaMapaPerfeito(const MapaPerfeito *mapa) {
+    if (mapa->quantidade == 0) return 0.0;
+
+    size_t bytes = (size_t)mapa->particoes[mapa->numParticoes].primeiroBalde * sizeof(unsigned short) +
+                   ((size_t)mapa->numParticoes + 1) * sizeof(ParticaoPerfeita);
+    return (double)bytes * 8.0 / mapa->quantidade;
+}
+
+void liberarMapaPerfeito(MapaPerfeito *mapa) {
+    free(mapa->particoes);
+    free(mapa->deslocamentos);
+    free(mapa->pistas);
+    free(mapa->suspeitos);
+    memset(mapa, 0, sizeof(*mapa));
+}
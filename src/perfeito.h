@@ -0,0 +1,47 @@
+#ifndef PERFEITO_H
+#define PERFEITO_H
+
+#include "hash.h"
+
+#define CHAVES_POR_PARTICAO 1024  // média de pistas por partição do hash perfeito
+#define MAX_CHAVES_PARTICAO 2048  // partição maior que isso troca a semente global
+#define CHAVES_POR_BALDE    5     // pistas por balde (16 bits / 5 = 3,2 bits por pista)
+#define TENTATIVAS_PERFEITO 64    // sementes tentadas antes de desistir do hash perfeito
+
+// -------------------------------------------------------
+// Hash perfeito mínimo (CHD) das pistas de um caso, montado
+// de uma vez quando o conjunto inteiro já é conhecido. As
+// pistas são divididas em partições de ~CHAVES_POR_PARTICAO
+// e, em cada partição, em baldes de ~CHAVES_POR_BALDE. Cada
+// balde guarda o índice (16 bits) do primeiro deslocamento
+// que leva suas pistas a slots livres e distintos:
+//   slot = reduzir(misturar(hash ^ semente da partição, k))
+// A consulta é um hash, um slot e uma comparação; pistas de
+// fora do conjunto caem num slot qualquer e a comparação as
+// recusa (aí vale a tabela dinâmica).
+// -------------------------------------------------------
+typedef struct ParticaoPerfeita {
+    unsigned int primeiraChave;    // primeiro slot da partição
+    unsigned int primeiroBalde;    // primeiro deslocamento da partição
+    unsigned int semente;          // semente local que deu certo
+} ParticaoPerfeita;
+
+typedef struct MapaPerfeito {
+    unsigned int quantidade;       // pistas (= slots)
+    unsigned int numParticoes;
+    unsigned long long semente;    // semente do hash dos textos
+    ParticaoPerfeita *particoes;   // numParticoes + 1 (a última só marca o fim)
+    unsigned short *deslocamentos; // um por balde
+    HandleTexto *pistas;           // pista de cada slot, para a verificação
+    HandleTexto *suspeitos;
+} MapaPerfeito;
+
+int construirMapaPerfeito(MapaPerfeito *mapa, const HandleTexto *pistas,
+                          const HandleTexto *suspeitos, size_t n);
+HandleTexto consultarMapaPerfeito(const MapaPerfeito *mapa, const char *pista);
+HandleTexto consultarMapaPerfeitoPorHandle(const MapaPerfeito *mapa, HandleTexto pista);
+HandleTexto suspeitoDaPista(const MapaPerfeito *estatico, TabelaHash *tabela, HandleTexto pista);
+double bitsPorPistaMapaPerfeito(const MapaPerfeito *mapa);
+void liberarMapaPerfeito(MapaPerfeito *mapa);
+
+#endif
@@ -0,0 +1,665 @@
+#include "pistas.h"
+#include "estatisticas.h"
+
+// -------------------------------------------------------
+// Funções auxiliares da árvore B+: chaves
+// O prefixo é formado pelos 8 primeiros bytes em ordem
+// big-endian (completado com zeros), então comparar dois
+// prefixos como inteiros dá a mesma ordem que o strcmp.
+// -------------------------------------------------------
+unsigned long long prefixoPista(const char *pista) {
+    unsigned long long prefixo = 0;
+    int fim = 0;
+
+    for (int i = 0; i < 8; i++) {
+        unsigned char c = fim ? 0 : (unsigned char)pista[i];
+        if (c == 0) fim = 1;
+        prefixo = (prefixo << 8) | c;
+    }
+    return prefixo;
+}
+
+// Compara (prefixo, handle) com a chave 'i' do nó. Textos
+// internados são únicos: handles iguais são textos iguais, e
+// o strcmp só acontece quando os 8 primeiros bytes empatam.
+int compararChavePista(unsigned long long prefixo, HandleTexto pista,
+                       const NoBMais *no, int i) {
+    if (prefixo != no->prefixos[i]) {
+        return (prefixo < no->prefixos[i]) ? -1 : 1;
+    }
+    if (pista == no->pistas[i]) {
+        return 0;
+    }
+    return strcmp(textoDe(pista) + 8, textoDe(no->pistas[i]) + 8);
+}
+
+// -------------------------------------------------------
+// Função auxiliar: posicaoNoBMais
+// Busca binária: primeira chave do nó que é >= (prefixo,
+// texto); em '*igual' indica se ela é exatamente a procurada
+// -------------------------------------------------------
+int posicaoNoBMais(const NoBMais *no, unsigned long long prefixo,
+                   HandleTexto pista, int *igual) {
+    int ini = 0, fim = no->quantidade;
+
+    *igual = 0;
+    while (ini < fim) {
+        int meio = (ini + fim) / 2;
+        int cmp = compararChavePista(prefixo, pista, no, meio);
+        if (cmp == 0) {
+            *igual = 1;
+            return meio;
+        }
+        if (cmp > 0) {
+            ini = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return ini;
+}
+
+NoBMais* criarNoBMais(ArvorePistas *arvore, int folha) {
+    NoBMais *novo = (NoBMais *)alocarArena(arvore->arena, sizeof(NoBMais));
+    ESTAT_CONTAR(NOS_PISTAS_CRIADOS, 1);
+    novo->folha = folha;
+    novo->quantidade = 0;
+    novo->proximo = NULL;
+    return novo;
+}
+
+void inicializarPistas(ArvorePistas *arvore, Arena *arena) {
+    arvore->arena = arena;
+    arvore->raiz = NULL;
+    arvore->primeiraFolha = NULL;
+    arvore->quantidade = 0;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: dividirNoBMais
+// Divide um nó que estourou (ORDEM_BMAIS + 1 chaves). Na
+// folha, a chave separadora é copiada para cima; no nó
+// interno, ela sobe e sai do nó. Devolve o novo irmão direito.
+// -------------------------------------------------------
+NoBMais* dividirNoBMais(ArvorePistas *arvore, NoBMais *no,
+                        unsigned long long *prefixoSobe, HandleTexto *pistaSobe) {
+    NoBMais *irmao = criarNoBMais(arvore, no->folha);
+    int total = no->quantidade;
+    int meio = total / 2;
+
+    if (no->folha) {
+        irmao->quantidade = total - meio;
+        memcpy(irmao->prefixos, &no->prefixos[meio], irmao->quantidade * sizeof(unsigned long long));
+        memcpy(irmao->pistas, &no->pistas[meio], irmao->quantidade * sizeof(HandleTexto));
+        no->quantidade = meio;
+
+        irmao->proximo = no->proximo;
+        no->proximo = irmao;
+
+        *prefixoSobe = irmao->prefixos[0];
+        *pistaSobe = irmao->pistas[0];
+    } else {
+        *prefixoSobe = no->prefixos[meio];
+        *pistaSobe = no->pistas[meio];
+
+        irmao->quantidade = total - meio - 1;
+        memcpy(irmao->prefixos, &no->prefixos[meio + 1], irmao->quantidade * sizeof(unsigned long long));
+        memcpy(irmao->pistas, &no->pistas[meio + 1], irmao->quantidade * sizeof(HandleTexto));
+        memcpy(irmao->filhos, &no->filhos[meio + 1], (irmao->quantidade + 1) * sizeof(NoBMais *));
+        no->quantidade = meio;
+    }
+    return irmao;
+}
+
+// Abre espaço na posição 'pos' do nó e grava a chave
+void inserirChaveNoBMais(NoBMais *no, int pos, unsigned long long prefixo, HandleTexto pista) {
+    int mover = no->quantidade - pos;
+    memmove(&no->prefixos[pos + 1], &no->prefixos[pos], mover * sizeof(unsigned long long));
+    memmove(&no->pistas[pos + 1], &no->pistas[pos], mover * sizeof(HandleTexto));
+    no->prefixos[pos] = prefixo;
+    no->pistas[pos] = pista;
+    no->quantidade++;
+}
+
+// -------------------------------------------------------
+// Função: inserirPista
+// Insere uma nova pista na árvore B+ em ordem alfabética.
+// Desce iterativamente guardando o caminho e, se a folha
+// estourar, sobe dividindo os nós. Pistas repetidas são
+// ignoradas. Retorna 1 se a pista era nova, 0 caso contrário.
+// -------------------------------------------------------
+int inserirPista(ArvorePistas *arvore, HandleTexto pista) {
+    NoBMais *caminho[ALTURA_MAX_BMAIS];
+    int posicoes[ALTURA_MAX_BMAIS];
+    int tamCaminho = 0;
+    int igual;
+
+    if (pista == TEXTO_VAZIO || pista == TEXTO_INEXISTENTE) {
+        return 0; // pista vazia, nada a inserir
+    }
+
+    ESTAT_AMOSTRA(inicio);
+    unsigned long long prefixo = prefixoPista(textoDe(pista));
+
+    if (arvore->raiz == NULL) {
+        arvore->raiz = criarNoBMais(arvore, 1);
+        arvore->primeiraFolha = arvore->raiz;
+    }
+
+    NoBMais *no = arvore->raiz;
+    while (!no->folha) {
+        int pos = posicaoNoBMais(no, prefixo, pista, &igual);
+        if (igual) pos++; // chave igual ao separador fica à direita
+        caminho[tamCaminho] = no;
+        posicoes[tamCaminho] = pos;
+        tamCaminho++;
+        no = no->filhos[pos];
+    }
+    ESTAT_CUSTO(INSERCOES_PISTA, NIVEIS_DESCIDOS, MAIOR_PROFUNDIDADE, tamCaminho + 1);
+
+    int pos = posicaoNoBMais(no, prefixo, pista, &igual);
+    if (igual) {
+        ESTAT_FIM(INSERCAO_PISTA, inicio);
+        return 0; // pista já existente: ignora duplicata
+    }
+    inserirChaveNoBMais(no, pos, prefixo, pista);
+    arvore->quantidade++;
+
+    // Sobe dividindo enquanto houver estouro
+    while (no->quantidade > ORDEM_BMAIS) {
+        unsigned long long prefixoSobe;
+        HandleTexto pistaSobe;
+        NoBMais *irmao = dividirNoBMais(arvore, no, &prefixoSobe, &pistaSobe);
+
+        if (tamCaminho == 0) {
+            NoBMais *novaRaiz = criarNoBMais(arvore, 0);
+            novaRaiz->quantidade = 1;
+            novaRaiz->prefixos[0] = prefixoSobe;
+            novaRaiz->pistas[0] = pistaSobe;
+            novaRaiz->filhos[0] = no;
+            novaRaiz->filhos[1] = irmao;
+            arvore->raiz = novaRaiz;
+            break;
+        }
+
+        tamCaminho--;
+        NoBMais *pai = caminho[tamCaminho];
+        int p = posicoes[tamCaminho];
+        memmove(&pai->filhos[p + 2], &pai->filhos[p + 1], (pai->quantidade - p) * sizeof(NoBMais *));
+        pai->filhos[p + 1] = irmao;
+        inserirChaveNoBMais(pai, p, prefixoSobe, pistaSobe);
+        no = pai;
+    }
+
+    ESTAT_FIM(INSERCAO_PISTA, inicio);
+    return 1;
+}
+
+// Ordem das chaves para o qsort do lote (mesma da árvore)
+int compararChavesLote(const void *a, const void *b) {
+    const ChavePista *x = (const ChavePista *)a;
+    const ChavePista *y = (const ChavePista *)b;
+
+    if (x->prefixo != y->prefixo) {
+        return (x->prefixo < y->prefixo) ? -1 : 1;
+    }
+    if (x->sufixo != y->sufixo) {
+        return (x->sufixo < y->sufixo) ? -1 : 1;
+    }
+    if (x->pista == y->pista) {
+        return 0;
+    }
+    return strcmp(textoDe(x->pista) + 16, textoDe(y->pista) + 16);
+}
+
+// Chave de ordenação completa de uma pista
+ChavePista chaveDaPista(HandleTexto pista) {
+    const char *texto = textoDe(pista);
+    ChavePista chave;
+
+    chave.prefixo = prefixoPista(texto);
+    // Se o texto acaba nos 8 primeiros bytes, não há sufixo
+    chave.sufixo = (chave.prefixo & 0xFF) ? prefixoPista(texto + 8) : 0;
+    chave.pista = pista;
+    return chave;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: construirBMais
+// Monta a árvore de baixo para cima a partir de chaves já
+// ordenadas e sem repetição, em O(n): folhas cheias de forma
+// equilibrada, depois cada nível de nós internos, até sobrar
+// só a raiz. O separador de cada filho é a menor chave dele.
+// -------------------------------------------------------
+void construirBMais(ArvorePistas *arvore, const ChavePista *chaves, size_t n) {
+    size_t numNos = (n + ORDEM_BMAIS - 1) / ORDEM_BMAIS;
+    NoBMais **nivel = (NoBMais **)realocarOuSair(NULL, numNos * sizeof(NoBMais *));
+    ChavePista *menores = (ChavePista *)realocarOuSair(NULL, numNos * sizeof(ChavePista));
+    NoBMais *anterior = NULL;
+    size_t usadas = 0;
+
+    for (size_t i = 0; i < numNos; i++) {
+        NoBMais *folha = criarNoBMais(arvore, 1);
+        size_t fim = n * (i + 1) / numNos; // distribui as chaves por igual
+
+        folha->quantidade = (int)(fim - usadas);
+        for (int k = 0; k < folha->quantidade; k++) {
+            folha->prefixos[k] = chaves[usadas + k].prefixo;
+            folha->pistas[k] = chaves[usadas + k].pista;
+        }
+        menores[i] = chaves[usadas];
+        usadas = fim;
+
+        if (anterior != NULL) {
+            anterior->proximo = folha;
+        } else {
+            arvore->primeiraFolha = folha;
+        }
+        anterior = folha;
+        nivel[i] = folha;
+    }
+
+    // Cada nó interno recebe até ORDEM_BMAIS + 1 filhos
+    while (numNos > 1) {
+        size_t numPais = (numNos + ORDEM_BMAIS) / (ORDEM_BMAIS + 1);
+        size_t filho = 0;
+
+        for (size_t i = 0; i < numPais; i++) {
+            NoBMais *pai = criarNoBMais(arvore, 0);
+            size_t fim = numNos * (i + 1) / numPais;
+
+            pai->filhos[0] = nivel[filho];
+            ChavePista menor = menores[filho];
+            for (size_t j = filho + 1; j < fim; j++) {
+                pai->prefixos[pai->quantidade] = menores[j].prefixo;
+                pai->pistas[pai->quantidade] = menores[j].pista;
+                pai->quantidade++;
+                pai->filhos[pai->quantidade] = nivel[j];
+            }
+            nivel[i] = pai;
+            menores[i] = menor;
+            filho = fim;
+        }
+        numNos = numPais;
+    }
+
+    arvore->raiz = nivel[0];
+    free(nivel);
+    free(menores);
+}
+
+// -------------------------------------------------------
+// Função: inserirPistasEmLote
+// Ordena o lote uma vez, tira repetidas e intercala com as
+// pistas que já estão nas folhas; a árvore é então refeita
+// de baixo para cima. Os nós antigos ficam na arena até ela
+// ser liberada. Se o lote for pequeno perto da árvore,
+// refazer tudo não compensa e as pistas entram uma a uma.
+// Retorna quantas pistas eram novas.
+// -------------------------------------------------------
+int inserirPistasEmLote(ArvorePistas *arvore, const HandleTexto *pistas, size_t n) {
+    ChavePista *lote;
+    ChavePista *todas;
+    size_t numLote = 0;
+    size_t numTodas = 0;
+
+    if ((size_t)arvore->quantidade > n * 8) {
+        int novas = 0;
+        for (size_t i = 0; i < n; i++) {
+            novas += inserirPista(arvore, pistas[i]);
+        }
+        return novas;
+    }
+
+    lote = (ChavePista *)realocarOuSair(NULL, (n + 1) * sizeof(ChavePista));
+    for (size_t i = 0; i < n; i++) {
+        if (pistas[i] == TEXTO_VAZIO || pistas[i] == TEXTO_INEXISTENTE) continue;
+        lote[numLote++] = chaveDaPista(pistas[i]);
+    }
+    qsort(lote, numLote, sizeof(ChavePista), compararChavesLote);
+
+    // Intercala lote e folhas, descartando repetidas
+    todas = (ChavePista *)realocarOuSair(NULL,
+                (numLote + (size_t)arvore->quantidade + 1) * sizeof(ChavePista));
+    const NoBMais *folha = arvore->primeiraFolha;
+    int k = 0;
+    size_t i = 0;
+    while (i < numLote || folha != NULL) {
+        ChavePista proxima;
+
+        if (folha != NULL && k == folha->quantidade) {
+            folha = folha->proximo;
+            k = 0;
+            continue;
+        }
+        if (folha == NULL) {
+            proxima = lote[i++];
+        } else {
+            ChavePista daArvore = chaveDaPista(folha->pistas[k]);
+            if (i < numLote && compararChavesLote(&lote[i], &daArvore) < 0) {
+                proxima = lote[i++];
+            } else {
+                proxima = daArvore;
+                k++;
+            }
+        }
+        if (numTodas == 0 || todas[numTodas - 1].pista != proxima.pista) {
+            todas[numTodas++] = proxima;
+        }
+    }
+    free(lote);
+
+    int novas = (int)numTodas - arvore->quantidade;
+    if (novas > 0) {
+        construirBMais(arvore, todas, numTodas);
+        arvore->quantidade = (int)numTodas;
+    }
+    free(todas);
+    return novas;
+}
+
+// -------------------------------------------------------
+// Função: buscarPista
+// Busca iterativa de uma pista; devolve o handle dela ou
+// TEXTO_INEXISTENTE se não foi coletada
+// -------------------------------------------------------
+HandleTexto buscarPista(const ArvorePistas *arvore, const char *texto) {
+    const NoBMais *no = arvore->raiz;
+    HandleTexto pista = buscarTexto(texto);
+    int igual;
+
+    if (no == NULL || pista == TEXTO_INEXISTENTE) return TEXTO_INEXISTENTE;
+
+    unsigned long long prefixo = prefixoPista(textoDe(pista));
+    while (!no->folha) {
+        int pos = posicaoNoBMais(no, prefixo, pista, &igual);
+        no = no->filhos[igual ? pos + 1 : pos];
+    }
+
+    int pos = posicaoNoBMais(no, prefixo, pista, &igual);
+    return igual ? no->pistas[pos] : TEXTO_INEXISTENTE;
+}
+
+// -------------------------------------------------------
+// Função: exibirPistas
+// Percorre as folhas encadeadas e mostra todas as pistas
+// -------------------------------------------------------
+void renderizarPistas(Tela *tela, const ArvorePistas *arvore) {
+    for (const NoBMais *folha = arvore->primeiraFolha; folha != NULL; folha = folha->proximo) {
+        for (int i = 0; i < folha->quantidade; i++) {
+            TELA_FIXO(tela, "- ");
+            telaTexto(tela, folha->pistas[i]);
+            TELA_FIXO(tela, "\n");
+        }
+    }
+}
+
+void exibirPistas(const ArvorePistas *arvore) {
+    Tela tela;
+
+    iniciarTela(&tela);
+    renderizarPistas(&tela, arvore);
+    descarregarTela(&tela);
+}
+
+// -------------------------------------------------------
+// Consultas por intervalo e por prefixo
+// A busca desce até a primeira pista >= texto (que não
+// precisa estar no pool) e daí segue pelas folhas: custa
+// O(log n + k) para k pistas no resultado.
+// -------------------------------------------------------
+
+// Compara um texto qualquer com a chave 'i' do nó
+int compararTextoComChave(unsigned long long prefixo, const char *texto,
+                          const NoBMais *no, int i) {
+    if (prefixo != no->prefixos[i]) {
+        return (prefixo < no->prefixos[i]) ? -1 : 1;
+    }
+    if ((prefixo & 0xFF) == 0) {
+        return 0; // os dois textos acabam dentro do prefixo
+    }
+    return strcmp(texto + 8, textoDe(no->pistas[i]) + 8);
+}
+
+// Primeira chave do nó que é >= texto ('*igual' se for ele)
+int posicaoTextoNoBMais(const NoBMais *no, unsigned long long prefixo,
+                        const char *texto, int *igual) {
+    int ini = 0, fim = no->quantidade;
+
+    *igual = 0;
+    while (ini < fim) {
+        int meio = (ini + fim) / 2;
+        int cmp = compararTextoComChave(prefixo, texto, no, meio);
+        if (cmp == 0) {
+            *igual = 1;
+            return meio;
+        }
+        if (cmp > 0) {
+            ini = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return ini;
+}
+
+// Posiciona o cursor na primeira pista >= texto, sem fim
+void posicionarCursor(const ArvorePistas *arvore, const char *texto, CursorPistas *cursor) {
+    const NoBMais *no = arvore->raiz;
+    unsigned long long prefixo = prefixoPista(texto);
+    int igual;
+
+    cursor->folha = NULL;
+    cursor->pos = 0;
+    cursor->limite = NULL;
+    cursor->tamPrefixo = 0;
+    if (no == NULL) return;
+
+    while (!no->folha) {
+        int pos = posicaoTextoNoBMais(no, prefixo, texto, &igual);
+        no = no->filhos[igual ? pos + 1 : pos];
+    }
+    cursor->folha = no;
+    cursor->pos = posicaoTextoNoBMais(no, prefixo, texto, &igual);
+}
+
+// Pistas em [inicio, fim) em ordem alfabética (fim NULL =
+// até a última)
+void posicionarIntervalo(const ArvorePistas *arvore, const char *inicio, const char *fim,
+                         CursorPistas *cursor) {
+    posicionarCursor(arvore, inicio, cursor);
+    cursor->limite = fim;
+}
+
+// Pistas que começam com 'prefixo'
+void posicionarPrefixo(const ArvorePistas *arvore, const char *prefixo, CursorPistas *cursor) {
+    posicionarCursor(arvore, prefixo, cursor);
+    cursor->tamPrefixo = strlen(prefixo);
+    cursor->limite = (cursor->tamPrefixo > 0) ? prefixo : NULL;
+}
+
+// Pista sob o cursor, avançando-o (TEXTO_INEXISTENTE no fim
+// da árvore ou da consulta)
+HandleTexto proximaPista(CursorPistas *cursor) {
+    while (cursor->folha != NULL && cursor->pos >= cursor->folha->quantidade) {
+        cursor->folha = cursor->folha->proximo;
+        cursor->pos = 0;
+    }
+    if (cursor->folha == NULL) {
+        return TEXTO_INEXISTENTE;
+    }
+
+    HandleTexto pista = cursor->folha->pistas[cursor->pos];
+    if (cursor->limite != NULL &&
+        ((cursor->tamPrefixo == 0) ? strcmp(textoDe(pista), cursor->limite) >= 0
+                                   : strncmp(textoDe(pista), cursor->limite, cursor->tamPrefixo) != 0)) {
+        cursor->folha = NULL;
+        return TEXTO_INEXISTENTE;
+    }
+    cursor->pos++;
+    return pista;
+}
+
+// -------------------------------------------------------
+// Função: renderizarCursor
+// Mostra as pistas que restam no cursor e retorna quantas
+// foram (modos --intervalo e --prefixo)
+// -------------------------------------------------------
+int renderizarCursor(Tela *tela, CursorPistas *cursor) {
+    HandleTexto pista;
+    int quantidade = 0;
+
+    while ((pista = proximaPista(cursor)) != TEXTO_INEXISTENTE) {
+        TELA_FIXO(tela, "- ");
+        telaTexto(tela, pista);
+        TELA_FIXO(tela, "\n");
+        quantidade++;
+    }
+    return quantidade;
+}
+
+// -------------------------------------------------------
+// Funções do índice radix
+// -------------------------------------------------------
+NoRadix* criarNoRadix(IndiceRadix *indice, HandleTexto origem, unsigned int inicio,
+                      unsigned int tamanho) {
+    NoRadix *no = (NoRadix *)alocarArena(indice->arena, sizeof(NoRadix));
+    no->origem = origem;
+    no->inicio = inicio;
+    no->tamanho = tamanho;
+    no->primeiro = (tamanho > 0) ? (unsigned char)textoDe(origem)[inicio] : 0;
+    no->pista = TEXTO_INEXISTENTE;
+    no->total = 0;
+    no->filho = NULL;
+    no->irmao = NULL;
+    return no;
+}
+
+void inicializarRadix(IndiceRadix *indice, Arena *arena) {
+    indice->arena = arena;
+    indice->raiz = criarNoRadix(indice, TEXTO_VAZIO, 0, 0);
+}
+
+const char* rotuloRadix(const NoRadix *no) {
+    return textoDe(no->origem) + no->inicio;
+}
+
+// Filho cujo rótulo começa com 'c'; em '*anterior' fica o
+// elo onde um filho novo com esse byte deveria entrar
+NoRadix* filhoRadix(NoRadix *no, unsigned char c, NoRadix ***anterior) {
+    NoRadix **elo = &no->filho;
+    while (*elo != NULL && (*elo)->primeiro < c) {
+        elo = &(*elo)->irmao;
+    }
+    *anterior = elo;
+    return (*elo != NULL && (*elo)->primeiro == c) ? *elo : NULL;
+}
+
+// -------------------------------------------------------
+// Função: inserirNoRadix
+// Desce consumindo o texto; quando ele diverge no meio de
+// um rótulo, a aresta é dividida em duas. Retorna 1 se a
+// pista era nova (e então soma 1 no total do caminho).
+// -------------------------------------------------------
+int inserirNoRadix(IndiceRadix *indice, HandleTexto pista) {
+    NoRadix *caminho[TAM_PISTA + 1];
+    int tamCaminho = 0;
+    NoRadix *no = indice->raiz;
+    const char *texto;
+    unsigned int tamanho, i = 0;
+
+    if (pista == TEXTO_VAZIO || pista == TEXTO_INEXISTENTE) return 0;
+    texto = textoDe(pista);
+    tamanho = (unsigned int)strlen(texto);
+
+    while (1) {
+        caminho[tamCaminho++] = no;
+        if (i == tamanho) {
+            if (no->pista != TEXTO_INEXISTENTE) return 0; // já indexada
+            no->pista = pista;
+            break;
+        }
+
+        NoRadix **elo;
+        NoRadix *filho = filhoRadix(no, (unsigned char)texto[i], &elo);
+        if (filho == NULL) {
+            NoRadix *folha = criarNoRadix(indice, pista, i, tamanho - i);
+            folha->pista = pista;
+            folha->total = 1;
+            folha->irmao = *elo;
+            *elo = folha;
+            break;
+        }
+
+        const char *rotulo = rotuloRadix(filho);
+        unsigned int comum = 1;
+        while (comum < filho->tamanho && i + comum < tamanho && rotulo[comum] == texto[i + comum]) {
+            comum++;
+        }
+        if (comum < filho->tamanho) {
+            // Divide a aresta: 'meio' fica com o trecho comum
+            NoRadix *meio = criarNoRadix(indice, filho->origem, filho->inicio, comum);
+            meio->total = filho->total;
+            meio->irmao = filho->irmao;
+            meio->filho = filho;
+            filho->irmao = NULL;
+            filho->inicio += comum;
+            filho->tamanho -= comum;
+            filho->primeiro = (unsigned char)rotulo[comum];
+            *elo = meio;
+            filho = meio;
+        }
+        no = filho;
+        i += comum;
+    }
+
+    for (int k = 0; k < tamCaminho; k++) {
+        caminho[k]->total++;
+    }
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: listarPrefixoRadix
+// Retorna quantas pistas começam com 'prefixo' (O(|prefixo|))
+// e copia até 'max' delas, em ordem alfabética, para 'saida'
+// -------------------------------------------------------
+unsigned int listarPrefixoRadix(const IndiceRadix *indice, const char *prefixo,
+                                HandleTexto *saida, unsigned int max) {
+    NoRadix *no = indice->raiz;
+    size_t tamanho = strlen(prefixo);
+    size_t i = 0;
+
+    while (i < tamanho) {
+        NoRadix **elo;
+        NoRadix *filho = filhoRadix(no, (unsigned char)prefixo[i], &elo);
+        if (filho == NULL) return 0;
+
+        size_t resto = tamanho - i;
+        size_t comparar = (resto < filho->tamanho) ? resto : filho->tamanho;
+        if (comparar > 1 && memcmp(rotuloRadix(filho) + 1, prefixo + i + 1, comparar - 1) != 0) return 0;
+        no = filho;
+        i += comparar;
+    }
+
+    // Pré-ordem da subárvore: o nó antes dos filhos, e os
+    // filhos em ordem de byte, dá a ordem alfabética
+    NoRadix *pilha[2 * TAM_PISTA + 2];
+    int topo = 0;
+    unsigned int copiadas = 0;
+
+    pilha[topo++] = no;
+    while (topo > 0 && copiadas < max) {
+        NoRadix *atual = pilha[--topo];
+        if (atual != no && atual->irmao != NULL) {
+            pilha[topo++] = atual->irmao;
+        }
+        if (atual->pista != TEXTO_INEXISTENTE) {
+            saida[copiadas++] = atual->pista;
+        }
+        if (atual->filho != NULL) {
+            pilha[topo++] = atual->filho;
+        }
+    }
+    return no->total;
+}
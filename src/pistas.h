@@ -0,0 +1,97 @@
+#ifndef PISTAS_H
+#define PISTAS_H
+
+#include "arena.h"
+#include "textos.h"
+#include "tela.h"
+
+#define ORDEM_BMAIS     32   // máximo de chaves por nó da árvore B+ de pistas
+#define ALTURA_MAX_BMAIS 16  // com 16+ chaves por nó, 16 níveis passam de 10^19 pistas
+
+// -------------------------------------------------------
+// Árvore B+ de Pistas
+// Cada nó guarda até ORDEM_BMAIS chaves. A chave é um
+// prefixo de 8 bytes (comparado como inteiro) mais o
+// handle do texto completo, então a maior parte das
+// comparações nem toca a string. As pistas ficam só nas
+// folhas, que são encadeadas: listar tudo em ordem é uma
+// varredura sequencial, sem percorrer ponteiros de nó em nó.
+// -------------------------------------------------------
+typedef struct NoBMais {
+    int folha;                        // 1 = folha, 0 = nó interno
+    int quantidade;                   // chaves em uso
+    unsigned long long prefixos[ORDEM_BMAIS + 1];  // +1: estouro antes da divisão
+    HandleTexto pistas[ORDEM_BMAIS + 1];           // texto completo de cada chave
+    struct NoBMais *filhos[ORDEM_BMAIS + 2];       // só nos internos
+    struct NoBMais *proximo;          // próxima folha (só nas folhas)
+} NoBMais;
+
+// Chave da árvore de pistas fora de um nó (inserção em lote).
+// 'sufixo' guarda os bytes 8..15 para a ordenação raramente
+// precisar ir até o texto.
+typedef struct ChavePista {
+    unsigned long long prefixo;
+    unsigned long long sufixo;
+    HandleTexto pista;
+} ChavePista;
+
+typedef struct ArvorePistas {
+    Arena *arena;                     // de onde saem os nós
+    NoBMais *raiz;
+    NoBMais *primeiraFolha;
+    int quantidade;                   // pistas distintas armazenadas
+} ArvorePistas;
+
+// Posição de leitura nas folhas da árvore de pistas, com o
+// fim opcional da consulta: a primeira pista >= 'limite'
+// (intervalo) ou a primeira sem o prefixo 'limite' (prefixo)
+typedef struct CursorPistas {
+    const NoBMais *folha;             // NULL = fim
+    int pos;
+    const char *limite;               // NULL = até a última pista
+    size_t tamPrefixo;                // 0 = intervalo; > 0 = prefixo de 'limite'
+} CursorPistas;
+
+// -------------------------------------------------------
+// Índice radix (trie comprimida) opcional para busca por
+// prefixo. Cada aresta guarda um trecho do texto de alguma
+// pista (sem copiar caracteres) e cada nó sabe quantas
+// pistas há abaixo dele, então contar as pistas com um
+// prefixo custa O(tamanho do prefixo).
+// -------------------------------------------------------
+typedef struct NoRadix {
+    HandleTexto origem;               // pista cujo texto contém o rótulo
+    unsigned int inicio;              // rótulo: textoDe(origem)[inicio, inicio + tamanho)
+    unsigned int tamanho;
+    unsigned char primeiro;           // primeiro byte do rótulo (evita ir ao pool)
+    HandleTexto pista;                // pista que termina aqui (ou TEXTO_INEXISTENTE)
+    unsigned int total;               // pistas nesta subárvore
+    struct NoRadix *filho;            // primeiro filho (em ordem do primeiro byte)
+    struct NoRadix *irmao;
+} NoRadix;
+
+typedef struct IndiceRadix {
+    Arena *arena;
+    NoRadix *raiz;                    // rótulo vazio
+} IndiceRadix;
+
+void inicializarPistas(ArvorePistas *arvore, Arena *arena);
+int inserirPista(ArvorePistas *arvore, HandleTexto pista);
+int inserirPistasEmLote(ArvorePistas *arvore, const HandleTexto *pistas, size_t n);
+HandleTexto buscarPista(const ArvorePistas *arvore, const char *pista);
+void exibirPistas(const ArvorePistas *arvore);
+void posicionarCursor(const ArvorePistas *arvore, const char *texto, CursorPistas *cursor);
+void posicionarIntervalo(const ArvorePistas *arvore, const char *inicio, const char *fim,
+                         CursorPistas *cursor);
+void posicionarPrefixo(const ArvorePistas *arvore, const char *prefixo, CursorPistas *cursor);
+HandleTexto proximaPista(CursorPistas *cursor);
+
+void renderizarPistas(Tela *tela, const ArvorePistas *arvore);
+int renderizarCursor(Tela *tela, CursorPistas *cursor);
+
+void inicializarRadix(IndiceRadix *indice, Arena *arena);
+int inserirNoRadix(IndiceRadix *indice, HandleTexto pista);
+unsigned int listarPrefixoRadix(const IndiceRadix *indice, const char *prefixo,
+                                HandleTexto *saida, unsigned int max);
+
+#endif
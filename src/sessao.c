@@ -0,0 +1,372 @@
+#include "sessao.h"
+#include "arquivos.h"
+
+// -------------------------------------------------------
+// Sessão persistente
+// -------------------------------------------------------
+
+// Caminho 'base' + 'extensao' (alocado)
+char* juntarCaminho(const char *base, const char *extensao) {
+    size_t tamBase = strlen(base);
+    size_t tamExtensao = strlen(extensao);
+    char *caminho = (char *)malloc(tamBase + tamExtensao + 1);
+
+    if (caminho == NULL) {
+        printf("Erro ao alocar memoria para o caminho da sessao.\n");
+        exit(1);
+    }
+    memcpy(caminho, base, tamBase);
+    memcpy(caminho + tamBase, extensao, tamExtensao + 1);
+    return caminho;
+}
+
+// Verificação de um registro do diário. Usa sempre o hash
+// multiplicativo, independente de VERSAO_HASH_TEXTO, para o
+// diário continuar legível se a função do pool mudar.
+unsigned int somaRegistro(const char *pista, size_t tamPista,
+                          const char *suspeito, size_t tamSuspeito) {
+    unsigned int soma = hashMultiplicativo(pista, tamPista);
+    soma ^= hashMultiplicativo(suspeito, tamSuspeito) * 0x9E3779B1u;
+    return soma ^ (unsigned int)((tamPista << 16) | tamSuspeito);
+}
+
+// Aplica uma pista recuperada: mesma regra de explorarSalas
+void aplicarPistaSessao(ArvorePistas *pistas, TabelaHash *tabela,
+                        HandleTexto pista, HandleTexto suspeito) {
+    inserirPista(pistas, pista);
+    if (suspeito != TEXTO_VAZIO) {
+        inserirNaHashPorHandle(tabela, pista, suspeito);
+    }
+}
+
+// -------------------------------------------------------
+// Função: gravarRetrato
+// Grava as pistas em ordem (varredura das folhas da B+)
+// com o suspeito de cada uma. O arquivo é escrito ao lado,
+// sincronizado e renomeado por cima do anterior, e a pasta
+// é sincronizada em seguida: um retrato nunca fica pela
+// metade, nem mesmo se a máquina cair logo depois.
+// -------------------------------------------------------
+int gravarRetrato(const char *caminho, const ArvorePistas *pistas, TabelaHash *tabela) {
+    CabecalhoRetrato cab;
+    ParRetrato *pares = NULL;
+    char *textos = NULL;
+    size_t usoTextos = 0;
+    size_t capTextos = 0;
+    unsigned int n = 0;
+    CursorPistas cursor;
+    HandleTexto pista;
+    FILE *arquivo;
+    int ok;
+
+    if (pistas->quantidade > 0) {
+        pares = (ParRetrato *)realocarOuSair(NULL, pistas->quantidade * sizeof(ParRetrato));
+    }
+    posicionarCursor(pistas, "", &cursor);
+    while ((pista = proximaPista(&cursor)) != TEXTO_INEXISTENTE) {
+        HandleTexto suspeito = encontrarSuspeitoPorHandle(tabela, pista);
+        const char *textoPista = textoDe(pista);
+        const char *textoSuspeito = (suspeito != TEXTO_INEXISTENTE) ? textoDe(suspeito) : "";
+        size_t tamPista = strlen(textoPista);
+        size_t tamSuspeito = strlen(textoSuspeito);
+
+        while (usoTextos + tamPista + tamSuspeito + 2 > capTextos) {
+            capTextos = (capTextos == 0) ? 4096 : capTextos * 2;
+            textos = (char *)realocarOuSair(textos, capTextos);
+        }
+        pares[n].desPista = (unsigned int)usoTextos;
+        pares[n].tamPista = (unsigned short)tamPista;
+        memcpy(textos + usoTextos, textoPista, tamPista + 1);
+        usoTextos += tamPista + 1;
+        pares[n].desSuspeito = (unsigned int)usoTextos;
+        pares[n].tamSuspeito = (unsigned short)tamSuspeito;
+        memcpy(textos + usoTextos, textoSuspeito, tamSuspeito + 1);
+        usoTextos += tamSuspeito + 1;
+        n++;
+    }
+
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magico, MAGICO_RETRATO, 8);
+    cab.numPares = n;
+    cab.tamTextos = usoTextos;
+    cab.desPares = alinhar8(sizeof(cab));
+    cab.desTextos = alinhar8(cab.desPares + (unsigned long long)n * sizeof(ParRetrato));
+    cab.soma = hashMultiplicativo((const char *)pares, n * sizeof(ParRetrato)) ^
+               hashMultiplicativo(textos, usoTextos);
+
+    char *temporario = juntarCaminho(caminho, ".tmp");
+    arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) {
+        printf("Nao foi possivel criar '%s'.\n", temporario);
+        free(temporario);
+        free(pares);
+        free(textos);
+        return 0;
+    }
+    ok = gravarBloco(arquivo, &cab, sizeof(cab), cab.desPares) &&
+         gravarBloco(arquivo, pares, n * sizeof(ParRetrato), cab.desTextos) &&
+         gravarBloco(arquivo, textos, usoTextos, cab.desTextos + usoTextos) &&
+         sincronizarArquivo(arquivo);
+    if (fclose(arquivo) != 0) {
+        ok = 0;
+    }
+#ifdef _WIN32
+    if (ok) remove(caminho); // rename não substitui no Windows
+#endif
+    if (ok && (rename(temporario, caminho) != 0 || !sincronizarPasta(caminho))) {
+        ok = 0;
+    }
+    if (!ok) {
+        printf("Erro ao gravar '%s'.\n", caminho);
+        remove(temporario);
+    }
+    free(temporario);
+    free(pares);
+    free(textos);
+    return ok;
+}
+
+// -------------------------------------------------------
+// Função: carregarRetrato
+// Mapeia o retrato e reconstrói árvore e hash em lote.
+// Retorna quantas pistas leu (0 sem retrato) ou -1 se o
+// arquivo existe mas está danificado.
+// -------------------------------------------------------
+int carregarRetrato(const char *caminho, ArvorePistas *pistas, TabelaHash *tabela) {
+    size_t tamanho;
+    void *mapa = mapearArquivo(caminho, &tamanho);
+    const CabecalhoRetrato *cab;
+
+    if (mapa == NULL) return 0;
+
+    cab = (const CabecalhoRetrato *)mapa;
+    if (tamanho < sizeof(*cab) || memcmp(cab->magico, MAGICO_RETRATO, 8) != 0 ||
+        !blocoValido(cab->desPares, (unsigned long long)cab->numPares * sizeof(ParRetrato), tamanho) ||
+        !blocoValido(cab->desTextos, cab->tamTextos, tamanho)) {
+        desmapearArquivo(mapa, tamanho);
+        return -1;
+    }
+
+    const ParRetrato *pares = (const ParRetrato *)((const char *)mapa + cab->desPares);
+    const char *textos = (const char *)mapa + cab->desTextos;
+    unsigned int soma = hashMultiplicativo((const char *)pares, cab->numPares * sizeof(ParRetrato)) ^
+                        hashMultiplicativo(textos, (size_t)cab->tamTextos);
+    if (soma != cab->soma) {
+        desmapearArquivo(mapa, tamanho);
+        return -1;
+    }
+    for (unsigned int i = 0; i < cab->numPares; i++) {
+        const ParRetrato *par = &pares[i];
+        if ((unsigned long long)par->desPista + par->tamPista >= cab->tamTextos ||
+            (unsigned long long)par->desSuspeito + par->tamSuspeito >= cab->tamTextos ||
+            textos[par->desPista + par->tamPista] != '\0' ||
+            textos[par->desSuspeito + par->tamSuspeito] != '\0') {
+            desmapearArquivo(mapa, tamanho);
+            return -1;
+        }
+    }
+
+    HandleTexto *handlesPistas = (HandleTexto *)realocarOuSair(NULL, (cab->numPares + 1) * sizeof(HandleTexto));
+    HandleTexto *comSuspeito = (HandleTexto *)realocarOuSair(NULL, (cab->numPares + 1) * sizeof(HandleTexto));
+    HandleTexto *suspeitos = (HandleTexto *)realocarOuSair(NULL, (cab->numPares + 1) * sizeof(HandleTexto));
+    size_t numSuspeitos = 0;
+
+    for (unsigned int i = 0; i < cab->numPares; i++) {
+        handlesPistas[i] = internarTexto(textos + pares[i].desPista, TAM_PISTA);
+        if (pares[i].tamSuspeito > 0) {
+            comSuspeito[numSuspeitos] = handlesPistas[i];
+            suspeitos[numSuspeitos] = internarTexto(textos + pares[i].desSuspeito, TAM_SUSPEITO);
+            numSuspeitos++;
+        }
+    }
+    inserirPistasEmLote(pistas, handlesPistas, cab->numPares);
+    inserirNaHashEmLote(tabela, comSuspeito, suspeitos, numSuspeitos);
+
+    int lidas = (int)cab->numPares;
+    free(handlesPistas);
+    free(comSuspeito);
+    free(suspeitos);
+    desmapearArquivo(mapa, tamanho);
+    return lidas;
+}
+
+// -------------------------------------------------------
+// Função: reproduzirDiario
+// Reaplica os registros do diário até o primeiro incompleto
+// ou com verificação errada (gravação interrompida). Em
+// '*intacto' fica 0 se sobraram bytes depois do último
+// registro bom. Retorna quantos registros aplicou.
+// -------------------------------------------------------
+unsigned int reproduzirDiario(const char *caminho, ArvorePistas *pistas, TabelaHash *tabela,
+                              int *intacto) {
+    char pista[TAM_PISTA];
+    char suspeito[TAM_SUSPEITO];
+    size_t tamanho;
+    const char *mapa = (const char *)mapearArquivo(caminho, &tamanho);
+    unsigned int aplicados = 0;
+
+    *intacto = 1;
+    if (mapa == NULL) return 0; // sem diário (ou vazio)
+
+    if (tamanho < 8 || memcmp(mapa, MAGICO_DIARIO, 8) != 0) {
+        *intacto = 0;
+        desmapearArquivo((void *)mapa, tamanho);
+        return 0;
+    }
+
+    size_t pos = 8;
+    while (pos < tamanho) {
+        RegistroDiario reg;
+
+        if (tamanho - pos < sizeof(reg)) break;
+        memcpy(&reg, mapa + pos, sizeof(reg));
+        if (reg.tamPista == 0 || reg.tamPista >= TAM_PISTA || reg.tamSuspeito >= TAM_SUSPEITO ||
+            tamanho - pos - sizeof(reg) < (size_t)reg.tamPista + reg.tamSuspeito) {
+            break;
+        }
+        const char *dados = mapa + pos + sizeof(reg);
+        if (somaRegistro(dados, reg.tamPista, dados + reg.tamPista, reg.tamSuspeito) != reg.soma) {
+            break;
+        }
+
+        memcpy(pista, dados, reg.tamPista);
+        pista[reg.tamPista] = '\0';
+        memcpy(suspeito, dados + reg.tamPista, reg.tamSuspeito);
+        suspeito[reg.tamSuspeito] = '\0';
+        aplicarPistaSessao(pistas, tabela, internarTexto(pista, TAM_PISTA),
+                           internarTexto(suspeito, TAM_SUSPEITO));
+        aplicados++;
+        pos += sizeof(reg) + reg.tamPista + reg.tamSuspeito;
+    }
+
+    if (pos != tamanho) {
+        *intacto = 0;
+    }
+    desmapearArquivo((void *)mapa, tamanho);
+    return aplicados;
+}
+
+// Recomeça o diário vazio (só a assinatura), já no disco
+int novoDiario(SessaoPersistente *sessao) {
+    if (sessao->diario != NULL) {
+        fclose(sessao->diario);
+    }
+    sessao->diario = fopen(sessao->caminhoDiario, "wb");
+    sessao->registros = 0;
+    if (sessao->diario == NULL ||
+        fwrite(MAGICO_DIARIO, 1, 8, sessao->diario) != 8 || !sincronizarArquivo(sessao->diario) ||
+        !sincronizarPasta(sessao->caminhoDiario)) {
+        printf("Nao foi possivel criar '%s'.\n", sessao->caminhoDiario);
+        return 0;
+    }
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: compactarSessao
+// Grava um retrato do estado e esvazia o diário. Se o
+// processo cair entre as duas coisas, o diário antigo é
+// reaplicado sobre o retrato novo, o que não muda nada
+// (inserir a mesma pista de novo é inofensivo).
+// -------------------------------------------------------
+int compactarSessao(SessaoPersistente *sessao, const ArvorePistas *pistas, TabelaHash *tabela) {
+    if (!gravarRetrato(sessao->caminhoRetrato, pistas, tabela)) {
+        return 0;
+    }
+    return novoDiario(sessao);
+}
+
+// -------------------------------------------------------
+// Função: abrirSessao
+// Retoma a sessão 'base': carrega base.retrato, reaplica
+// base.diario e deixa o diário pronto para novos registros.
+// Um diário com o fim danificado é compactado na hora, para
+// que os próximos registros não fiquem depois do lixo.
+// -------------------------------------------------------
+int abrirSessao(SessaoPersistente *sessao, const char *base,
+                ArvorePistas *pistas, TabelaHash *tabela) {
+    int intacto;
+
+    sessao->caminhoDiario = juntarCaminho(base, ".diario");
+    sessao->caminhoRetrato = juntarCaminho(base, ".retrato");
+    sessao->diario = NULL;
+    sessao->registros = 0;
+
+    int doRetrato = carregarRetrato(sessao->caminhoRetrato, pistas, tabela);
+    if (doRetrato < 0) {
+        printf("Aviso: '%s' esta danificado e foi ignorado.\n", sessao->caminhoRetrato);
+        doRetrato = 0;
+    }
+    unsigned int doDiario = reproduzirDiario(sessao->caminhoDiario, pistas, tabela, &intacto);
+
+    if (doRetrato > 0 || doDiario > 0) {
+        printf("Sessao retomada: %u pista(s) (%d do retrato, %u do diario).\n",
+               pistas->quantidade, doRetrato, doDiario);
+    }
+    if (!intacto) {
+        printf("Aviso: o fim de '%s' estava incompleto e foi descartado.\n", sessao->caminhoDiario);
+        return compactarSessao(sessao, pistas, tabela);
+    }
+
+    sessao->diario = fopen(sessao->caminhoDiario, "ab");
+    if (sessao->diario == NULL) {
+        printf("Nao foi possivel abrir '%s'.\n", sessao->caminhoDiario);
+        return 0;
+    }
+    if (fseek(sessao->diario, 0, SEEK_END) != 0 || ftell(sessao->diario) == 0) {
+        return novoDiario(sessao);
+    }
+    sessao->registros = doDiario;
+    return 1;
+}
+
+// -------------------------------------------------------
+// Função: registrarPistaSessao
+// Acrescenta a pista coletada ao diário e o sincroniza com
+// o disco (fsync) antes de seguir: o registro sobrevive à
+// queda do processo e da máquina. A sessão é compactada
+// quando o diário passa de REGISTROS_POR_RETRATO registros
+// e da metade das pistas: o retrato custa O(n), então
+// regravá-lo a cada n/2 registros sai O(1) por pista.
+// -------------------------------------------------------
+int registrarPistaSessao(SessaoPersistente *sessao, HandleTexto pista, HandleTexto suspeito,
+                         const ArvorePistas *pistas, TabelaHash *tabela) {
+    RegistroDiario reg;
+    const char *textoPista = textoDe(pista);
+    const char *textoSuspeito = textoDe(suspeito);
+
+    if (sessao->diario == NULL) return 0;
+
+    reg.tamPista = (unsigned short)strlen(textoPista);
+    reg.tamSuspeito = (unsigned short)strlen(textoSuspeito);
+    reg.soma = somaRegistro(textoPista, reg.tamPista, textoSuspeito, reg.tamSuspeito);
+    if (fwrite(&reg, sizeof(reg), 1, sessao->diario) != 1 ||
+        fwrite(textoPista, 1, reg.tamPista, sessao->diario) != reg.tamPista ||
+        fwrite(textoSuspeito, 1, reg.tamSuspeito, sessao->diario) != reg.tamSuspeito ||
+        !sincronizarArquivo(sessao->diario)) {
+        printf("Erro ao gravar '%s'.\n", sessao->caminhoDiario);
+        return 0;
+    }
+
+    sessao->registros++;
+    if (sessao->registros >= REGISTROS_POR_RETRATO &&
+        sessao->registros >= (unsigned int)pistas->quantidade / 2) {
+        return compactarSessao(sessao, pistas, tabela);
+    }
+    return 1;
+}
+
+// Compacta o que ficou no diário e fecha a sessão
+void fecharSessao(SessaoPersistente *sessao, const ArvorePistas *pistas, TabelaHash *tabela) {
+    if (sessao->diario != NULL && sessao->registros > 0) {
+        compactarSessao(sessao, pistas, tabela);
+    }
+    if (sessao->diario != NULL) {
+        fclose(sessao->diario);
+    }
+    free(sessao->caminhoDiario);
+    free(sessao->caminhoRetrato);
+    sessao->diario = NULL;
+    sessao->caminhoDiario = NULL;
+    sessao->caminhoRetrato = NULL;
+}
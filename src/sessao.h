@@ -0,0 +1,57 @@
+#ifndef SESSAO_H
+#define SESSAO_H
+
+#include "pistas.h"
+#include "hash.h"
+
+#define MAGICO_DIARIO       "DQDIAR01"   // assinatura do diário da sessão
+#define MAGICO_RETRATO      "DQRETR01"   // assinatura do retrato da sessão
+#define REGISTROS_POR_RETRATO 256        // mínimo de registros no diário antes de compactar
+
+// -------------------------------------------------------
+// Sessão persistente (--sessao base). Cada pista coletada
+// é acrescentada a um diário (base.diario) antes de seguir
+// o jogo; de tempos em tempos o estado inteiro vira um
+// retrato compacto (base.retrato) e o diário recomeça. Na
+// retomada o retrato é mapeado e o diário, reaplicado.
+// Registro do diário: RegistroDiario + pista + suspeito,
+// sem '\0'. Retrato: cabeçalho | pares em ordem | textos
+// (com '\0'), blocos alinhados em 8 bytes.
+// -------------------------------------------------------
+typedef struct RegistroDiario {
+    unsigned short tamPista;          // 1..TAM_PISTA-1
+    unsigned short tamSuspeito;       // 0 = pista sem suspeito
+    unsigned int soma;                // verificação (somaRegistro)
+} RegistroDiario;
+
+typedef struct CabecalhoRetrato {
+    char magico[8];                   // MAGICO_RETRATO
+    unsigned int numPares;
+    unsigned int soma;                // verificação de pares e textos
+    unsigned long long tamTextos;
+    unsigned long long desPares;
+    unsigned long long desTextos;
+} CabecalhoRetrato;
+
+typedef struct ParRetrato {
+    unsigned int desPista;            // deslocamentos na área de textos
+    unsigned int desSuspeito;
+    unsigned short tamPista;
+    unsigned short tamSuspeito;       // 0 = pista sem suspeito
+} ParRetrato;
+
+typedef struct SessaoPersistente {
+    FILE *diario;                     // NULL = sessão sem arquivo
+    char *caminhoDiario;
+    char *caminhoRetrato;
+    unsigned int registros;           // registros no diário desde o último retrato
+} SessaoPersistente;
+
+int abrirSessao(SessaoPersistente *sessao, const char *base,
+                ArvorePistas *pistas, TabelaHash *tabela);
+int registrarPistaSessao(SessaoPersistente *sessao, HandleTexto pista, HandleTexto suspeito,
+                         const ArvorePistas *pistas, TabelaHash *tabela);
+int compactarSessao(SessaoPersistente *sessao, const ArvorePistas *pistas, TabelaHash *tabela);
+void fecharSessao(SessaoPersistente *sessao, const ArvorePistas *pistas, TabelaHash *tabela);
+
+#endif
@@ -0,0 +1,105 @@
+#include "tela.h"
+
+// -------------------------------------------------------
+// Funções da Tela
+// -------------------------------------------------------
+void iniciarTela(Tela *tela) {
+    tela->numPartes = 0;
+    tela->usoRascunho = 0;
+#ifdef SEM_WRITEV
+    tela->interativa = 1;
+#else
+    tela->interativa = isatty(STDOUT_FILENO);
+#endif
+}
+
+// Acrescenta 'dados' por referência: precisam viver até o descarregamento
+void telaParte(Tela *tela, const char *dados, size_t tamanho) {
+    if (tamanho == 0) return;
+    if (tela->numPartes == PARTES_TELA) {
+        descarregarTela(tela);
+    }
+    tela->partes[tela->numPartes].iov_base = (void *)dados;
+    tela->partes[tela->numPartes].iov_len = tamanho;
+    tela->numPartes++;
+}
+
+void telaTexto(Tela *tela, HandleTexto handle) {
+    telaParte(tela, textoDe(handle), poolTextos.entradas[handle].tamanho);
+}
+
+// Acrescenta uma cópia de 'dados' (texto que não dura até o descarregamento)
+void telaCopia(Tela *tela, const char *dados, size_t tamanho) {
+    if (tamanho > TAM_RASCUNHO_TELA) {
+        // maior que o rascunho: sai direto, depois do que já foi montado
+        descarregarTela(tela);
+        telaParte(tela, dados, tamanho);
+        descarregarTela(tela);
+        return;
+    }
+    if (tela->usoRascunho + tamanho > TAM_RASCUNHO_TELA || tela->numPartes == PARTES_TELA) {
+        descarregarTela(tela);
+    }
+    memcpy(&tela->rascunho[tela->usoRascunho], dados, tamanho);
+    telaParte(tela, &tela->rascunho[tela->usoRascunho], tamanho);
+    tela->usoRascunho += tamanho;
+}
+
+void telaInteiro(Tela *tela, int valor) {
+    char digitos[12];
+    int pos = (int)sizeof(digitos);
+    unsigned int resto = (valor < 0) ? 0u - (unsigned int)valor : (unsigned int)valor;
+
+    do {
+        digitos[--pos] = (char)('0' + resto % 10);
+        resto /= 10;
+    } while (resto > 0);
+    if (valor < 0) digitos[--pos] = '-';
+    telaCopia(tela, &digitos[pos], sizeof(digitos) - (size_t)pos);
+}
+
+// -------------------------------------------------------
+// Função: descarregarTela
+// Escreve as partes montadas na saída padrão. O que o
+// printf ainda guarda no buffer do stdio sai antes, para
+// manter a ordem do texto.
+// -------------------------------------------------------
+void descarregarTela(Tela *tela) {
+    struct iovec *partes = tela->partes;
+    int restantes = tela->numPartes;
+
+    fflush(stdout);
+#ifdef SEM_WRITEV
+    for (int i = 0; i < restantes; i++) {
+        fwrite(partes[i].iov_base, 1, partes[i].iov_len, stdout);
+    }
+    fflush(stdout);
+#else
+    while (restantes > 0) {
+        ssize_t escritos = writev(STDOUT_FILENO, partes, restantes);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            break; // saída fechada: como no printf, o texto se perde
+        }
+        // escrita parcial: pula as partes completas e avança na primeira pendente
+        while (restantes > 0 && (size_t)escritos >= partes->iov_len) {
+            escritos -= (ssize_t)partes->iov_len;
+            partes++;
+            restantes--;
+        }
+        if (restantes > 0) {
+            partes->iov_base = (char *)partes->iov_base + escritos;
+            partes->iov_len -= (size_t)escritos;
+        }
+    }
+#endif
+    tela->numPartes = 0;
+    tela->usoRascunho = 0;
+}
+
+// Antes de ler a entrada: o texto montado tem que estar visível
+void mostrarTela(Tela *tela) {
+    if (tela->interativa) {
+        descarregarTela(tela);
+    }
+}
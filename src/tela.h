@@ -0,0 +1,46 @@
+#ifndef TELA_H
+#define TELA_H
+
+#include "textos.h"
+
+#define PARTES_TELA         1024         // pedaços de texto por writev (IOV_MAX do Linux)
+#define TAM_RASCUNHO_TELA   512          // bytes copiados (números, nome acusado) por tela
+
+// -------------------------------------------------------
+// Tela: o texto de um passo do jogo montado em partes.
+// Trechos fixos e textos do pool entram por referência;
+// só números e textos de fora do pool são copiados para o
+// rascunho. Tudo sai num único writev em descarregarTela.
+// No terminal cada passo sai antes de ler a escolha; com a
+// saída redirecionada os passos se acumulam até encher a
+// tela, como o stdio faria. As referências ao pool valem
+// até o próximo texto internado, então a tela é
+// descarregada antes disso.
+// -------------------------------------------------------
+#ifdef SEM_WRITEV
+struct iovec {
+    void *iov_base;
+    size_t iov_len;
+};
+#endif
+
+typedef struct Tela {
+    struct iovec partes[PARTES_TELA];
+    int numPartes;
+    char rascunho[TAM_RASCUNHO_TELA];
+    size_t usoRascunho;
+    int interativa;                // saída num terminal: mostrarTela descarrega
+} Tela;
+
+// Trecho fixo: o tamanho sai do literal em tempo de compilação
+#define TELA_FIXO(tela, literal) telaParte((tela), (literal), sizeof(literal) - 1)
+
+void iniciarTela(Tela *tela);
+void telaParte(Tela *tela, const char *dados, size_t tamanho);
+void telaTexto(Tela *tela, HandleTexto handle);
+void telaCopia(Tela *tela, const char *dados, size_t tamanho);
+void telaInteiro(Tela *tela, int valor);
+void descarregarTela(Tela *tela);
+void mostrarTela(Tela *tela);
+
+#endif
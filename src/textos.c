@@ -0,0 +1,343 @@
+#include "textos.h"
+
+// -------------------------------------------------------
+// Funções do pool de textos
+// -------------------------------------------------------
+PoolTextos poolTextos = { NULL, 0, 0, NULL, 0, 0, NULL, 0, 0 };
+
+// -------------------------------------------------------
+// Funções de hash de texto
+// Cada texto é hasheado uma única vez, ao ser internado; a
+// redução para o tamanho de cada tabela é feita por quem
+// usa, sempre com máscara (as capacidades são potências de
+// dois), então todos os bits do hash precisam ser bons.
+// -------------------------------------------------------
+
+// Polinomial (h * 31 + c), um byte por passo, sem mistura:
+// a função original, mantida só para comparação
+unsigned int hashPolinomialPuro(const char *chave, size_t tamanho) {
+    unsigned int h = 0;
+    for (size_t i = 0; i < tamanho; i++) {
+        h = (h * 31) + (unsigned char)chave[i];
+    }
+    return h;
+}
+
+// Polinomial seguido de uma mistura final dos bits: sem ela,
+// pistas parecidas ("... 1", "... 2") caem em slots vizinhos
+unsigned int hashPolinomial(const char *chave, size_t tamanho) {
+    unsigned int h = hashPolinomialPuro(chave, tamanho);
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Produto 64x64 -> 128 bits; devolve as duas metades em a e b
+void multiplicar128(unsigned long long *a, unsigned long long *b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)*a * *b;
+    *a = (unsigned long long)r;
+    *b = (unsigned long long)(r >> 64);
+#else
+    unsigned long long ha = *a >> 32, la = (unsigned int)*a;
+    unsigned long long hb = *b >> 32, lb = (unsigned int)*b;
+    unsigned long long hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    unsigned long long meio = (ll >> 32) + (unsigned int)hl + (unsigned int)lh;
+    *a = (meio << 32) | (unsigned int)ll;
+    *b = hh + (hl >> 32) + (lh >> 32) + (meio >> 32);
+#endif
+}
+
+// Mistura de dois valores: metade baixa XOR metade alta do produto
+unsigned long long misturar64(unsigned long long a, unsigned long long b) {
+    multiplicar128(&a, &b);
+    return a ^ b;
+}
+
+unsigned long long ler64(const char *p) {
+    unsigned long long v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+unsigned long long ler32(const char *p) {
+    unsigned int v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// -------------------------------------------------------
+// Função: hashMultiplicativo
+// Hash no estilo do wyhash: textos longos são consumidos 48
+// bytes por volta em três cadeias independentes (o
+// processador as multiplica em paralelo), depois de 16 em
+// 16; o fim é lido com leituras sobrepostas, sem laço por
+// byte. Textos de até 16 bytes fazem uma única mistura.
+// A versão de 64 bits aceita uma semente (o hash perfeito
+// troca de semente até achar uma que sirva); com semente 0
+// ela é exatamente o hash do pool antes da dobra.
+// -------------------------------------------------------
+unsigned long long hashTexto64(const char *chave, size_t tamanho, unsigned long long base) {
+    static const unsigned long long s0 = 0xa0761d6478bd642full;
+    static const unsigned long long s1 = 0xe7037ed1a0b428dbull;
+    static const unsigned long long s2 = 0x8ebc6af09c88c6e3ull;
+    static const unsigned long long s3 = 0x589965cc75374cc3ull;
+    const char *p = chave;
+    unsigned long long semente = misturar64(s0 ^ base, s1);
+    unsigned long long a, b;
+
+    if (tamanho <= 16) {
+        if (tamanho >= 4) {
+            size_t meio = (tamanho >> 3) << 2;
+            a = (ler32(p) << 32) | ler32(p + meio);
+            b = (ler32(p + tamanho - 4) << 32) | ler32(p + tamanho - 4 - meio);
+        } else if (tamanho > 0) {
+            a = ((unsigned long long)(unsigned char)p[0] << 16) |
+                ((unsigned long long)(unsigned char)p[tamanho >> 1] << 8) |
+                (unsigned char)p[tamanho - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t resto = tamanho;
+        if (resto > 48) {
+            unsigned long long cadeia1 = semente, cadeia2 = semente;
+            do {
+                semente = misturar64(ler64(p) ^ s1, ler64(p + 8) ^ semente);
+                cadeia1 = misturar64(ler64(p + 16) ^ s2, ler64(p + 24) ^ cadeia1);
+                cadeia2 = misturar64(ler64(p + 32) ^ s3, ler64(p + 40) ^ cadeia2);
+                p += 48;
+                resto -= 48;
+            } while (resto > 48);
+            semente ^= cadeia1 ^ cadeia2;
+        }
+        while (resto > 16) {
+            semente = misturar64(ler64(p) ^ s1, ler64(p + 8) ^ semente);
+            p += 16;
+            resto -= 16;
+        }
+        a = ler64(p + resto - 16);
+        b = ler64(p + resto - 8);
+    }
+
+    a ^= s1;
+    b ^= semente;
+    multiplicar128(&a, &b);
+    return misturar64(a ^ s0 ^ tamanho, b ^ s1);
+}
+
+unsigned int hashMultiplicativo(const char *chave, size_t tamanho) {
+    unsigned long long h = hashTexto64(chave, tamanho, 0);
+    return (unsigned int)(h ^ (h >> 32));
+}
+
+const FuncaoHash funcoesHash[NUM_FUNCOES_HASH] = {
+    { "polinomial puro", hashPolinomialPuro },
+    { "polinomial + mistura", hashPolinomial },
+    { "multiplicativo", hashMultiplicativo },
+};
+
+// Hash usado pelo pool (ver VERSAO_HASH_TEXTO)
+unsigned int hashTexto(const char *chave, size_t tamanho) {
+#ifdef HASH_TEXTO_POLINOMIAL
+    return hashPolinomial(chave, tamanho);
+#else
+    return hashMultiplicativo(chave, tamanho);
+#endif
+}
+
+unsigned int hashFunc(const char *chave) {
+    return hashTexto(chave, strlen(chave));
+}
+
+void* realocarOuSair(void *ptr, size_t tamanho) {
+    void *novo = realloc(ptr, tamanho);
+    if (novo == NULL) {
+        printf("Erro ao alocar memoria para o pool de textos.\n");
+        exit(1);
+    }
+    return novo;
+}
+
+// Reconstrói o índice com 'novaCap' slots, usando os
+// hashes guardados (nenhum texto é lido de novo)
+void reconstruirIndicePool(unsigned int novaCap) {
+    HandleTexto *indice = (HandleTexto *)calloc(novaCap, sizeof(HandleTexto));
+    if (indice == NULL) {
+        printf("Erro ao alocar memoria para o pool de textos.\n");
+        exit(1);
+    }
+
+    for (HandleTexto h = 1; h < poolTextos.quantidade; h++) {
+        unsigned int pos = poolTextos.entradas[h].hash & (novaCap - 1);
+        while (indice[pos] != 0) {
+            pos = (pos + 1) & (novaCap - 1);
+        }
+        indice[pos] = h;
+    }
+
+    free(poolTextos.indice);
+    poolTextos.indice = indice;
+    poolTextos.capIndice = novaCap;
+}
+
+void crescerIndicePool(void) {
+    reconstruirIndicePool((poolTextos.capIndice == 0) ? 64 : poolTextos.capIndice * 2);
+}
+
+// Acrescenta um texto (de 'tamanho' bytes) ao fim do pool
+HandleTexto acrescentarAoPool(const char *texto, size_t tamanho, unsigned int hash) {
+    if (poolTextos.quantidade == poolTextos.capacidade) {
+        poolTextos.capacidade = (poolTextos.capacidade == 0) ? 64 : poolTextos.capacidade * 2;
+        poolTextos.entradas = (EntradaPool *)realocarOuSair(poolTextos.entradas,
+                                  poolTextos.capacidade * sizeof(EntradaPool));
+    }
+    if (poolTextos.usoTextos + tamanho + 1 > poolTextos.capTextos) {
+        size_t novaCap = (poolTextos.capTextos == 0) ? 4096 : poolTextos.capTextos * 2;
+        while (novaCap < poolTextos.usoTextos + tamanho + 1) {
+            novaCap *= 2;
+        }
+        poolTextos.textos = (char *)realocarOuSair(poolTextos.textos, novaCap);
+        poolTextos.capTextos = novaCap;
+    }
+
+    HandleTexto handle = poolTextos.quantidade++;
+    EntradaPool *entrada = &poolTextos.entradas[handle];
+    entrada->deslocamento = (unsigned int)poolTextos.usoTextos;
+    entrada->tamanho = (unsigned int)tamanho;
+    entrada->hash = hash;
+
+    memcpy(&poolTextos.textos[poolTextos.usoTextos], texto, tamanho);
+    poolTextos.textos[poolTextos.usoTextos + tamanho] = '\0';
+    poolTextos.usoTextos += tamanho + 1;
+
+    return handle;
+}
+
+// -------------------------------------------------------
+// Função auxiliar: tornarPoolProprio
+// Um pool carregado de arquivo aponta para a memória
+// mapeada (somente leitura); antes do primeiro texto novo,
+// os vetores são copiados para o heap
+// -------------------------------------------------------
+void tornarPoolProprio(void) {
+    EntradaPool *entradas = (EntradaPool *)malloc(poolTextos.quantidade * sizeof(EntradaPool));
+    char *textos = (char *)malloc(poolTextos.usoTextos);
+    HandleTexto *indice = (HandleTexto *)malloc(poolTextos.capIndice * sizeof(HandleTexto));
+    if (entradas == NULL || textos == NULL || indice == NULL) {
+        printf("Erro ao alocar memoria para o pool de textos.\n");
+        exit(1);
+    }
+
+    memcpy(entradas, poolTextos.entradas, poolTextos.quantidade * sizeof(EntradaPool));
+    memcpy(textos, poolTextos.textos, poolTextos.usoTextos);
+    memcpy(indice, poolTextos.indice, poolTextos.capIndice * sizeof(HandleTexto));
+
+    poolTextos.entradas = entradas;
+    poolTextos.capacidade = poolTextos.quantidade;
+    poolTextos.textos = textos;
+    poolTextos.capTextos = poolTextos.usoTextos;
+    poolTextos.indice = indice;
+    poolTextos.emprestado = 0;
+}
+
+// Cria o pool com o texto vazio no handle TEXTO_VAZIO
+void inicializarPoolTextos(void) {
+    acrescentarAoPool("", 0, hashFunc(""));
+    crescerIndicePool();
+}
+
+// -------------------------------------------------------
+// Função auxiliar: procurarNoPool
+// Devolve a posição do índice onde o texto está ou onde
+// deveria entrar (slot livre)
+// -------------------------------------------------------
+unsigned int procurarNoPool(const char *texto, size_t tamanho, unsigned int hash) {
+    unsigned int mascara = poolTextos.capIndice - 1;
+    unsigned int pos = hash & mascara;
+
+    while (poolTextos.indice[pos] != 0) {
+        const EntradaPool *e = &poolTextos.entradas[poolTextos.indice[pos]];
+        if (e->hash == hash && e->tamanho == tamanho &&
+            memcmp(&poolTextos.textos[e->deslocamento], texto, tamanho) == 0) {
+            break;
+        }
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+// -------------------------------------------------------
+// Função: internarTexto
+// Devolve o handle do texto (truncado em tamMax - 1
+// caracteres), acrescentando-o ao pool se ainda não existir
+// -------------------------------------------------------
+HandleTexto internarTexto(const char *texto, size_t tamMax) {
+    if (poolTextos.quantidade == 0) {
+        inicializarPoolTextos();
+    }
+    if (texto == NULL || texto[0] == '\0') {
+        return TEXTO_VAZIO;
+    }
+
+    size_t tamanho = strlen(texto);
+    if (tamanho > tamMax - 1) {
+        tamanho = tamMax - 1;
+    }
+
+    unsigned int hash = hashTexto(texto, tamanho);
+    unsigned int pos = procurarNoPool(texto, tamanho, hash);
+    if (poolTextos.indice[pos] != 0) {
+        return poolTextos.indice[pos];
+    }
+
+    if (poolTextos.emprestado) {
+        tornarPoolProprio();
+    }
+    HandleTexto handle = acrescentarAoPool(texto, tamanho, hash);
+    poolTextos.indice[pos] = handle;
+    if (poolTextos.quantidade * 2 > poolTextos.capIndice) {
+        crescerIndicePool();
+    }
+    return handle;
+}
+
+// -------------------------------------------------------
+// Função: buscarTexto
+// Handle de um texto já internado, sem acrescentar nada
+// (TEXTO_INEXISTENTE se ele nunca apareceu)
+// -------------------------------------------------------
+HandleTexto buscarTexto(const char *texto) {
+    if (texto == NULL || texto[0] == '\0') {
+        return TEXTO_VAZIO;
+    }
+    if (poolTextos.quantidade == 0) {
+        return TEXTO_INEXISTENTE;
+    }
+
+    unsigned int pos = procurarNoPool(texto, strlen(texto), hashFunc(texto));
+    return (poolTextos.indice[pos] != 0) ? poolTextos.indice[pos] : TEXTO_INEXISTENTE;
+}
+
+// Texto de um handle. O ponteiro vale até o próximo
+// internarTexto (o buffer do pool pode ser realocado).
+const char* textoDe(HandleTexto handle) {
+    return &poolTextos.textos[poolTextos.entradas[handle].deslocamento];
+}
+
+unsigned int hashDe(HandleTexto handle) {
+    return poolTextos.entradas[handle].hash;
+}
+
+void liberarPoolTextos(void) {
+    if (!poolTextos.emprestado) {
+        free(poolTextos.entradas);
+        free(poolTextos.textos);
+        free(poolTextos.indice);
+    }
+    memset(&poolTextos, 0, sizeof(poolTextos));
+}
@@ -0,0 +1,72 @@
+#ifndef TEXTOS_H
+#define TEXTOS_H
+
+#include "comum.h"
+
+#define TEXTO_VAZIO         0u           // handle do texto "" (sempre existe)
+#define TEXTO_INEXISTENTE   0xFFFFFFFFu  // texto que nunca foi internado
+
+// Função de hash dos textos. Os hashes ficam gravados no
+// arquivo binário, então cada função tem uma versão; compile
+// com -DHASH_TEXTO_POLINOMIAL para voltar à antiga.
+#ifdef HASH_TEXTO_POLINOMIAL
+#define VERSAO_HASH_TEXTO   0            // h * 31 + c com mistura final
+#else
+#define VERSAO_HASH_TEXTO   1            // multiplicação 64x64 -> 128, 8 a 48 bytes por passo
+#endif
+
+// -------------------------------------------------------
+// Pool global de textos internados
+// Cada texto distinto (nome de sala, pista, suspeito) é
+// guardado uma única vez, com tamanho e hash já calculados.
+// As estruturas guardam só o handle de 32 bits, e comparar
+// dois textos internados é comparar dois inteiros.
+// -------------------------------------------------------
+typedef unsigned int HandleTexto;
+
+typedef struct EntradaPool {
+    unsigned int deslocamento;  // início do texto em 'textos'
+    unsigned int tamanho;       // sem contar o '\0'
+    unsigned int hash;          // hashFunc do texto
+} EntradaPool;
+
+typedef struct PoolTextos {
+    EntradaPool *entradas;      // indexado pelo handle
+    unsigned int quantidade;
+    unsigned int capacidade;
+    char *textos;               // todos os textos, cada um com '\0'
+    size_t usoTextos;
+    size_t capTextos;
+    HandleTexto *indice;        // endereçamento aberto (0 = livre)
+    unsigned int capIndice;     // potência de 2
+    int emprestado;             // 1 = vetores dentro de um arquivo mapeado
+} PoolTextos;
+
+extern PoolTextos poolTextos;
+
+// Funções disponíveis, para a ferramenta de histograma
+typedef struct FuncaoHash {
+    const char *nome;
+    unsigned int (*funcao)(const char *chave, size_t tamanho);
+} FuncaoHash;
+
+#define NUM_FUNCOES_HASH 3
+extern const FuncaoHash funcoesHash[NUM_FUNCOES_HASH];
+
+unsigned int hashFunc(const char *chave);
+HandleTexto internarTexto(const char *texto, size_t tamMax);
+HandleTexto buscarTexto(const char *texto);
+const char* textoDe(HandleTexto handle);
+void liberarPoolTextos(void);
+unsigned int hashPolinomialPuro(const char *chave, size_t tamanho);
+unsigned int hashPolinomial(const char *chave, size_t tamanho);
+unsigned long long misturar64(unsigned long long a, unsigned long long b);
+unsigned long long hashTexto64(const char *chave, size_t tamanho, unsigned long long base);
+unsigned int hashMultiplicativo(const char *chave, size_t tamanho);
+unsigned int hashTexto(const char *chave, size_t tamanho);
+unsigned int hashDe(HandleTexto handle);
+void* realocarOuSair(void *ptr, size_t tamanho);
+void reconstruirIndicePool(unsigned int novaCap);
+void tornarPoolProprio(void);
+
+#endif
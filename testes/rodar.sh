@@ -0,0 +1,37 @@
+#!/bin/sh
+# -------------------------------------------------------
+# Roda os testes do nível Mestre. Cada testes/teste_*.sh e
+# cada programa build/testes/teste_* (feito por 'make test')
+# roda dentro de uma pasta temporária ($TMP_TESTE), com o
+# binário em $MESTRE e a raiz do repositório em $RAIZ, e
+# termina com status diferente de 0 se falhar.
+# Uso: testes/rodar.sh [binario]  (padrão: ./mestre)
+# -------------------------------------------------------
+cd "$(dirname "$0")/.." || exit 1
+MESTRE=$(cd "$(dirname "${1:-./mestre}")" && pwd)/$(basename "${1:-./mestre}")
+RAIZ=$PWD
+export MESTRE RAIZ
+falhas=0
+total=0
+
+for teste in testes/teste_*.sh build/testes/teste_*; do
+    [ -f "$teste" ] || continue
+    TMP_TESTE=$(mktemp -d)
+    export TMP_TESTE
+    total=$((total + 1))
+    case "$teste" in
+        *.sh) comando="sh $RAIZ/$teste" ;;
+        *) comando="$RAIZ/$teste" ;;
+    esac
+    if (cd "$TMP_TESTE" && $comando) > "$TMP_TESTE/.log" 2>&1; then
+        echo "ok    $teste"
+    else
+        echo "FALHA $teste"
+        sed 's/^/      /' "$TMP_TESTE/.log"
+        falhas=$((falhas + 1))
+    fi
+    rm -rf "$TMP_TESTE"
+done
+
+echo "$((total - falhas)) de $total teste(s) passaram."
+[ "$falhas" -eq 0 ]
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Índice de caminhos numa mansão em texto cujos ids não
+# seguem a ordem em largura (um filho com id menor que o
+# pai): 0 -> e 3, 3 -> d 2, 2 -> e 1. O mesmo vale depois
+# de converter o arquivo para o formato binário.
+set -e
+cd "$TMP_TESTE"
+
+cat > mansao.txt <<'FIM'
+0|Hall|||3|-
+1|Porao|Chave enferrujada|Mordomo|-|-
+2|Cozinha|Faca sumida|Mordomo|1|-
+3|Biblioteca|Livro rasgado|Jardineiro|-|2
+FIM
+
+cat > esperado_pista.txt <<'FIM'
+Pista encontrada em Porao (profundidade 3):
+  Porao: e d e
+FIM
+
+cat > esperado_suspeito.txt <<'FIM'
+2 sala(s) com pistas contra Mordomo:
+  Cozinha: e d
+  Porao: e d e
+Todas ficam a partir de Cozinha:
+  Cozinha: e d
+FIM
+
+"$MESTRE" --converter mansao.txt mansao.bin > /dev/null
+for arquivo in mansao.txt mansao.bin; do
+    "$MESTRE" --mansao "$arquivo" --caminho "Chave enferrujada" > pista.txt
+    diff -u esperado_pista.txt pista.txt
+    "$MESTRE" --mansao "$arquivo" --caminho Mordomo > suspeito.txt
+    diff -u esperado_suspeito.txt suspeito.txt
+done
@@ -0,0 +1,199 @@
+// -------------------------------------------------------
+// Consultas por intervalo e por prefixo da árvore B+ de
+// pistas contra uma varredura do vetor ordenado. As pistas
+// saem de um alfabeto pequeno, então muitas dividem os 8
+// primeiros bytes (o prefixo inteiro das chaves) e várias
+// acabam antes deles. Os limites são as próprias pistas,
+// pistas com o último byte trocado (caem entre duas chaves),
+// pedaços de pistas, "" e textos sorteados; o intervalo vai
+// também com fim NULL e com fim <= início (vazio). Uma
+// árvore é montada pista a pista e a outra num lote.
+// -------------------------------------------------------
+#include "../src/pistas.h"
+
+#define NUM_PISTAS_TESTE  6000
+#define NUM_LIMITES_TESTE 400
+
+int falhas = 0;
+
+// Gerador simples e reproduzível (xorshift)
+unsigned int proximoNumero(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+int compararTextos(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+// Texto sorteado: "Pegadas " seguido de até 8 bytes de um
+// alfabeto com espaço e um byte acima de 127, ou um pedaço
+// de até 10 bytes do começo disso
+void sortearTexto(unsigned int *estado, char *texto) {
+    static const char alfabeto[] = "ab \xc3z";
+    int tamanho;
+
+    memcpy(texto, "Pegadas ", 8);
+    if (proximoNumero(estado) % 4 == 0) {
+        tamanho = 1 + (int)(proximoNumero(estado) % 10);
+    } else {
+        tamanho = 8 + (int)(proximoNumero(estado) % 9);
+    }
+    for (int i = (tamanho < 8) ? tamanho : 8; i < tamanho; i++) {
+        texto[i] = alfabeto[proximoNumero(estado) % (sizeof(alfabeto) - 1)];
+    }
+    texto[tamanho] = '\0';
+}
+
+// Confere o que o cursor devolve contra ordenadas[ini, fim)
+void conferirCursor(CursorPistas *cursor, const char **ordenadas, int ini, int fim, const char *arvore,
+                    const char *consulta) {
+    HandleTexto pista;
+    int k = ini;
+
+    while ((pista = proximaPista(cursor)) != TEXTO_INEXISTENTE) {
+        if (k >= fim || strcmp(textoDe(pista), ordenadas[k]) != 0) {
+            printf("FALHA: %s, %s: pista %d errada (\"%s\").\n", arvore, consulta, k - ini, textoDe(pista));
+            falhas++;
+            return;
+        }
+        k++;
+    }
+    if (k != fim) {
+        printf("FALHA: %s, %s: %d pista(s) em vez de %d.\n", arvore, consulta, k - ini, fim - ini);
+        falhas++;
+    }
+    if (proximaPista(cursor) != TEXTO_INEXISTENTE) {
+        printf("FALHA: %s, %s: o cursor continuou depois do fim.\n", arvore, consulta);
+        falhas++;
+    }
+}
+
+// Primeira posição de 'ordenadas' com texto >= 'texto'
+int primeiraAPartirDe(const char **ordenadas, int n, const char *texto) {
+    int ini = 0, fim = n;
+    while (ini < fim) {
+        int meio = (ini + fim) / 2;
+        if (strcmp(ordenadas[meio], texto) < 0) ini = meio + 1; else fim = meio;
+    }
+    return ini;
+}
+
+int main(void) {
+    static char textos[NUM_PISTAS_TESTE][TAM_PISTA];
+    static char limites[NUM_LIMITES_TESTE][TAM_PISTA];
+    HandleTexto *handles = (HandleTexto *)realocarOuSair(NULL, NUM_PISTAS_TESTE * sizeof(HandleTexto));
+    const char **ordenadas = (const char **)realocarOuSair(NULL, NUM_PISTAS_TESTE * sizeof(char *));
+    unsigned int estado = 16;
+    Arena arena;
+    ArvorePistas umaAUma, emLote;
+    const ArvorePistas *arvores[2] = { &umaAUma, &emLote };
+    static const char *nomesArvores[2] = { "uma a uma", "em lote" };
+    int n = 0;
+
+    inicializarArena(&arena);
+    inicializarPistas(&umaAUma, &arena);
+    inicializarPistas(&emLote, &arena);
+    for (int i = 0; i < NUM_PISTAS_TESTE; i++) {
+        sortearTexto(&estado, textos[i]);
+        handles[i] = internarTexto(textos[i], TAM_PISTA);
+        inserirPista(&umaAUma, handles[i]);
+    }
+    inserirPistasEmLote(&emLote, handles, NUM_PISTAS_TESTE);
+
+    // Vetor ordenado sem repetidas
+    for (int i = 0; i < NUM_PISTAS_TESTE; i++) {
+        ordenadas[i] = textos[i];
+    }
+    qsort(ordenadas, NUM_PISTAS_TESTE, sizeof(char *), compararTextos);
+    for (int i = 0; i < NUM_PISTAS_TESTE; i++) {
+        if (n == 0 || strcmp(ordenadas[n - 1], ordenadas[i]) != 0) {
+            ordenadas[n++] = ordenadas[i];
+        }
+    }
+    if (umaAUma.quantidade != n || emLote.quantidade != n) {
+        printf("FALHA: as arvores tem %d e %d pistas em vez de %d.\n", umaAUma.quantidade,
+               emLote.quantidade, n);
+        falhas++;
+    }
+
+    // Limites: "", pistas, pistas com o último byte trocado,
+    // pedaços de pistas e textos sorteados
+    strcpy(limites[0], "");
+    for (int l = 1; l < NUM_LIMITES_TESTE; l++) {
+        const char *base = ordenadas[proximoNumero(&estado) % (unsigned int)n];
+        size_t tamanho = strlen(base);
+        strcpy(limites[l], base);
+        switch (l % 5) {
+        case 1:
+            limites[l][tamanho - 1]++;
+            break;
+        case 2:
+            limites[l][tamanho - 1]--;
+            break;
+        case 3:
+            limites[l][proximoNumero(&estado) % tamanho] = '\0';
+            break;
+        case 4:
+            sortearTexto(&estado, limites[l]);
+            break;
+        }
+    }
+
+    for (int a = 0; a < 2; a++) {
+        CursorPistas cursor;
+        char consulta[3 * TAM_PISTA];
+
+        for (int l = 0; l < NUM_LIMITES_TESTE; l++) {
+            const char *inicio = limites[l];
+            const char *fim = (l % 7 == 0) ? NULL : limites[proximoNumero(&estado) % NUM_LIMITES_TESTE];
+            int ini = primeiraAPartirDe(ordenadas, n, inicio);
+            int depois = (fim == NULL) ? n : primeiraAPartirDe(ordenadas, n, fim);
+
+            snprintf(consulta, sizeof(consulta), "intervalo [\"%.60s\", \"%.60s\")", inicio,
+                     fim ? fim : "NULL");
+            posicionarIntervalo(arvores[a], inicio, fim, &cursor);
+            conferirCursor(&cursor, ordenadas, ini, (depois > ini) ? depois : ini, nomesArvores[a], consulta);
+
+            // Prefixo: as pistas que começam com o limite
+            size_t tamanho = strlen(inicio);
+            depois = ini;
+            while (depois < n && strncmp(ordenadas[depois], inicio, tamanho) == 0) depois++;
+            snprintf(consulta, sizeof(consulta), "prefixo \"%.60s\"", inicio);
+            posicionarPrefixo(arvores[a], inicio, &cursor);
+            conferirCursor(&cursor, ordenadas, ini, depois, nomesArvores[a], consulta);
+        }
+
+        // Intervalos vazios: fim igual ao início e antes dele
+        snprintf(consulta, sizeof(consulta), "intervalo vazio [\"%.60s\", \"%.60s\")", ordenadas[n / 2],
+                 ordenadas[n / 2]);
+        posicionarIntervalo(arvores[a], ordenadas[n / 2], ordenadas[n / 2], &cursor);
+        conferirCursor(&cursor, ordenadas, n / 2, n / 2, nomesArvores[a], consulta);
+        snprintf(consulta, sizeof(consulta), "intervalo invertido [\"%.60s\", \"%.60s\")", ordenadas[n / 2],
+                 ordenadas[1]);
+        posicionarIntervalo(arvores[a], ordenadas[n / 2], ordenadas[1], &cursor);
+        conferirCursor(&cursor, ordenadas, n / 2, n / 2, nomesArvores[a], consulta);
+    }
+
+    // Árvore vazia
+    ArvorePistas vazia;
+    CursorPistas cursor;
+    inicializarPistas(&vazia, &arena);
+    posicionarIntervalo(&vazia, "", NULL, &cursor);
+    conferirCursor(&cursor, ordenadas, 0, 0, "vazia", "intervalo [\"\", NULL)");
+    posicionarPrefixo(&vazia, "Peg", &cursor);
+    conferirCursor(&cursor, ordenadas, 0, 0, "vazia", "prefixo \"Peg\"");
+
+    printf("%d pistas distintas, %d limites.\n", n, NUM_LIMITES_TESTE);
+    free(handles);
+    free(ordenadas);
+    liberarArena(&arena);
+    liberarPoolTextos();
+
+    printf("%d falha(s).\n", falhas);
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+// -------------------------------------------------------
+// Injeção de falhas no diário da sessão: grava um diário
+// sem compactar (como se o processo tivesse caído), corta
+// o arquivo em deslocamentos aleatórios e em cada fronteira
+// de registro, e confere que a retomada recupera exatamente
+// os registros inteiros antes do corte e continua gravando
+// normalmente depois.
+// -------------------------------------------------------
+#include "../src/sessao.h"
+#include "../src/arquivos.h"
+
+#define BASE_TESTE       "sessao_teste"
+#define NUM_REGISTROS    40
+#define NUM_CORTES       300
+
+char nomesPistas[NUM_REGISTROS][TAM_PISTA];
+char nomesSuspeitos[NUM_REGISTROS][TAM_SUSPEITO];
+
+int falhas = 0;
+
+void conferir(int condicao, const char *mensagem, long corte) {
+    if (!condicao) {
+        printf("FALHA (corte em %ld): %s\n", corte, mensagem);
+        falhas++;
+    }
+}
+
+// Estado de uma investigação: arena, árvore e hash
+typedef struct Investigacao {
+    Arena arena;
+    ArvorePistas pistas;
+    TabelaHash tabela;
+} Investigacao;
+
+void iniciarInvestigacao(Investigacao *inv) {
+    inicializarArena(&inv->arena);
+    inicializarPistas(&inv->pistas, &inv->arena);
+    inicializarHash(&inv->tabela);
+}
+
+void encerrarInvestigacao(Investigacao *inv) {
+    liberarHash(&inv->tabela);
+    liberarArena(&inv->arena);
+}
+
+// Coleta uma pista como explorarSalas faz
+void coletar(Investigacao *inv, SessaoPersistente *sessao, const char *pista, const char *suspeito) {
+    HandleTexto hPista = internarTexto(pista, TAM_PISTA);
+    HandleTexto hSuspeito = internarTexto(suspeito, TAM_SUSPEITO);
+
+    if (inserirPista(&inv->pistas, hPista)) {
+        if (hSuspeito != TEXTO_VAZIO) {
+            inserirNaHashPorHandle(&inv->tabela, hPista, hSuspeito);
+        }
+        registrarPistaSessao(sessao, hPista, hSuspeito, &inv->pistas, &inv->tabela);
+    }
+}
+
+// As 'k' primeiras pistas estão lá, com o suspeito certo,
+// e além delas só 'extras' outras?
+int confere(Investigacao *inv, int k, int extras) {
+    if ((int)inv->pistas.quantidade != k + extras) return 0;
+    for (int i = 0; i < k; i++) {
+        if (buscarPista(&inv->pistas, nomesPistas[i]) == TEXTO_INEXISTENTE) return 0;
+        const char *suspeito = encontrarSuspeito(&inv->tabela, nomesPistas[i]);
+        if (nomesSuspeitos[i][0] == '\0' ? suspeito != NULL
+                                         : (suspeito == NULL || strcmp(suspeito, nomesSuspeitos[i]) != 0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void gravarArquivo(const char *caminho, const char *dados, size_t tamanho) {
+    FILE *arquivo = fopen(caminho, "wb");
+    if (arquivo == NULL || fwrite(dados, 1, tamanho, arquivo) != tamanho || fclose(arquivo) != 0) {
+        printf("Nao foi possivel gravar '%s'.\n", caminho);
+        exit(1);
+    }
+}
+
+int main(void) {
+    SessaoPersistente sessao;
+    Investigacao inv;
+    size_t fimRegistro[NUM_REGISTROS];
+    size_t pos = 8;
+
+    for (int i = 0; i < NUM_REGISTROS; i++) {
+        snprintf(nomesPistas[i], TAM_PISTA, "Pista numero %d%s", i, (i % 3 == 0) ? " com texto maior" : "");
+        if (i % 7 == 0) {
+            nomesSuspeitos[i][0] = '\0'; // pista sem suspeito
+        } else {
+            snprintf(nomesSuspeitos[i], TAM_SUSPEITO, "Suspeito %d", i % 5);
+        }
+        pos += sizeof(RegistroDiario) + strlen(nomesPistas[i]) + strlen(nomesSuspeitos[i]);
+        fimRegistro[i] = pos;
+    }
+
+    // Diário original: NUM_REGISTROS registros, sem retrato
+    remove(BASE_TESTE ".diario");
+    remove(BASE_TESTE ".retrato");
+    iniciarInvestigacao(&inv);
+    if (!abrirSessao(&sessao, BASE_TESTE, &inv.pistas, &inv.tabela)) return 1;
+    for (int i = 0; i < NUM_REGISTROS; i++) {
+        coletar(&inv, &sessao, nomesPistas[i], nomesSuspeitos[i]);
+    }
+    fclose(sessao.diario); // queda: sem fecharSessao, nada é compactado
+    free(sessao.caminhoDiario);
+    free(sessao.caminhoRetrato);
+    encerrarInvestigacao(&inv);
+
+    size_t tamanho;
+    char *mapa = (char *)mapearArquivo(BASE_TESTE ".diario", &tamanho);
+    if (mapa == NULL || tamanho != fimRegistro[NUM_REGISTROS - 1]) {
+        printf("Diario com %zu bytes, esperado %zu.\n", mapa ? tamanho : 0, fimRegistro[NUM_REGISTROS - 1]);
+        return 1;
+    }
+    char *original = (char *)realocarOuSair(NULL, tamanho);
+    memcpy(original, mapa, tamanho);
+    desmapearArquivo(mapa, tamanho);
+
+    // Cortes: cada fronteira (e vizinhos) e deslocamentos aleatórios
+    srand(18);
+    for (int c = 0; c < NUM_CORTES; c++) {
+        size_t corte;
+        if (c < NUM_REGISTROS) {
+            corte = fimRegistro[c] - (size_t)(c % 3); // na fronteira ou 1-2 bytes antes
+        } else if (c < NUM_REGISTROS + 9) {
+            corte = (size_t)(c - NUM_REGISTROS); // assinatura incompleta
+        } else {
+            corte = (size_t)rand() % (tamanho + 1);
+        }
+
+        int esperados = 0;
+        while (esperados < NUM_REGISTROS && fimRegistro[esperados] <= corte) esperados++;
+
+        gravarArquivo(BASE_TESTE ".diario", original, corte);
+        remove(BASE_TESTE ".retrato");
+
+        iniciarInvestigacao(&inv);
+        conferir(abrirSessao(&sessao, BASE_TESTE, &inv.pistas, &inv.tabela), "abrirSessao falhou", (long)corte);
+        conferir(confere(&inv, esperados, 0), "pistas recuperadas diferentes do prefixo", (long)corte);
+
+        // A sessão segue: uma pista nova e o fechamento normal
+        coletar(&inv, &sessao, "Pista depois da queda", "Suspeito novo");
+        fecharSessao(&sessao, &inv.pistas, &inv.tabela);
+        encerrarInvestigacao(&inv);
+
+        iniciarInvestigacao(&inv);
+        conferir(abrirSessao(&sessao, BASE_TESTE, &inv.pistas, &inv.tabela), "retomada falhou", (long)corte);
+        conferir(confere(&inv, esperados, 1) &&
+                 buscarPista(&inv.pistas, "Pista depois da queda") != TEXTO_INEXISTENTE,
+                 "retomada depois da queda perdeu pistas", (long)corte);
+        fecharSessao(&sessao, &inv.pistas, &inv.tabela);
+        encerrarInvestigacao(&inv);
+    }
+
+    remove(BASE_TESTE ".diario");
+    remove(BASE_TESTE ".retrato");
+    free(original);
+    liberarPoolTextos();
+
+    printf("%d corte(s) do diario, %d falha(s).\n", NUM_CORTES, falhas);
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// -------------------------------------------------------
+// As três comparações de grupo da hash (escalar, SSE2 e
+// AVX2) têm de dar o mesmo resultado. Primeiro byte a byte:
+// grupos aleatórios de bytes de controle, com e sem slots
+// vazios, em todos os alinhamentos. Depois na tabela: cada
+// variante é forçada em compararGrupo/larguraGrupo, monta
+// tabelas de vários tamanhos (com crescimento e migração no
+// meio) e responde às mesmas buscas, presentes e ausentes.
+// As variantes que a CPU não tem são puladas e avisadas.
+// -------------------------------------------------------
+#include "../src/hash.h"
+
+typedef struct VarianteGrupo {
+    const char *nome;
+    unsigned int (*funcao)(const unsigned char *, unsigned char, unsigned int *);
+    unsigned int largura;
+    int disponivel;
+} VarianteGrupo;
+
+int falhas = 0;
+
+void listarVariantes(VarianteGrupo *variantes, int *quantas) {
+    int n = 0;
+
+    variantes[n++] = (VarianteGrupo){ "escalar", compararGrupoEscalar, 16, 1 };
+#ifdef HASH_SIMD_X86
+    __builtin_cpu_init();
+    variantes[n++] = (VarianteGrupo){ "SSE2", compararGrupoSSE2, 16, __builtin_cpu_supports("sse2") };
+    variantes[n++] = (VarianteGrupo){ "AVX2", compararGrupoAVX2, 32, __builtin_cpu_supports("avx2") };
+#endif
+    *quantas = n;
+}
+
+// Gerador simples e reproduzível (xorshift)
+unsigned int proximoNumero(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Cada variante, em blocos de 16, contra a escalar
+void compararBytes(const VarianteGrupo *variantes, int quantas) {
+    unsigned char ctrl[GRUPO_MAX * 4];
+    unsigned int estado = 3;
+
+    for (int rodada = 0; rodada < 20000; rodada++) {
+        int vaziosPorCem = (rodada % 5) * 25; // de nenhum a 100% de vazios
+        for (unsigned int i = 0; i < sizeof(ctrl); i++) {
+            ctrl[i] = ((int)(proximoNumero(&estado) % 100) < vaziosPorCem)
+                          ? CTRL_VAZIO : (unsigned char)(proximoNumero(&estado) & 0x7F);
+        }
+        unsigned int inicio = proximoNumero(&estado) % (sizeof(ctrl) - GRUPO_MAX);
+        unsigned char alvo = (rodada % 2) ? ctrl[inicio + proximoNumero(&estado) % GRUPO_MAX]
+                                          : (unsigned char)(proximoNumero(&estado) & 0x7F);
+        if (alvo == CTRL_VAZIO) alvo = 0;
+
+        for (int v = 1; v < quantas; v++) {
+            if (!variantes[v].disponivel) continue;
+            unsigned int vazios, vaziosEsperados;
+            unsigned int iguais = variantes[v].funcao(&ctrl[inicio], alvo, &vazios);
+            for (unsigned int bloco = 0; bloco < variantes[v].largura; bloco += 16) {
+                unsigned int esperados = compararGrupoEscalar(&ctrl[inicio + bloco], alvo, &vaziosEsperados);
+                if (((iguais >> bloco) & 0xFFFFu) != esperados ||
+                    ((vazios >> bloco) & 0xFFFFu) != vaziosEsperados) {
+                    printf("FALHA: %s difere da escalar (rodada %d, bytes %u..%u).\n",
+                           variantes[v].nome, rodada, inicio + bloco, inicio + bloco + 15);
+                    falhas++;
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Monta uma tabela com 'n' pistas usando a variante e grava
+// em 'respostas' o suspeito de cada uma das 2n buscas
+void buscarComVariante(const VarianteGrupo *variante, const HandleTexto *pistas,
+                       const HandleTexto *suspeitos, unsigned int n, HandleTexto *respostas) {
+    TabelaHash tabela;
+
+    compararGrupo = variante->funcao;
+    larguraGrupo = variante->largura;
+    inicializarHash(&tabela);
+    for (unsigned int i = 0; i < n; i++) {
+        inserirNaHashPorHandle(&tabela, pistas[i], suspeitos[i]);
+        if (i % 97 == 0) {
+            // Busca no meio das inserções (pode haver migração em curso)
+            respostas[2 * n + i / 97] = encontrarSuspeitoPorHandle(&tabela, pistas[i / 2]);
+        }
+    }
+    for (unsigned int i = 0; i < 2 * n; i++) {
+        respostas[i] = encontrarSuspeitoPorHandle(&tabela, pistas[i]);
+    }
+    liberarHash(&tabela);
+}
+
+void compararTabelas(const VarianteGrupo *variantes, int quantas) {
+    static const unsigned int tamanhos[] = { 1, 5, 40, 57, 200, 3000, 20000 };
+    char texto[TAM_PISTA];
+
+    for (unsigned int t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]); t++) {
+        unsigned int n = tamanhos[t];
+        unsigned int extras = n / 97 + 1;
+        HandleTexto *pistas = (HandleTexto *)realocarOuSair(NULL, 2 * (size_t)n * sizeof(HandleTexto));
+        HandleTexto *suspeitos = (HandleTexto *)realocarOuSair(NULL, (size_t)n * sizeof(HandleTexto));
+        HandleTexto *esperadas = (HandleTexto *)realocarOuSair(NULL, (2 * (size_t)n + extras) * sizeof(HandleTexto));
+        HandleTexto *respostas = (HandleTexto *)realocarOuSair(NULL, (2 * (size_t)n + extras) * sizeof(HandleTexto));
+
+        // n pistas inseridas e n que nunca entram na tabela
+        for (unsigned int i = 0; i < 2 * n; i++) {
+            snprintf(texto, sizeof(texto), "%s %u de %u", (i < n) ? "Pista" : "Ausente", i, n);
+            pistas[i] = internarTexto(texto, TAM_PISTA);
+        }
+        for (unsigned int i = 0; i < n; i++) {
+            snprintf(texto, sizeof(texto), "Suspeito %u", i % 37);
+            suspeitos[i] = internarTexto(texto, TAM_SUSPEITO);
+        }
+
+        buscarComVariante(&variantes[0], pistas, suspeitos, n, esperadas);
+        for (unsigned int i = 0; i < 2 * n; i++) {
+            HandleTexto certo = (i < n) ? suspeitos[i] : TEXTO_INEXISTENTE;
+            if (esperadas[i] != certo) {
+                printf("FALHA: escalar errou a busca %u de %u pistas.\n", i, n);
+                falhas++;
+                break;
+            }
+        }
+        for (int v = 1; v < quantas; v++) {
+            if (!variantes[v].disponivel) continue;
+            buscarComVariante(&variantes[v], pistas, suspeitos, n, respostas);
+            if (memcmp(respostas, esperadas, (2 * (size_t)n + extras) * sizeof(HandleTexto)) != 0) {
+                printf("FALHA: %s difere da escalar numa tabela de %u pistas.\n", variantes[v].nome, n);
+                falhas++;
+            }
+        }
+        free(pistas);
+        free(suspeitos);
+        free(esperadas);
+        free(respostas);
+    }
+}
+
+int main(void) {
+    VarianteGrupo variantes[3];
+    int quantas;
+
+    listarVariantes(variantes, &quantas);
+    for (int v = 0; v < quantas; v++) {
+        printf("%-8s %s\n", variantes[v].nome, variantes[v].disponivel ? "testada" : "indisponivel nesta CPU");
+    }
+    compararBytes(variantes, quantas);
+    compararTabelas(variantes, quantas);
+    liberarPoolTextos();
+
+    printf("%d falha(s).\n", falhas);
+    return falhas == 0 ? 0 : 1;
+}
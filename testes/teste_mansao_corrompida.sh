@@ -0,0 +1,76 @@
+#!/bin/sh
+# Arquivos binários de mansão corrompidos têm de ser
+# recusados ao carregar: truncados, com filho fora das
+# salas, com handle de texto inexistente, com texto do pool
+# fora do bloco de textos e com índice do pool apontando
+# para um texto inexistente. Os números são gravados em
+# little-endian, a ordem de bytes da máquina dos testes.
+set -e
+
+cat > pequena.txt <<'FIM'
+0|Hall|||1|2
+1|Cozinha|Faca sumida|Mordomo|-|-
+2|Jardim|Pegadas na lama|Jardineiro|-|-
+FIM
+"$MESTRE" --converter pequena.txt pequena.bin > /dev/null
+
+# Campo de 64 bits do cabeçalho no deslocamento $1
+campo64() {
+    od -An -t u8 -j "$1" -N 8 pequena.bin | tr -d ' '
+}
+
+# Cópia de pequena.bin em $1 com o inteiro de 32 bits $3
+# gravado no deslocamento $2
+corromper() {
+    cp pequena.bin "$1"
+    printf "$(printf '\\%03o\\%03o\\%03o\\%03o' $(($3 & 255)) $((($3 >> 8) & 255)) \
+        $((($3 >> 16) & 255)) $((($3 >> 24) & 255)))" |
+        dd of="$1" bs=1 seek="$2" conv=notrunc 2> /dev/null
+}
+
+# O arquivo $1 tem de ser recusado, sem travar nem cair
+recusado() {
+    if "$MESTRE" --converter "$1" volta.txt > saida.txt 2>&1; then
+        echo "$1 foi aceito"
+        exit 1
+    fi
+    grep -q "nao e um arquivo de mansao valido" saida.txt || {
+        echo "$1 nao foi recusado como mansao invalida:"
+        cat saida.txt
+        exit 1
+    }
+}
+
+DES_SALAS=$(campo64 32)
+DES_ENTRADAS=$(campo64 40)
+DES_INDICE=$(campo64 48)
+TAMANHO=$(wc -c < pequena.bin)
+
+# O original continua valendo
+"$MESTRE" --converter pequena.bin volta.txt > /dev/null
+
+# Truncados: no meio dos textos e no meio do cabeçalho
+head -c $((TAMANHO - 8)) pequena.bin > truncado.bin
+recusado truncado.bin
+head -c 40 pequena.bin > cabecalho.bin
+recusado cabecalho.bin
+
+# SalaCompacta: nome, pista, suspeito, esq, dir (20 bytes)
+corromper filho.bin $((DES_SALAS + 12)) 3
+recusado filho.bin
+corromper filho_grande.bin $((DES_SALAS + 16)) 2147483647
+recusado filho_grande.bin
+corromper ciclo.bin $((DES_SALAS + 20 + 12)) 1
+recusado ciclo.bin
+corromper handle.bin $((DES_SALAS + 20 + 4)) 100000
+recusado handle.bin
+
+# EntradaPool: deslocamento, tamanho, hash (12 bytes)
+corromper texto.bin $((DES_ENTRADAS + 12)) 1000000
+recusado texto.bin
+corromper tamanho.bin $((DES_ENTRADAS + 12 + 4)) 1000
+recusado tamanho.bin
+
+# Índice do pool: o primeiro slot passa a apontar para fora
+corromper indice.bin "$DES_INDICE" 100000
+recusado indice.bin
@@ -0,0 +1,95 @@
+// -------------------------------------------------------
+// A mansão padrão sai da imagem embutida (mansao_padrao.h)
+// sem nenhuma alocação e sem calcular nenhum hash. O teste
+// é ligado com --wrap (ver Makefile): malloc, calloc,
+// realloc, hashTexto, hashFunc e internarTexto passam por
+// contadores antes de chamar as originais. Como controle, a
+// montagem em tempo de execução (construirMansaoPadrao)
+// precisa aparecer nos mesmos contadores.
+// -------------------------------------------------------
+#include "../src/padrao.h"
+
+unsigned long alocacoes = 0;
+unsigned long hashes = 0;
+
+void* __real_malloc(size_t tamanho);
+void* __real_calloc(size_t n, size_t tamanho);
+void* __real_realloc(void *ptr, size_t tamanho);
+unsigned int __real_hashTexto(const char *chave, size_t tamanho);
+unsigned int __real_hashFunc(const char *chave);
+HandleTexto __real_internarTexto(const char *texto, size_t tamMax);
+
+void* __wrap_malloc(size_t tamanho) {
+    alocacoes++;
+    return __real_malloc(tamanho);
+}
+
+void* __wrap_calloc(size_t n, size_t tamanho) {
+    alocacoes++;
+    return __real_calloc(n, tamanho);
+}
+
+void* __wrap_realloc(void *ptr, size_t tamanho) {
+    alocacoes++;
+    return __real_realloc(ptr, tamanho);
+}
+
+unsigned int __wrap_hashTexto(const char *chave, size_t tamanho) {
+    hashes++;
+    return __real_hashTexto(chave, tamanho);
+}
+
+unsigned int __wrap_hashFunc(const char *chave) {
+    hashes++;
+    return __real_hashFunc(chave);
+}
+
+// Internar um texto novo sempre calcula o hash dele
+HandleTexto __wrap_internarTexto(const char *texto, size_t tamMax) {
+    hashes++;
+    return __real_internarTexto(texto, tamMax);
+}
+
+int main(void) {
+    Arena arena;
+    Mansao mansao;
+    int falhas = 0;
+
+    // Início do jogo: arena vazia e mansão padrão
+    inicializarArena(&arena);
+    montarMansaoPadrao(&arena, &mansao);
+    unsigned long alocacoesInicio = alocacoes;
+    unsigned long hashesInicio = hashes;
+    unsigned int salas = mansao.quantidade;
+
+    printf("Mansao embutida: %u sala(s), %lu alocacao(oes), %lu hash(es), %lu bloco(s) de arena.\n",
+           salas, alocacoesInicio, hashesInicio, arena.blocos);
+    if (alocacoesInicio != 0 || hashesInicio != 0 || arena.blocos != 0) {
+        printf("FALHA: a mansao embutida deveria sair sem alocar nem calcular hashes.\n");
+        falhas++;
+    }
+    if (salas == 0 || buscarTexto("Mordomo") == TEXTO_INEXISTENTE) {
+        printf("FALHA: mansao embutida vazia ou sem os textos do caso.\n");
+        falhas++;
+    }
+    liberarPoolTextos();
+    liberarMansao(&mansao);
+    liberarArena(&arena);
+
+    // Controle: a montagem em tempo de execução aparece nos contadores
+    alocacoes = 0;
+    hashes = 0;
+    inicializarArena(&arena);
+    construirMansaoPadrao(&arena, &mansao);
+    printf("Mansao montada: %u sala(s), %lu alocacao(oes), %lu hash(es).\n",
+           mansao.quantidade, alocacoes, hashes);
+    if (mansao.quantidade != salas || alocacoes == 0 || hashes == 0) {
+        printf("FALHA: os contadores nao viram a montagem em tempo de execucao.\n");
+        falhas++;
+    }
+    liberarPoolTextos();
+    liberarMansao(&mansao);
+    liberarArena(&arena);
+
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+#!/bin/sh
+# Ida e volta texto -> binário -> texto da mansão. A volta
+# tem de dar o arquivo canônico: cabeçalho e salas em ordem
+# de id, com os mesmos ids, filhos e textos. Cobre a mansão padrão, uma mansão pequena com ids fora da
+# ordem em largura e uma gerada com 2000 salas numeradas ao
+# acaso; o jogo nas duas formas tem de sair igual.
+set -e
+
+# 1. Mansão padrão: exportar, converter e voltar
+"$MESTRE" --exportar padrao.txt > /dev/null
+"$MESTRE" --converter padrao.txt padrao.bin > /dev/null
+"$MESTRE" --converter padrao.bin padrao_volta.txt > /dev/null
+diff -u padrao.txt padrao_volta.txt
+
+# 2. Ids fora da ordem em largura, campos vazios e linhas
+# fora de ordem, com comentário e linha em branco
+cat > pequena.txt <<'FIM'
+# filho com id menor que o pai: 0 -> e 3, 3 -> d 2, 2 -> e 1
+2|Cozinha|Faca sumida|Mordomo|1|-
+
+3|Biblioteca|Livro rasgado||-|2
+0|Hall|||3|4
+1|Porao|Chave enferrujada|Mordomo|-|-
+4|Jardim||Jardineiro|-|-
+FIM
+cat > pequena_canonica.txt <<'FIM'
+# id|nome|pista|suspeito|esq|dir
+0|Hall|||3|4
+1|Porao|Chave enferrujada|Mordomo|-|-
+2|Cozinha|Faca sumida|Mordomo|1|-
+3|Biblioteca|Livro rasgado||-|2
+4|Jardim||Jardineiro|-|-
+FIM
+"$MESTRE" --converter pequena.txt pequena.bin > /dev/null
+"$MESTRE" --converter pequena.bin pequena_volta.txt > /dev/null
+diff -u pequena_canonica.txt pequena_volta.txt
+
+# 3. Árvore aleatória de 2000 salas; a raiz fica com id 0 e
+# as demais recebem uma permutação qualquer de 1..1999
+awk -v n=2000 'BEGIN {
+    srand(8);
+    for (i = 1; i < n; i++) perm[i] = i;
+    for (i = n - 1; i > 1; i--) { j = 1 + int(rand() * i); t = perm[i]; perm[i] = perm[j]; perm[j] = t; }
+    perm[0] = 0;
+    for (k = 0; k < n; k++) { esq[k] = "-"; dir[k] = "-"; }
+    for (k = 1; k < n; k++) {
+        do { p = int(rand() * k); lado = int(rand() * 2); }
+        while ((lado == 0 && esq[p] != "-") || (lado == 1 && dir[p] != "-"));
+        if (lado == 0) esq[p] = perm[k]; else dir[p] = perm[k];
+    }
+    print "# id|nome|pista|suspeito|esq|dir" > "grande_canonica.txt";
+    for (k = 0; k < n; k++) {
+        pista = (k % 3 == 0) ? "" : "Pista " k " da sala";
+        suspeito = (k % 4 == 0) ? "" : "Suspeito " (k % 17);
+        linha[perm[k]] = perm[k] "|Sala " k "|" pista "|" suspeito "|" esq[k] "|" dir[k];
+        printf "%.6f\t%s\n", rand(), linha[perm[k]] > "grande_embaralhada.tmp";
+    }
+    for (id = 0; id < n; id++) print linha[id] > "grande_canonica.txt";
+}'
+sort -n grande_embaralhada.tmp | cut -f 2 > grande.txt
+"$MESTRE" --converter grande.txt grande.bin > /dev/null
+"$MESTRE" --converter grande.bin grande_volta.txt > /dev/null
+diff -u grande_canonica.txt grande_volta.txt > /dev/null || {
+    echo "volta da mansao grande difere do arquivo canonico"
+    diff -u grande_canonica.txt grande_volta.txt | head -20
+    exit 1
+}
+
+# O jogo lê as duas formas do mesmo jeito
+printf 'e\nd\ne\ne\nd\nd\ne\ns\nSuspeito 5\n' > jogada.txt
+for base in pequena grande; do
+    "$MESTRE" --mansao $base.txt < jogada.txt > jogo_texto.txt
+    "$MESTRE" --mansao $base.bin < jogada.txt > jogo_binario.txt
+    diff -u jogo_texto.txt jogo_binario.txt
+done
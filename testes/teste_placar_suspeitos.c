@@ -0,0 +1,105 @@
+// -------------------------------------------------------
+// Placar e índice invertido da hash contra uma contagem
+// feita à parte. Pistas sorteadas são associadas e depois
+// reassociadas a outros suspeitos (ou a nenhum) várias
+// vezes; depois de cada operação, a quantidade de pistas de
+// cada suspeito tem de bater com o vetor do índice e com a
+// contagem, e o topo do placar tem de ser o suspeito com
+// mais pistas (no empate, o de handle menor).
+// -------------------------------------------------------
+#include "../src/hash.h"
+
+#define NUM_PISTAS_TESTE     3000
+#define NUM_SUSPEITOS_TESTE  40
+#define NUM_OPERACOES_TESTE  20000
+
+int falhas = 0;
+
+// Gerador simples e reproduzível (xorshift)
+unsigned int proximoNumero(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+// Confere todos os suspeitos e o topo do placar
+void conferirPlacar(TabelaHash *tabela, const HandleTexto *suspeitos, const int *esperadas, int operacao) {
+    HandleTexto melhor = TEXTO_INEXISTENTE;
+    int maximo = 0;
+
+    for (int s = 0; s < NUM_SUSPEITOS_TESTE; s++) {
+        unsigned int noIndice;
+        pistasDoSuspeito(tabela, suspeitos[s], &noIndice);
+        int contagem = contagemDoSuspeito(tabela, suspeitos[s]);
+        if (contagem != esperadas[s] || (int)noIndice != esperadas[s]) {
+            printf("FALHA: operacao %d, %s: contagem %d, indice %u, esperado %d.\n", operacao,
+                   textoDe(suspeitos[s]), contagem, noIndice, esperadas[s]);
+            falhas++;
+        }
+        if (esperadas[s] > maximo || (esperadas[s] == maximo && maximo > 0 && suspeitos[s] < melhor)) {
+            maximo = esperadas[s];
+            melhor = suspeitos[s];
+        }
+    }
+
+    int noTopo;
+    HandleTexto topo = suspeitoMaisProvavel(&tabela->placar, &noTopo);
+    if (topo != melhor || noTopo != maximo) {
+        printf("FALHA: operacao %d: topo %s com %d pista(s), esperado %s com %d.\n", operacao,
+               (topo != TEXTO_INEXISTENTE) ? textoDe(topo) : "nenhum", noTopo,
+               (melhor != TEXTO_INEXISTENTE) ? textoDe(melhor) : "nenhum", maximo);
+        falhas++;
+    }
+}
+
+int main(void) {
+    HandleTexto pistas[NUM_PISTAS_TESTE];
+    HandleTexto suspeitos[NUM_SUSPEITOS_TESTE];
+    int donoDe[NUM_PISTAS_TESTE];          // índice do suspeito (-1 = nenhum ou fora da tabela)
+    int esperadas[NUM_SUSPEITOS_TESTE] = { 0 };
+    char texto[TAM_PISTA];
+    unsigned int estado = 12;
+    TabelaHash tabela;
+
+    // Suspeitos internados em ordem embaralhada, para que a
+    // ordem dos handles não siga a ordem de inserção
+    for (int s = 0; s < NUM_SUSPEITOS_TESTE; s++) {
+        snprintf(texto, sizeof(texto), "Suspeito %d", (s * 17) % NUM_SUSPEITOS_TESTE);
+        suspeitos[s] = internarTexto(texto, TAM_SUSPEITO);
+    }
+    for (int p = 0; p < NUM_PISTAS_TESTE; p++) {
+        snprintf(texto, sizeof(texto), "Pista %d", p);
+        pistas[p] = internarTexto(texto, TAM_PISTA);
+        donoDe[p] = -1;
+    }
+
+    inicializarHash(&tabela);
+    conferirPlacar(&tabela, suspeitos, esperadas, 0);
+    for (int op = 1; op <= NUM_OPERACOES_TESTE; op++) {
+        int p = (int)(proximoNumero(&estado) % NUM_PISTAS_TESTE);
+        // Poucos suspeitos recebem a maior parte das pistas,
+        // para o topo mudar de dono e haver empates
+        int s = (int)(proximoNumero(&estado) % NUM_SUSPEITOS_TESTE);
+        if (proximoNumero(&estado) % 2) s %= 4;
+        int nenhum = proximoNumero(&estado) % 10 == 0;
+
+        inserirNaHashPorHandle(&tabela, pistas[p], nenhum ? TEXTO_VAZIO : suspeitos[s]);
+        if (donoDe[p] >= 0) esperadas[donoDe[p]]--;
+        donoDe[p] = nenhum ? -1 : s;
+        if (donoDe[p] >= 0) esperadas[donoDe[p]]++;
+
+        if (op % 97 == 0 || op < 200) {
+            conferirPlacar(&tabela, suspeitos, esperadas, op);
+        }
+        if (falhas > 10) break;
+    }
+    conferirPlacar(&tabela, suspeitos, esperadas, NUM_OPERACOES_TESTE);
+
+    liberarHash(&tabela);
+    liberarPoolTextos();
+    printf("%d falha(s).\n", falhas);
+    return falhas == 0 ? 0 : 1;
+}
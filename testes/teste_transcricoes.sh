@@ -0,0 +1,18 @@
+#!/bin/sh
+# Transcrições douradas do jogo: para cada NOME.entrada em
+# testes/transcricoes, a saída de "mestre [opções] < entrada"
+# tem de ser idêntica a NOME.saida. NOME.opcoes, se existir,
+# traz as opções da linha de comando (ex.: --detalhes). Sem
+# opções, as saídas são as da versão original do jogo.
+falhas=0
+for entrada in "$RAIZ"/testes/transcricoes/*.entrada; do
+    nome=${entrada%.entrada}
+    opcoes=""
+    [ -f "$nome.opcoes" ] && opcoes=$(cat "$nome.opcoes")
+    "$MESTRE" $opcoes < "$entrada" > "$TMP_TESTE/saida.txt"
+    if ! diff -u "$nome.saida" "$TMP_TESTE/saida.txt"; then
+        echo "transcricao diferente: $nome"
+        falhas=1
+    fi
+done
+exit $falhas